@@ -76,4 +76,27 @@
 #include "SDL3pp_mixer.h"
 #include "SDL3pp_ttf.h"
 
+// Here we have extensions built on top of SDL
+#include "SDL3pp_capturePipeline.h"
+#include "SDL3pp_debugTextBatch.h"
+#include "SDL3pp_dirtyRegion.h"
+#include "SDL3pp_eventChannel.h"
+#include "SDL3pp_eventDispatcher.h"
+#include "SDL3pp_eventFilterChain.h"
+#include "SDL3pp_eventRecorder.h"
+#include "SDL3pp_frameAllocator.h"
+#include "SDL3pp_memoryTracker.h"
+#include "SDL3pp_motionCoalescer.h"
+#include "SDL3pp_parallelSurface.h"
+#include "SDL3pp_pixelConvert.h"
+#include "SDL3pp_pixelView.h"
+#include "SDL3pp_renderStats.h"
+#include "SDL3pp_shapeBatch.h"
+#include "SDL3pp_spatialIndex.h"
+#include "SDL3pp_spriteBatch.h"
+#include "SDL3pp_streamingTextureRing.h"
+#include "SDL3pp_stridedView.h"
+#include "SDL3pp_surfacePool.h"
+#include "SDL3pp_textureAtlas.h"
+
 #endif /* SDL3PP_H_ */
@@ -4302,6 +4302,41 @@ inline void PutAudioStreamDataNoCopy(AudioStreamRef stream,
                            Wrapper::Wrap(std::move(callback)));
 }
 
+/**
+ * Add external data to an audio stream without copying it.
+ *
+ * Same as PutAudioStreamDataNoCopy(AudioStreamRef, SourceBytes,
+ * AudioStreamDataCompleteCB), but the callback is kept in a preallocated slot,
+ * so no heap allocation is done on our side to track it.
+ *
+ * @param stream the stream the audio data is being added to.
+ * @param buf a pointer to the audio data to add.
+ * @param callback the callback function to call when the data is no longer
+ *                 needed by the stream.
+ * @throws Error on failure.
+ *
+ * @threadsafety It is safe to call this function from any thread, but if the
+ *               stream has a callback set, the caller might need to manage
+ *               extra locking.
+ *
+ * @since This function is available since SDL 3.4.0.
+ *
+ * @sa AudioStream.PutDataNoCopy
+ */
+template<size_t SIZE>
+inline void PutAudioStreamDataNoCopy(
+  AudioStreamRef stream,
+  SourceBytes buf,
+  InplaceFunction<void(const void* buf, int buflen), SIZE> callback)
+{
+  using Wrapper =
+    CallbackWrapper<InplaceFunction<void(const void* buf, int buflen), SIZE>>;
+  PutAudioStreamDataNoCopy(stream,
+                           std::move(buf),
+                           &Wrapper::CallOnce,
+                           Wrapper::Wrap(std::move(callback)));
+}
+
 inline void AudioStream::PutDataNoCopy(SourceBytes buf,
                                        AudioStreamDataCompleteCallback callback,
                                        void* userdata)
@@ -1,9 +1,14 @@
 #ifndef SDL3PP_CALLBACK_WRAPPER_H_
 #define SDL3PP_CALLBACK_WRAPPER_H_
 
+#include <atomic>
+#include <cstddef>
 #include <functional>
 #include <map>
 #include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <SDL3/SDL_assert.h>
 
 namespace SDL {
@@ -16,6 +21,182 @@ namespace SDL {
  * @{
  */
 
+/**
+ * Default inline storage size, in bytes, for InplaceFunction.
+ */
+constexpr size_t INPLACE_FUNCTION_DEFAULT_SIZE = 4 * sizeof(void*);
+
+template<class F, size_t SIZE = INPLACE_FUNCTION_DEFAULT_SIZE>
+class InplaceFunction;
+
+/**
+ * Move-only callable wrapper that never allocates.
+ *
+ * This works like a std::function, but the callable is always stored inside
+ * the object itself, in a buffer of `SIZE` bytes. Trying to store a callable
+ * that does not fit is a compile time error.
+ *
+ * Along with CallbackWrapper it allows to pass
+ * [result callbacks](#result-callback) to SDL without touching the heap.
+ *
+ * @tparam R the return type.
+ * @tparam Args the parameters types.
+ * @tparam SIZE the inline storage size, in bytes.
+ *
+ * @sa FunctionRef
+ */
+template<class R, class... Args, size_t SIZE>
+class InplaceFunction<R(Args...), SIZE>
+{
+  struct Operations
+  {
+    R (*invoke)(void* obj, Args... args);
+    void (*move)(void* dst, void* src);
+    void (*destroy)(void* obj);
+  };
+
+  template<class F>
+  static constexpr Operations operationsFor{
+    [](void* obj, Args... args) -> R {
+      return std::invoke_r<R>(*static_cast<F*>(obj),
+                              std::forward<Args>(args)...);
+    },
+    [](void* dst, void* src) {
+      ::new (dst) F(std::move(*static_cast<F*>(src)));
+      static_cast<F*>(src)->~F();
+    },
+    [](void* obj) { static_cast<F*>(obj)->~F(); },
+  };
+
+  alignas(std::max_align_t) mutable std::byte m_storage[SIZE];
+  const Operations* m_ops = nullptr;
+
+public:
+  /// Default ctor
+  constexpr InplaceFunction() = default;
+
+  /// Empty function
+  constexpr InplaceFunction(std::nullptr_t) {}
+
+  /**
+   * Store the callable.
+   *
+   * @param func the callable to store. It must fit into `SIZE` bytes.
+   */
+  template<class F>
+    requires(!std::is_same_v<std::remove_cvref_t<F>, InplaceFunction> &&
+             std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+  InplaceFunction(F&& func)
+  {
+    using T = std::decay_t<F>;
+    static_assert(sizeof(T) <= SIZE,
+                  "Callable does not fit, increase InplaceFunction SIZE");
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+                  "Callable is over-aligned");
+    static_assert(std::is_nothrow_move_constructible_v<T>,
+                  "Callable must be nothrow move constructible");
+    ::new (static_cast<void*>(m_storage)) T(std::forward<F>(func));
+    m_ops = &operationsFor<T>;
+  }
+
+  /// Move ctor
+  InplaceFunction(InplaceFunction&& other) noexcept
+    : m_ops(other.m_ops)
+  {
+    if (m_ops) {
+      m_ops->move(m_storage, other.m_storage);
+      other.m_ops = nullptr;
+    }
+  }
+
+  InplaceFunction(const InplaceFunction&) = delete;
+
+  /// Dtor
+  ~InplaceFunction() { reset(); }
+
+  /// Move assignment
+  InplaceFunction& operator=(InplaceFunction&& other) noexcept
+  {
+    if (this != &other) {
+      reset();
+      if (other.m_ops) {
+        other.m_ops->move(m_storage, other.m_storage);
+        m_ops = other.m_ops;
+        other.m_ops = nullptr;
+      }
+    }
+    return *this;
+  }
+
+  InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+  /// Destroy the stored callable, if any.
+  void reset()
+  {
+    if (m_ops) {
+      m_ops->destroy(m_storage);
+      m_ops = nullptr;
+    }
+  }
+
+  /// True if a callable is stored
+  explicit operator bool() const { return m_ops != nullptr; }
+
+  /// Invoke the stored callable.
+  R operator()(Args... args) const
+  {
+    SDL_assert_paranoid(m_ops != nullptr);
+    return m_ops->invoke(m_storage, std::forward<Args>(args)...);
+  }
+};
+
+template<class F>
+class FunctionRef;
+
+/**
+ * Non-owning reference to a callable.
+ *
+ * It is just a pair of pointers, so it is cheap to copy and it never
+ * allocates. The referenced callable must outlive it, which makes it a good
+ * fit for [immediate callbacks](#immediate-callback).
+ *
+ * @tparam R the return type.
+ * @tparam Args the parameters types.
+ *
+ * @sa InplaceFunction
+ */
+template<class R, class... Args>
+class FunctionRef<R(Args...)>
+{
+  void* m_obj;
+  R (*m_invoke)(void* obj, Args... args);
+
+public:
+  /**
+   * Reference the callable.
+   *
+   * @param func the callable to reference. It must outlive this object.
+   */
+  template<class F>
+    requires(!std::is_same_v<std::remove_cvref_t<F>, FunctionRef> &&
+             std::is_object_v<std::remove_reference_t<F>> &&
+             std::is_invocable_r_v<R, F&, Args...>)
+  constexpr FunctionRef(F&& func) noexcept
+    : m_obj(const_cast<void*>(static_cast<const void*>(std::addressof(func))))
+    , m_invoke([](void* obj, Args... args) -> R {
+      return std::invoke_r<R>(*static_cast<std::remove_reference_t<F>*>(obj),
+                              std::forward<Args>(args)...);
+    })
+  {
+  }
+
+  /// Invoke the referenced callable.
+  R operator()(Args... args) const
+  {
+    return m_invoke(m_obj, std::forward<Args>(args)...);
+  }
+};
+
 template<class F>
 struct CallbackWrapper;
 
@@ -99,6 +280,160 @@ struct CallbackWrapper<std::function<Result(Args...)>>
   }
 };
 
+/**
+ * @brief Wrapper [result callbacks](#result-callback) without allocation.
+ *
+ * Same interface as CallbackWrapper<std::function<Result(Args...)>>, but
+ * Wrap() moves the InplaceFunction into a statically allocated slot. Only when
+ * all POOL_SIZE slots are in use it falls back to the heap.
+ *
+ * @tparam Result the return type.
+ * @tparam Args the parameters types.
+ * @tparam SIZE the inline storage size, in bytes.
+ */
+template<class Result, class... Args, size_t SIZE>
+struct CallbackWrapper<InplaceFunction<Result(Args...), SIZE>>
+{
+  /// The wrapped InplaceFunction type
+  using ValueType = InplaceFunction<Result(Args...), SIZE>;
+
+  /// Number of callbacks that can be wrapped simultaneously without allocation
+  static constexpr size_t POOL_SIZE = 32;
+
+private:
+  struct Slot
+  {
+    alignas(ValueType) std::byte storage[sizeof(ValueType)];
+    std::atomic<bool> used;
+  };
+
+  static inline Slot s_pool[POOL_SIZE]{};
+
+  static Slot* FindSlot(void* handle)
+  {
+    std::less<const void*> less;
+    if (less(handle, s_pool) || !less(handle, s_pool + POOL_SIZE)) {
+      return nullptr;
+    }
+    auto offset = static_cast<std::byte*>(handle) -
+                  reinterpret_cast<std::byte*>(s_pool);
+    return &s_pool[offset / sizeof(Slot)];
+  }
+
+public:
+  /// Return unwrapped value of handle.
+  static const ValueType& Unwrap(void* handle)
+  {
+    return *static_cast<ValueType*>(handle);
+  }
+
+  /// Call
+  static Result Call(void* handle, Args... args)
+  {
+    auto& f = Unwrap(handle);
+    return f(args...);
+  }
+
+  /// Call with suffix handle.
+  static Result CallSuffixed(Args... args, void* handle)
+  {
+    auto& f = Unwrap(handle);
+    return f(args...);
+  }
+
+  CallbackWrapper() = delete;
+
+  /**
+   * @brief Change the callback into a void* pointer.
+   *
+   * @param cb the callback to wrap.
+   * @return void*
+   */
+  static ValueType* Wrap(ValueType&& cb)
+  {
+    for (auto& slot : s_pool) {
+      if (slot.used.load(std::memory_order_relaxed)) continue;
+      if (slot.used.exchange(true, std::memory_order_acquire)) continue;
+      return ::new (static_cast<void*>(slot.storage)) ValueType(std::move(cb));
+    }
+    return new ValueType(std::move(cb));
+  }
+
+  /// Call once and release.
+  static Result CallOnce(void* handle, Args... args)
+  {
+    auto f = release(handle);
+    return f(args...);
+  }
+
+  /// Call once and release with suffix handle.
+  static Result CallOnceSuffixed(Args... args, void* handle)
+  {
+    auto f = release(handle);
+    return f(args...);
+  }
+
+  /**
+   * @brief Transfer ownership from the function and free its slot.
+   *
+   * @param handle the handle to be released.
+   *
+   * @return the callback ready to be invoked.
+   */
+  static ValueType release(void* handle)
+  {
+    if (handle == nullptr) return {};
+    auto ptr = static_cast<ValueType*>(handle);
+    ValueType value{std::move(*ptr)};
+    if (auto slot = FindSlot(handle)) {
+      ptr->~ValueType();
+      slot->used.store(false, std::memory_order_release);
+    } else {
+      delete ptr;
+    }
+    return value;
+  }
+};
+
+/**
+ * @brief Wrapper for [immediate callbacks](#immediate-callback).
+ *
+ * The handle is just the address of the FunctionRef, so nothing is allocated
+ * and nothing needs to be released, but the FunctionRef must outlive the call.
+ *
+ * @tparam Result the return type.
+ * @tparam Args the parameters types.
+ */
+template<class Result, class... Args>
+struct CallbackWrapper<FunctionRef<Result(Args...)>>
+{
+  /// The wrapped FunctionRef type
+  using ValueType = FunctionRef<Result(Args...)>;
+
+  /// Return unwrapped value of handle.
+  static const ValueType& Unwrap(void* handle)
+  {
+    return *static_cast<const ValueType*>(handle);
+  }
+
+  /// Call
+  static Result Call(void* handle, Args... args)
+  {
+    return Unwrap(handle)(args...);
+  }
+
+  /// Call with suffix handle.
+  static Result CallSuffixed(Args... args, void* handle)
+  {
+    return Unwrap(handle)(args...);
+  }
+
+  CallbackWrapper() = delete;
+
+  /// Change the callback into a void* pointer.
+  static void* Wrap(const ValueType& cb) { return const_cast<ValueType*>(&cb); }
+};
+
 /**
  * Lightweight wrapper.
  *
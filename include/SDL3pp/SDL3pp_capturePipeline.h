@@ -0,0 +1,358 @@
+#ifndef SDL3PP_CAPTURE_PIPELINE_H_
+#define SDL3PP_CAPTURE_PIPELINE_H_
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "SDL3pp_render.h"
+#include "SDL3pp_timer.h"
+
+namespace SDL {
+
+/**
+ * @defgroup CategoryCapturePipeline Capture pipeline
+ *
+ * Record the screen without stalling the main thread.
+ *
+ * Renderer.ReadPixels() is unavoidably synchronous, but converting and
+ * encoding what it returns doesn't need to be. CapturePipeline does only the
+ * read back on the main thread and hands the frames to worker threads, which
+ * convert them with ConvertPixels() into a pool of preallocated surfaces and
+ * pass them to an encoder:
+ *
+ * ```cpp
+ * SDL::CapturePipeline capture(
+ *   [](SDL::SurfaceRef frame, Uint64 index) {
+ *     frame.SavePNG(std::format("capture-{:06}.png", index));
+ *   });
+ *
+ * // every frame, after rendering and before Present()
+ * capture.Capture(renderer);
+ * renderer.Present();
+ * ```
+ *
+ * At most a given number of frames are in flight. When the workers can't keep
+ * up, new frames are dropped or the main thread waits, depending on the
+ * CaptureOverflow policy.
+ *
+ * @{
+ */
+
+/**
+ * Encoder called on worker threads with each converted frame.
+ *
+ * @param frame the frame, in the pipeline pixel format. It is reused once the
+ *              encoder returns.
+ * @param index the frame number, counting all frames passed to
+ *              CapturePipeline.Capture(), including dropped ones. With more
+ *              than one worker, frames can be encoded out of order.
+ * @throws any exception, it is counted as a failure.
+ */
+using CaptureEncoder = std::function<void(SurfaceRef frame, Uint64 index)>;
+
+/**
+ * What CapturePipeline does with new frames when all are in flight.
+ *
+ * @sa CapturePipeline
+ */
+enum CaptureOverflow
+{
+  /// Drop the new frame, the main thread never waits.
+  CAPTURE_DROP,
+
+  /// Wait for a frame to be encoded, so no frame is lost.
+  CAPTURE_BLOCK,
+};
+
+/**
+ * Counters of a CapturePipeline.
+ *
+ * @sa CapturePipeline.GetStats
+ */
+struct CaptureStats
+{
+  /// Frames read back
+  Uint64 captured = 0;
+
+  /// Frames dropped because all were in flight
+  Uint64 dropped = 0;
+
+  /// Frames encoded successfully
+  Uint64 encoded = 0;
+
+  /// Frames whose conversion or encoding failed
+  Uint64 failed = 0;
+
+  /// Total time spent on the main thread, in nanoseconds
+  Uint64 captureNS = 0;
+
+  /// Longest time spent on the main thread for one frame, in nanoseconds
+  Uint64 maxCaptureNS = 0;
+
+  /// Total time spent converting and encoding, in nanoseconds
+  Uint64 encodeNS = 0;
+
+  /// Most frames in flight at the same time
+  Uint64 maxInFlight = 0;
+};
+
+/**
+ * Reads back frames on the main thread and encodes them on worker threads.
+ *
+ * @threadsafety Capture() should only be called on the main thread. The other
+ *               functions can be called from any thread.
+ */
+class CapturePipeline
+{
+  struct Job
+  {
+    Surface raw;
+    Uint64 index;
+    size_t slot;
+  };
+
+  CaptureEncoder m_encoder;
+  PixelFormat m_format;
+  CaptureOverflow m_overflow;
+  std::vector<Surface> m_pool;
+  std::vector<size_t> m_freeSlots;
+  std::deque<Job> m_jobs;
+  std::vector<std::thread> m_workers;
+  std::mutex m_mutex;
+  std::condition_variable m_jobReady;
+  std::condition_variable m_slotFree;
+  Uint64 m_next = 0;
+  Point m_reserved; ///< Size of the free pool surfaces, main thread only
+  bool m_quit = false;
+  CaptureStats m_stats;
+
+public:
+  /**
+   * Create the pipeline and start its workers.
+   *
+   * @param encoder called with each converted frame.
+   * @param format the pixel format the encoder gets frames in.
+   * @param depth the maximum number of frames in flight, which is also the
+   *              number of surfaces on the pool. They are allocated by
+   *              Reserve() or on the first Capture().
+   * @param workers the number of worker threads.
+   * @param overflow what to do with new frames when all are in flight.
+   */
+  explicit CapturePipeline(CaptureEncoder encoder,
+                           PixelFormat format = PIXELFORMAT_RGBA32,
+                           size_t depth = 4,
+                           size_t workers = 2,
+                           CaptureOverflow overflow = CAPTURE_DROP)
+    : m_encoder(std::move(encoder))
+    , m_format(format)
+    , m_overflow(overflow)
+  {
+    depth = std::max<size_t>(depth, 1);
+    m_pool.resize(depth);
+    for (size_t i = depth; i > 0; i--) m_freeSlots.push_back(i - 1);
+    workers = std::clamp<size_t>(workers, 1, depth);
+    m_workers.reserve(workers);
+    try {
+      for (size_t i = 0; i < workers; i++) {
+        m_workers.emplace_back([this] { Work(); });
+      }
+    } catch (...) {
+      Stop();
+      throw;
+    }
+  }
+
+  CapturePipeline(const CapturePipeline&) = delete;
+  CapturePipeline& operator=(const CapturePipeline&) = delete;
+
+  /// Encode all frames in flight and stop the workers.
+  ~CapturePipeline() { Stop(); }
+
+  /**
+   * Allocate the pool surfaces for frames of a given size.
+   *
+   * Capture() does it on the first frame and when the frame size changes.
+   * Calling it beforehand keeps the allocations out of the first frames.
+   *
+   * @param size the size of the frames.
+   * @throws Error on failure.
+   *
+   * @threadsafety This function should only be called on the main thread.
+   */
+  void Reserve(const PointRaw& size)
+  {
+    std::lock_guard lock{m_mutex};
+    for (size_t slot : m_freeSlots) Fit(m_pool[slot], size);
+    m_reserved = size;
+  }
+
+  /**
+   * Read back the current render target and queue it for encoding.
+   *
+   * The frame is dropped before reading anything when all frames are in
+   * flight and the overflow policy is CAPTURE_DROP.
+   *
+   * @param renderer the renderer to read from.
+   * @param rect the area to read, or nullptr for the entire viewport.
+   * @returns true if the frame was queued, false if it was dropped.
+   * @throws Error if reading fails.
+   *
+   * @threadsafety This function should only be called on the main thread.
+   */
+  bool Capture(RendererRef renderer, OptionalRef<const RectRaw> rect = {})
+  {
+    Uint64 start = GetTicksNS();
+    size_t slot;
+    Uint64 index;
+    {
+      std::unique_lock lock{m_mutex};
+      index = m_next++;
+      if (m_freeSlots.empty() && m_overflow == CAPTURE_DROP) {
+        m_stats.dropped++;
+        return false;
+      }
+      m_slotFree.wait(lock, [&] { return !m_freeSlots.empty(); });
+      slot = m_freeSlots.back();
+      m_freeSlots.pop_back();
+    }
+
+    Surface raw;
+    try {
+      raw = renderer.ReadPixels(rect);
+      Point size{raw->w, raw->h};
+      if (size != m_reserved) {
+        Reserve(size);
+        Fit(m_pool[slot], size);
+      }
+    } catch (...) {
+      Release(slot);
+      throw;
+    }
+
+    Uint64 elapsed = GetTicksNS() - start;
+    {
+      std::lock_guard lock{m_mutex};
+      m_jobs.push_back({std::move(raw), index, slot});
+      m_stats.captured++;
+      m_stats.captureNS += elapsed;
+      m_stats.maxCaptureNS = std::max(m_stats.maxCaptureNS, elapsed);
+      m_stats.maxInFlight = std::max<Uint64>(
+        m_stats.maxInFlight, m_pool.size() - m_freeSlots.size());
+    }
+    m_jobReady.notify_one();
+    return true;
+  }
+
+  /**
+   * Wait until all frames in flight are encoded.
+   *
+   * @threadsafety It is safe to call this function from any thread, but not
+   *               from the encoder.
+   */
+  void Flush()
+  {
+    std::unique_lock lock{m_mutex};
+    m_slotFree.wait(lock, [&] { return m_freeSlots.size() == m_pool.size(); });
+  }
+
+  /**
+   * Get the counters.
+   *
+   * @returns a snapshot of the counters.
+   */
+  CaptureStats GetStats()
+  {
+    std::lock_guard lock{m_mutex};
+    return m_stats;
+  }
+
+  /// Reset the counters.
+  void ResetStats()
+  {
+    std::lock_guard lock{m_mutex};
+    m_stats = {};
+  }
+
+private:
+  void Stop()
+  {
+    {
+      std::lock_guard lock{m_mutex};
+      m_quit = true;
+    }
+    m_jobReady.notify_all();
+    for (auto& worker : m_workers) worker.join();
+  }
+
+  /// Reallocate frame if it is not of the given size
+  void Fit(Surface& frame, const PointRaw& size)
+  {
+    if (!frame || frame->w != size.x || frame->h != size.y) {
+      frame = Surface(size, m_format);
+    }
+  }
+
+  void Release(size_t slot)
+  {
+    {
+      std::lock_guard lock{m_mutex};
+      m_freeSlots.push_back(slot);
+    }
+    m_slotFree.notify_all();
+  }
+
+  void Work()
+  {
+    for (;;) {
+      Job job;
+      {
+        std::unique_lock lock{m_mutex};
+        m_jobReady.wait(lock, [&] { return m_quit || !m_jobs.empty(); });
+        if (m_jobs.empty()) return;
+        job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+      }
+
+      Uint64 start = GetTicksNS();
+      bool ok = Encode(job);
+      Uint64 elapsed = GetTicksNS() - start;
+      job.raw = {};
+      {
+        std::lock_guard lock{m_mutex};
+        (ok ? m_stats.encoded : m_stats.failed)++;
+        m_stats.encodeNS += elapsed;
+      }
+      Release(job.slot);
+    }
+  }
+
+  /// Only the worker holding the slot touches its pool surface
+  bool Encode(Job& job)
+  {
+    try {
+      Surface& frame = m_pool[job.slot];
+      Fit(frame, {job.raw->w, job.raw->h});
+      ConvertPixels({job.raw->w, job.raw->h},
+                    job.raw->format,
+                    job.raw->pixels,
+                    job.raw->pitch,
+                    m_format,
+                    frame->pixels,
+                    frame->pitch);
+      m_encoder(frame, job.index);
+      return true;
+    } catch (...) {
+      return false;
+    }
+  }
+};
+
+/// @}
+
+} // namespace SDL
+
+#endif /* SDL3PP_CAPTURE_PIPELINE_H_ */
@@ -0,0 +1,357 @@
+#ifndef SDL3PP_DEBUG_TEXT_BATCH_H_
+#define SDL3PP_DEBUG_TEXT_BATCH_H_
+
+#include <format>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "SDL3pp_render.h"
+
+namespace SDL {
+
+/**
+ * @defgroup CategoryDebugTextBatch Debug text batching
+ *
+ * Draw lots of debug text with one draw call per frame.
+ *
+ * Renderer.RenderDebugTextFormat() formats into a new string on every call,
+ * and Renderer.RenderDebugText() submits one quad per character. That is fine
+ * for a line or two, but overlays with hundreds of lines spend more time there
+ * than on the actual frame. DebugTextBatch draws the same glyphs, but formats
+ * into a reused buffer, caches the quads of strings it has seen recently and
+ * submits all text with a single Renderer.RenderGeometry() call:
+ *
+ * ```cpp
+ * SDL::DebugTextBatch text{renderer};
+ *
+ * // each frame
+ * for (auto& entity : entities) {
+ *   text.DrawFormat(entity.pos, "{} hp:{}", entity.name, entity.hp);
+ * }
+ * text.Flush();
+ * renderer.Present();
+ * ```
+ *
+ * @{
+ */
+
+/**
+ * Counters of a DebugTextBatch.
+ *
+ * @sa DebugTextBatch.GetStats
+ */
+struct DebugTextStats
+{
+  /// Strings drawn
+  Uint64 strings = 0;
+
+  /// Glyph quads drawn, not counting blanks
+  Uint64 glyphs = 0;
+
+  /// Strings whose quads were found on the cache
+  Uint64 cacheHits = 0;
+
+  /// Strings whose quads had to be generated
+  Uint64 cacheMisses = 0;
+
+  /// Strings dropped from the cache after going unused
+  Uint64 evicted = 0;
+
+  /// Calls to Renderer.RenderGeometry()
+  Uint64 drawCalls = 0;
+};
+
+/**
+ * Accumulates debug text and draws it with Renderer.RenderGeometry().
+ *
+ * The glyphs are captured once from Renderer.RenderDebugText() into a texture
+ * owned by the batch, so text looks the same as drawn directly, including the
+ * replacement of characters the debug font lacks. Colors are per string,
+ * instead of coming from the draw color.
+ *
+ * Nothing is drawn until Flush() is called. Strings not drawn for a number of
+ * flushes are dropped from the cache.
+ *
+ * @threadsafety This class should only be used on the main thread.
+ */
+class DebugTextBatch
+{
+  static constexpr int CELL = DEBUG_TEXT_FONT_CHARACTER_SIZE;
+  static constexpr int COLUMNS = 16;
+
+  /// Codepoints up to 255 have their own cell, the last one is for the rest
+  static constexpr Uint32 REPLACEMENT = 256;
+  static constexpr int ROWS = REPLACEMENT / COLUMNS + 1;
+
+  struct Run
+  {
+    std::vector<Vertex> vertices;
+    Uint64 lastUsed;
+  };
+
+  struct StringHash
+  {
+    using is_transparent = void;
+
+    size_t operator()(std::string_view str) const
+    {
+      return std::hash<std::string_view>{}(str);
+    }
+  };
+
+  RendererRef m_renderer;
+  Texture m_glyphs;
+  std::unordered_map<std::string, Run, StringHash, std::equal_to<>> m_cache;
+  std::vector<Vertex> m_vertices;
+  std::vector<int> m_indices;
+  std::string m_buffer;
+  FColor m_color{1, 1, 1, 1};
+  Uint64 m_frame = 0;
+  Uint64 m_keepFrames = 60;
+  DebugTextStats m_stats;
+
+public:
+  /**
+   * Create the batch and capture the debug font glyphs.
+   *
+   * @param renderer the renderer to draw to.
+   * @param capacity the number of glyphs to reserve space for.
+   * @throws Error on failure.
+   */
+  explicit DebugTextBatch(RendererRef renderer, size_t capacity = 4096)
+    : m_renderer(renderer)
+  {
+    m_vertices.reserve(capacity * 4);
+    m_indices.reserve(capacity * 6);
+    RebuildGlyphs();
+  }
+
+  DebugTextBatch(const DebugTextBatch&) = delete;
+  DebugTextBatch& operator=(const DebugTextBatch&) = delete;
+
+  /**
+   * Capture the debug font glyphs again.
+   *
+   * The glyphs live on a render target texture, call this after receiving
+   * EVENT_RENDER_TARGETS_RESET or EVENT_RENDER_DEVICE_RESET.
+   *
+   * @throws Error on failure.
+   */
+  void RebuildGlyphs()
+  {
+    Texture glyphs(m_renderer,
+                   PIXELFORMAT_RGBA32,
+                   TEXTUREACCESS_TARGET,
+                   {COLUMNS * CELL, ROWS * CELL});
+    glyphs.SetBlendMode(BLENDMODE_BLEND);
+    glyphs.SetScaleMode(SCALEMODE_NEAREST);
+
+    struct Restore
+    {
+      RendererRef renderer;
+      SDL_Texture* target;
+      FColor color;
+      ~Restore()
+      {
+        SDL_SetRenderTarget(renderer, target);
+        SDL_SetRenderDrawColorFloat(
+          renderer, color.r, color.g, color.b, color.a);
+      }
+    } restore{m_renderer,
+              SDL_GetRenderTarget(m_renderer),
+              m_renderer.GetDrawColorFloat()};
+
+    m_renderer.SetTarget(glyphs);
+    m_renderer.SetDrawColorFloat({0, 0, 0, 0});
+    m_renderer.RenderClear();
+    m_renderer.SetDrawColorFloat({1, 1, 1, 1});
+    for (Uint32 cell = 1; cell <= REPLACEMENT; cell++) {
+      char utf8[5] = {};
+      UCS4ToUTF8(cell == REPLACEMENT ? 0xFFFD : cell, utf8);
+      m_renderer.RenderDebugText(
+        {float(cell % COLUMNS * CELL), float(cell / COLUMNS * CELL)}, utf8);
+    }
+    m_glyphs = std::move(glyphs);
+  }
+
+  /**
+   * Set the color of the strings drawn next.
+   *
+   * @param color the color, white by default.
+   */
+  void SetColor(const FColorRaw& color) { m_color = color; }
+
+  /**
+   * Get the color of the strings drawn next.
+   *
+   * @returns the color.
+   */
+  const FColor& GetColor() const { return m_color; }
+
+  /**
+   * Set for how many flushes unused strings are kept on the cache.
+   *
+   * @param frames the number of flushes, 0 keeps only the strings drawn on the
+   *               last frame.
+   */
+  void SetCacheFrames(Uint64 frames) { m_keepFrames = frames; }
+
+  /**
+   * Get the number of strings on the cache.
+   *
+   * @returns the number of strings.
+   */
+  size_t GetCacheSize() const { return m_cache.size(); }
+
+  /**
+   * Queue a string.
+   *
+   * Like Renderer.RenderDebugText(), the string is UTF-8 and has no line
+   * breaks.
+   *
+   * @param p the x, y coordinates of the top left corner of the text.
+   * @param text the text.
+   */
+  void Draw(const FPointRaw& p, std::string_view text)
+  {
+    m_stats.strings++;
+    auto it = m_cache.find(text);
+    if (it == m_cache.end()) {
+      m_stats.cacheMisses++;
+      it = m_cache.emplace(std::string(text), Run{Build(text), 0}).first;
+    } else {
+      m_stats.cacheHits++;
+    }
+    Run& run = it->second;
+    run.lastUsed = m_frame;
+    m_stats.glyphs += run.vertices.size() / 4;
+    for (Vertex vertex : run.vertices) {
+      vertex.position.x += p.x;
+      vertex.position.y += p.y;
+      vertex.color = m_color;
+      m_vertices.push_back(vertex);
+    }
+  }
+
+  /**
+   * Format and queue a string.
+   *
+   * The string is formatted into a buffer reused between calls.
+   *
+   * @param p the x, y coordinates of the top left corner of the text.
+   * @param fmt the std::format() like format string.
+   * @param args additional parameters matching {} tokens in the `fmt` string,
+   *             if any.
+   */
+  template<class... ARGS>
+  void DrawFormat(const FPointRaw& p, std::string_view fmt, ARGS... args)
+  {
+    m_buffer.clear();
+    std::vformat_to(
+      std::back_inserter(m_buffer), fmt, std::make_format_args(args...));
+    Draw(p, m_buffer);
+  }
+
+  /**
+   * Get the number of glyph quads queued.
+   *
+   * @returns the number of quads.
+   */
+  size_t size() const { return m_vertices.size() / 4; }
+
+  /**
+   * Check if no glyph is queued.
+   *
+   * @returns true if empty.
+   */
+  bool empty() const { return m_vertices.empty(); }
+
+  /// Discard queued text, keeping the cache.
+  void clear() { m_vertices.clear(); }
+
+  /**
+   * Draw all queued text with one Renderer.RenderGeometry() call.
+   *
+   * This also ends a frame for the cache, dropping the strings that went
+   * unused for too long.
+   *
+   * @throws Error on failure. The queued text is discarded anyway.
+   */
+  void Flush()
+  {
+    struct Cleanup
+    {
+      DebugTextBatch* self;
+      ~Cleanup()
+      {
+        self->clear();
+        self->Evict();
+      }
+    } cleanup{this};
+
+    if (m_vertices.empty()) return;
+    size_t quads = size();
+    for (size_t quad = m_indices.size() / 6; quad < quads; quad++) {
+      int base = int(quad * 4);
+      m_indices.insert(m_indices.end(),
+                       {base, base + 1, base + 2, base + 2, base + 3, base});
+    }
+    m_stats.drawCalls++;
+    m_renderer.RenderGeometry(
+      m_glyphs, m_vertices, std::span{m_indices}.first(quads * 6));
+  }
+
+  /**
+   * Get the counters.
+   *
+   * @returns the counters since creation or the last ResetStats().
+   */
+  const DebugTextStats& GetStats() const { return m_stats; }
+
+  /// Reset the counters.
+  void ResetStats() { m_stats = {}; }
+
+private:
+  std::vector<Vertex> Build(std::string_view text) const
+  {
+    constexpr float u = 1.f / (COLUMNS * CELL);
+    constexpr float v = 1.f / (ROWS * CELL);
+    std::vector<Vertex> vertices;
+    const char* str = text.data();
+    size_t len = text.size();
+    float x = 0;
+    while (len > 0) {
+      Uint32 codepoint = StepUTF8(&str, &len);
+      if (codepoint == 0) break;
+      Uint32 cell = codepoint < REPLACEMENT ? codepoint : REPLACEMENT;
+      if (cell != ' ') {
+        float u0 = float(cell % COLUMNS * CELL) * u;
+        float v0 = float(cell / COLUMNS * CELL) * v;
+        float u1 = u0 + CELL * u;
+        float v1 = v0 + CELL * v;
+        vertices.push_back({{x, 0}, {}, {u0, v0}});
+        vertices.push_back({{x + CELL, 0}, {}, {u1, v0}});
+        vertices.push_back({{x + CELL, CELL}, {}, {u1, v1}});
+        vertices.push_back({{x, CELL}, {}, {u0, v1}});
+      }
+      x += CELL;
+    }
+    return vertices;
+  }
+
+  void Evict()
+  {
+    m_frame++;
+    m_stats.evicted += std::erase_if(m_cache, [&](auto& entry) {
+      return m_frame - entry.second.lastUsed > m_keepFrames + 1;
+    });
+  }
+};
+
+/// @}
+
+} // namespace SDL
+
+#endif /* SDL3PP_DEBUG_TEXT_BATCH_H_ */
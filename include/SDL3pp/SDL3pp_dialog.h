@@ -254,6 +254,52 @@ inline void ShowOpenFileDialog(DialogFileCB callback,
                      allow_many);
 }
 
+/**
+ * Displays a dialog that lets the user select a file on their filesystem.
+ *
+ * Same as ShowOpenFileDialog(DialogFileCB, WindowRef,
+ * std::span<const DialogFileFilter>, StringParam, bool), but the callback is
+ * kept in a preallocated slot, so no heap allocation is done on our side to
+ * track it.
+ *
+ * @param callback a function to be invoked when the user selects a file and
+ *                 accepts, or cancels the dialog, or an error occurs.
+ * @param window the window that the dialog should be modal for, may be nullptr.
+ * @param filters a list of filters, may be empty. It must remain valid at least
+ *                until the callback is invoked.
+ * @param default_location the default folder or file to start the dialog at,
+ *                         may be nullptr.
+ * @param allow_many if true, the user will be allowed to select multiple
+ *                   entries.
+ *
+ * @threadsafety This function should be called only from the main thread. The
+ *               callback may be invoked from the same thread or from a
+ *               different one, depending on the OS's constraints.
+ *
+ * @since This function is available since SDL 3.2.0.
+ *
+ * @sa result-callback
+ *
+ * @cat result-callback
+ */
+template<size_t SIZE>
+inline void ShowOpenFileDialog(
+  InplaceFunction<void(const char* const* filelist, int filter), SIZE> callback,
+  WindowRef window,
+  std::span<const DialogFileFilter> filters = {},
+  StringParam default_location = {},
+  bool allow_many = false)
+{
+  using Wrapper = CallbackWrapper<
+    InplaceFunction<void(const char* const* filelist, int filter), SIZE>>;
+  ShowOpenFileDialog(&Wrapper::CallOnce,
+                     Wrapper::Wrap(std::move(callback)),
+                     window,
+                     filters,
+                     std::move(default_location),
+                     allow_many);
+}
+
 /**
  * Displays a dialog that lets the user choose a new or existing file on their
  * filesystem.
@@ -371,6 +417,48 @@ inline void ShowSaveFileDialog(DialogFileCB callback,
                      std::move(default_location));
 }
 
+/**
+ * Displays a dialog that lets the user choose a new or existing file on their
+ * filesystem.
+ *
+ * Same as ShowSaveFileDialog(DialogFileCB, WindowRef,
+ * std::span<const DialogFileFilter>, StringParam), but the callback is kept in
+ * a preallocated slot, so no heap allocation is done on our side to track it.
+ *
+ * @param callback a function to be invoked when the user selects a file and
+ *                 accepts, or cancels the dialog, or an error occurs.
+ * @param window the window that the dialog should be modal for, may be nullptr.
+ * @param filters a list of filters, may be empty. It must remain valid at least
+ *                until the callback is invoked.
+ * @param default_location the default folder or file to start the dialog at,
+ *                         may be nullptr.
+ *
+ * @threadsafety This function should be called only from the main thread. The
+ *               callback may be invoked from the same thread or from a
+ *               different one, depending on the OS's constraints.
+ *
+ * @since This function is available since SDL 3.2.0.
+ *
+ * @sa result-callback
+ *
+ * @cat result-callback
+ */
+template<size_t SIZE>
+inline void ShowSaveFileDialog(
+  InplaceFunction<void(const char* const* filelist, int filter), SIZE> callback,
+  WindowRef window = {},
+  std::span<const DialogFileFilter> filters = {},
+  StringParam default_location = {})
+{
+  using Wrapper = CallbackWrapper<
+    InplaceFunction<void(const char* const* filelist, int filter), SIZE>>;
+  ShowSaveFileDialog(&Wrapper::CallOnce,
+                     Wrapper::Wrap(std::move(callback)),
+                     window,
+                     filters,
+                     std::move(default_location));
+}
+
 /**
  * Displays a dialog that lets the user select a folder on their filesystem.
  *
@@ -478,6 +566,47 @@ inline void ShowOpenFolderDialog(DialogFileCB callback,
                        allow_many);
 }
 
+/**
+ * Displays a dialog that lets the user select a folder on their filesystem.
+ *
+ * Same as ShowOpenFolderDialog(DialogFileCB, WindowRef, StringParam, bool), but
+ * the callback is kept in a preallocated slot, so no heap allocation is done on
+ * our side to track it.
+ *
+ * @param callback a function to be invoked when the user selects a file and
+ *                 accepts, or cancels the dialog, or an error occurs.
+ * @param window the window that the dialog should be modal for, may be nullptr.
+ * @param default_location the default folder or file to start the dialog at,
+ *                         may be nullptr.
+ * @param allow_many if true, the user will be allowed to select multiple
+ *                   entries.
+ *
+ * @threadsafety This function should be called only from the main thread. The
+ *               callback may be invoked from the same thread or from a
+ *               different one, depending on the OS's constraints.
+ *
+ * @since This function is available since SDL 3.2.0.
+ *
+ * @sa result-callback
+ *
+ * @cat result-callback
+ */
+template<size_t SIZE>
+inline void ShowOpenFolderDialog(
+  InplaceFunction<void(const char* const* filelist, int filter), SIZE> callback,
+  WindowRef window = {},
+  StringParam default_location = {},
+  bool allow_many = false)
+{
+  using Wrapper = CallbackWrapper<
+    InplaceFunction<void(const char* const* filelist, int filter), SIZE>>;
+  ShowOpenFolderDialog(&Wrapper::CallOnce,
+                       Wrapper::Wrap(std::move(callback)),
+                       std::move(window),
+                       std::move(default_location),
+                       allow_many);
+}
+
 /**
  * Various types of file dialogs.
  *
@@ -604,6 +733,40 @@ inline void ShowFileDialogWithProperties(FileDialogType type,
     type, &Wrapper::CallOnce, Wrapper::Wrap(std::move(callback)), props);
 }
 
+/**
+ * Create and launch a file dialog with the specified properties.
+ *
+ * Same as ShowFileDialogWithProperties(FileDialogType, DialogFileCB,
+ * PropertiesID), but the callback is kept in a preallocated slot, so no heap
+ * allocation is done on our side to track it.
+ *
+ * @param type the type of file dialog.
+ * @param callback a function to be invoked when the user selects a file and
+ *                 accepts, or cancels the dialog, or an error occurs.
+ * @param props the properties to use.
+ *
+ * @threadsafety This function should be called only from the main thread. The
+ *               callback may be invoked from the same thread or from a
+ *               different one, depending on the OS's constraints.
+ *
+ * @since This function is available since SDL 3.2.0.
+ *
+ * @sa result-callback
+ *
+ * @cat result-callback
+ */
+template<size_t SIZE>
+inline void ShowFileDialogWithProperties(
+  FileDialogType type,
+  InplaceFunction<void(const char* const* filelist, int filter), SIZE> callback,
+  PropertiesID props)
+{
+  using Wrapper = CallbackWrapper<
+    InplaceFunction<void(const char* const* filelist, int filter), SIZE>>;
+  ShowFileDialogWithProperties(
+    type, &Wrapper::CallOnce, Wrapper::Wrap(std::move(callback)), props);
+}
+
 /**
  * Properties for file dialogs.
  *
@@ -0,0 +1,241 @@
+#ifndef SDL3PP_DIRTY_REGION_H_
+#define SDL3PP_DIRTY_REGION_H_
+
+#include <span>
+#include <vector>
+#include "SDL3pp_rect.h"
+#include "SDL3pp_video.h"
+
+namespace SDL {
+
+/**
+ * @defgroup CategoryDirtyRegion Dirty regions
+ *
+ * Present only the parts of a window surface that changed.
+ *
+ * Applications drawing on Window.GetSurface() usually call
+ * Window.UpdateSurface() every frame, copying the whole window even when
+ * nothing changed. DirtyRegion collects the rectangles that were drawn to,
+ * merging them into a few larger ones, and presents only those with
+ * Window.UpdateSurfaceRects():
+ *
+ * ```cpp
+ * SDL::DirtyRegion dirty{window.GetSizeInPixels()};
+ * // ...
+ * if (button.changed) {
+ *   DrawButton(surface, button);
+ *   dirty.Add(button.rect);
+ * }
+ * dirty.Present(window); // Nearly free if nothing was added
+ * ```
+ *
+ * @{
+ */
+
+/**
+ * Counters of a DirtyRegion.
+ *
+ * @sa DirtyRegion.GetStats
+ */
+struct DirtyRegionStats
+{
+  /// Calls to DirtyRegion.Present()
+  Uint64 frames = 0;
+
+  /// Calls to DirtyRegion.Present() that had nothing to present
+  Uint64 idleFrames = 0;
+
+  /// Pixels presented on all frames
+  Uint64 pixels = 0;
+
+  /// Pixels presented on the last frame
+  Uint64 lastPixels = 0;
+
+  /// Rectangles presented on the last frame
+  Uint32 lastRects = 0;
+};
+
+/**
+ * Accumulates damaged rectangles of a window surface.
+ *
+ * Each added rectangle is clipped to the bounds and merged with the pending
+ * rectangles when that is cheaper than presenting them apart: two rectangles
+ * are merged when their union has no more pixels than both of them plus the
+ * merge cost, set with SetMergeCost(), that stands for the fixed overhead of
+ * presenting one more rectangle. When there are too many rectangles, the pair
+ * wasting less pixels is merged.
+ *
+ * @threadsafety This class should only be used on the main thread.
+ */
+class DirtyRegion
+{
+  Rect m_bounds;
+  std::vector<Rect> m_rects;
+  size_t m_maxRects;
+  Uint64 m_mergeCost = 4096;
+  DirtyRegionStats m_stats;
+
+public:
+  /**
+   * Create a region.
+   *
+   * The whole bounds start dirty, so the first frame is fully presented.
+   *
+   * @param size the size of the window surface, in pixels.
+   * @param maxRects the maximum number of rectangles to present at once.
+   */
+  explicit DirtyRegion(const PointRaw& size, size_t maxRects = 16)
+    : m_bounds({0, 0}, size)
+    , m_maxRects(maxRects > 0 ? maxRects : 1)
+  {
+    Invalidate();
+  }
+
+  /**
+   * Change the size of the window surface.
+   *
+   * Everything is marked dirty, as the surface is recreated on resize.
+   *
+   * @param size the new size, in pixels.
+   */
+  void Resize(const PointRaw& size)
+  {
+    m_bounds = Rect({0, 0}, size);
+    Invalidate();
+  }
+
+  /**
+   * Set the cost of presenting one more rectangle.
+   *
+   * Higher values merge more eagerly, presenting less rectangles but more
+   * pixels.
+   *
+   * @param pixels the cost, in pixels. The default is 4096.
+   */
+  void SetMergeCost(Uint64 pixels) { m_mergeCost = pixels; }
+
+  /**
+   * Mark a rectangle as changed.
+   *
+   * @param rect the rectangle, in pixels. It is clipped to the bounds.
+   */
+  void Add(const RectRaw& rect)
+  {
+    Rect clipped = m_bounds.GetIntersection(rect);
+    if (clipped.Empty()) return;
+
+    // Merging can make the result overlap rectangles checked before it
+    for (size_t i = 0; i < m_rects.size();) {
+      if (ShouldMerge(m_rects[i], clipped)) {
+        clipped = clipped.GetUnion(m_rects[i]);
+        m_rects.erase(m_rects.begin() + i);
+        i = 0;
+      } else {
+        i++;
+      }
+    }
+    m_rects.push_back(clipped);
+    while (m_rects.size() > m_maxRects) MergeCheapest();
+  }
+
+  /// Mark everything as changed.
+  void Invalidate()
+  {
+    m_rects.clear();
+    if (!m_bounds.Empty()) m_rects.push_back(m_bounds);
+  }
+
+  /**
+   * Get the pending rectangles.
+   *
+   * They don't overlap when merging them costs less than the merge cost.
+   *
+   * @returns the rectangles.
+   */
+  std::span<const Rect> GetRects() const { return m_rects; }
+
+  /**
+   * Check if nothing changed.
+   *
+   * @returns true if there are no pending rectangles.
+   */
+  bool empty() const { return m_rects.empty(); }
+
+  /// Forget the pending rectangles.
+  void clear() { m_rects.clear(); }
+
+  /**
+   * Copy the pending rectangles of the window surface to the screen.
+   *
+   * The pending rectangles are cleared, unless it fails.
+   *
+   * @param window the window.
+   * @throws Error on failure.
+   *
+   * @threadsafety This function should only be called on the main thread.
+   */
+  void Present(WindowRef window)
+  {
+    m_stats.frames++;
+    m_stats.lastRects = Uint32(m_rects.size());
+    m_stats.lastPixels = 0;
+    if (m_rects.empty()) {
+      m_stats.idleFrames++;
+      return;
+    }
+    for (const Rect& rect : m_rects) m_stats.lastPixels += Area(rect);
+    m_stats.pixels += m_stats.lastPixels;
+    UpdateWindowSurfaceRects(window, m_rects);
+    m_rects.clear();
+  }
+
+  /**
+   * Get the counters.
+   *
+   * @returns the counters since creation or the last ResetStats().
+   */
+  const DirtyRegionStats& GetStats() const { return m_stats; }
+
+  /// Reset the counters.
+  void ResetStats() { m_stats = {}; }
+
+private:
+  static Uint64 Area(const RectRaw& rect) { return Uint64(rect.w) * rect.h; }
+
+  /// Pixels presented needlessly if a and b are merged
+  static Sint64 Waste(const Rect& a, const Rect& b)
+  {
+    Uint64 overlap = Area(a.GetIntersection(b));
+    return Sint64(Area(a.GetUnion(b)) + overlap) -
+           Sint64(Area(a) + Area(b));
+  }
+
+  bool ShouldMerge(const Rect& a, const Rect& b) const
+  {
+    return Waste(a, b) <= Sint64(m_mergeCost);
+  }
+
+  void MergeCheapest()
+  {
+    size_t bestA = 0, bestB = 1;
+    Sint64 best = Waste(m_rects[0], m_rects[1]);
+    for (size_t a = 0; a < m_rects.size(); a++) {
+      for (size_t b = a + 1; b < m_rects.size(); b++) {
+        Sint64 waste = Waste(m_rects[a], m_rects[b]);
+        if (waste < best) {
+          best = waste;
+          bestA = a;
+          bestB = b;
+        }
+      }
+    }
+    m_rects[bestA] = m_rects[bestA].GetUnion(m_rects[bestB]);
+    m_rects.erase(m_rects.begin() + bestB);
+  }
+};
+
+/// @}
+
+} // namespace SDL
+
+#endif /* SDL3PP_DIRTY_REGION_H_ */
@@ -0,0 +1,254 @@
+#ifndef SDL3PP_EVENT_CHANNEL_H_
+#define SDL3PP_EVENT_CHANNEL_H_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "SDL3pp_atomic.h"
+#include "SDL3pp_events.h"
+
+namespace SDL {
+
+/**
+ * @defgroup CategoryEventChannel Event channels
+ *
+ * Lock-free message passing from worker threads to the main loop.
+ *
+ * An EventChannel is a bounded multi-producer, single-consumer ring of
+ * messages. Any thread can Push() messages and the consumer, usually the main
+ * thread, gets them all at once with Drain(). Messages are stored directly on
+ * preallocated ring slots, so no allocation is done per message, and pushing
+ * never locks.
+ *
+ * The channel registers its own event type with RegisterEvents() and pushes
+ * one event of that type when the ring goes from empty to non-empty, no matter
+ * how many messages are pushed until the consumer drains it:
+ *
+ * ```cpp
+ * SDL::EventChannel<LoadedAsset> assets{256};
+ *
+ * // on workers
+ * assets.Push(LoadAsset(path));
+ *
+ * // on main thread
+ * SDL::AppResult Event(const SDL::Event& event) override
+ * {
+ *   if (assets.IsWakeEvent(event)) {
+ *     assets.Drain([&](LoadedAsset&& asset) { Install(std::move(asset)); });
+ *   }
+ *   return SDL::APP_CONTINUE;
+ * }
+ * ```
+ *
+ * @{
+ */
+
+/**
+ * Bounded lock-free multi-producer single-consumer channel.
+ *
+ * @tparam T the message type. It must be nothrow move constructible.
+ *
+ * @threadsafety Push() can be called from any thread. Drain(), TryPop() and
+ *               IsWakeEvent() must only be called from a single consumer
+ *               thread at a time.
+ */
+template<class T>
+class EventChannel
+{
+  static_assert(std::is_nothrow_move_constructible_v<T>,
+                "T must be nothrow move constructible");
+
+  static constexpr size_t CACHE_LINE = 64;
+
+  struct Slot
+  {
+    AtomicU32 sequence{0};
+    alignas(T) std::byte storage[sizeof(T)];
+
+    T* get() { return std::launder(reinterpret_cast<T*>(storage)); }
+  };
+
+  alignas(CACHE_LINE) AtomicU32 m_tail{0};
+  AtomicInt m_signaled{0};
+
+  alignas(CACHE_LINE) Uint32 m_head = 0;
+  Uint32 m_mask;
+  Uint32 m_eventType;
+  std::unique_ptr<Slot[]> m_slots;
+
+public:
+  /// Default capacity
+  static constexpr Uint32 DEFAULT_CAPACITY = 1024;
+
+  /**
+   * Create a channel.
+   *
+   * @param capacity the maximum number of pending messages, rounded up to a
+   *                 power of two.
+   * @throws Error if no more user event types are available.
+   */
+  explicit EventChannel(Uint32 capacity = DEFAULT_CAPACITY)
+  {
+    Uint32 size = 2;
+    while (size < capacity && size < 0x80000000u) size *= 2;
+    m_mask = size - 1;
+    m_slots = std::make_unique<Slot[]>(size);
+    for (Uint32 i = 0; i < size; i++) m_slots[i].sequence.Set(i);
+    m_eventType = RegisterEvents(1);
+    if (m_eventType == 0) {
+      SetError("No user event types left");
+      throw Error();
+    }
+  }
+
+  EventChannel(const EventChannel&) = delete;
+  EventChannel& operator=(const EventChannel&) = delete;
+
+  /// Destroy pending messages and discard pending wake events.
+  ~EventChannel()
+  {
+    Drain([](T&&) {});
+    FlushEvent(m_eventType);
+  }
+
+  /**
+   * Push a message.
+   *
+   * If the channel was empty, a wake event is pushed to the event queue.
+   *
+   * @param message the message.
+   * @returns true on success or false if the channel is full. On failure the
+   *          message is not moved from.
+   *
+   * @threadsafety It is safe to call this function from any thread.
+   */
+  bool Push(T&& message) { return Emplace(std::move(message)); }
+
+  /**
+   * Push a message.
+   *
+   * @param message the message.
+   * @returns true on success or false if the channel is full.
+   *
+   * @threadsafety It is safe to call this function from any thread.
+   */
+  bool Push(const T& message) { return Emplace(message); }
+
+  /**
+   * Construct a message in place.
+   *
+   * If the channel was empty, a wake event is pushed to the event queue.
+   *
+   * @param args the arguments forwarded to T constructor.
+   * @returns true on success or false if the channel is full.
+   *
+   * @threadsafety It is safe to call this function from any thread.
+   */
+  template<class... ARGS>
+  bool Emplace(ARGS&&... args)
+  {
+    Uint32 pos = m_tail.Get();
+    Slot* slot;
+    for (;;) {
+      slot = &m_slots[pos & m_mask];
+      auto diff = Sint32(slot->sequence.Get() - pos);
+      if (diff == 0) {
+        if (m_tail.CompareAndSwap(pos, pos + 1)) break;
+      } else if (diff < 0) {
+        return false;
+      }
+      pos = m_tail.Get();
+    }
+    ::new (slot->storage) T(std::forward<ARGS>(args)...);
+    slot->sequence.Set(pos + 1);
+    Wake();
+    return true;
+  }
+
+  /**
+   * Check if the event is the wake event of this channel.
+   *
+   * @param event the event.
+   * @returns true if it is.
+   */
+  bool IsWakeEvent(const Event& event) const
+  {
+    return event.type == m_eventType;
+  }
+
+  /**
+   * Get the event type registered for this channel.
+   *
+   * @returns the event type.
+   */
+  Uint32 GetEventType() const { return m_eventType; }
+
+  /**
+   * Pop a single message.
+   *
+   * When the channel is found empty, the wake event is re-armed.
+   *
+   * @param message receives the message.
+   * @returns true if a message was popped or false if the channel is empty.
+   *
+   * @threadsafety Only the consumer thread can call this.
+   */
+  bool TryPop(T& message)
+  {
+    auto assign = [&](T&& value) { message = std::move(value); };
+    if (PopOne(assign)) return true;
+    m_signaled.Set(0);
+    return PopOne(assign);
+  }
+
+  /**
+   * Pop all pending messages.
+   *
+   * This also re-arms the wake event, so new messages pushed after or during
+   * this call trigger a new one.
+   *
+   * @param callback called with each message, as `T&&`, in push order.
+   * @returns the number of messages handled.
+   *
+   * @threadsafety Only the consumer thread can call this.
+   */
+  template<class F>
+  size_t Drain(F&& callback)
+  {
+    m_signaled.Set(0);
+    size_t count = 0;
+    while (PopOne(callback)) count++;
+    return count;
+  }
+
+private:
+  template<class F>
+  bool PopOne(F& callback)
+  {
+    Slot& slot = m_slots[m_head & m_mask];
+    if (slot.sequence.Get() != m_head + 1) return false;
+    T* value = slot.get();
+    callback(std::move(*value));
+    value->~T();
+    slot.sequence.Set(m_head + m_mask + 1);
+    m_head++;
+    return true;
+  }
+
+  void Wake()
+  {
+    if (!m_signaled.CompareAndSwap(0, 1)) return;
+    Event event{};
+    event.user.type = m_eventType;
+    event.user.data1 = this;
+    if (!SDL_PushEvent(&event)) m_signaled.Set(0);
+  }
+};
+
+/// @}
+
+} // namespace SDL
+
+#endif /* SDL3PP_EVENT_CHANNEL_H_ */
@@ -0,0 +1,499 @@
+#ifndef SDL3PP_EVENT_DISPATCHER_H_
+#define SDL3PP_EVENT_DISPATCHER_H_
+
+#include <array>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include "SDL3pp_events.h"
+
+namespace SDL {
+
+/**
+ * @defgroup CategoryEventDispatcher Event dispatching
+ *
+ * Compile time typed event dispatching.
+ *
+ * EventDispatcher takes a set of handlers, each one accepting one of the
+ * event structures, like KeyboardEvent or MouseMotionEvent, and calls the
+ * right one for each Event it receives:
+ *
+ * ```cpp
+ * SDL::EventDispatcher dispatch{
+ *   [&](const SDL::KeyboardEvent& key) { player.OnKey(key); },
+ *   [&](const SDL::MouseMotionEvent& motion) { aim.Move(motion); },
+ *   [&](const SDL::QuitEvent&) { running = false; },
+ * };
+ *
+ * SDL::EventBatch batch;
+ * while (batch.Poll()) dispatch(batch);
+ * ```
+ *
+ * The event types each structure is used for are known at compile time, so
+ * the dispatcher builds a constant table from event type to handler and
+ * dispatching an event is one table lookup and one indirect call. There are no
+ * virtual calls, no std::function and no allocations involved.
+ *
+ * @{
+ */
+
+/**
+ * Describe which event types are delivered with a given event structure.
+ *
+ * Each specialization has a `types` array with all event types using the
+ * structure T and static `Get(Event&)` and `Get(const Event&)` functions
+ * returning the matching member of Event.
+ *
+ * @tparam T the event structure.
+ */
+template<class T>
+struct EventTraits;
+
+/// @cond
+namespace detail {
+
+template<EventType FIRST, EventType LAST>
+constexpr std::array<EventType, LAST - FIRST + 1> EventTypeRange()
+{
+  std::array<EventType, LAST - FIRST + 1> r{};
+  for (size_t i = 0; i < r.size(); i++) r[i] = EventType(FIRST + i);
+  return r;
+}
+
+} // namespace detail
+/// @endcond
+
+#define SDL3PP_EVENT_TRAITS(TYPE, MEMBER, ...)                                 \
+  template<>                                                                   \
+  struct EventTraits<TYPE>                                                     \
+  {                                                                            \
+    static constexpr EventType types[] = {__VA_ARGS__};                        \
+    static TYPE& Get(Event& event) { return event.MEMBER; }                    \
+    static const TYPE& Get(const Event& event) { return event.MEMBER; }        \
+  }
+
+/// @cond
+SDL3PP_EVENT_TRAITS(QuitEvent, quit, EVENT_QUIT);
+SDL3PP_EVENT_TRAITS(KeyboardEvent, key, EVENT_KEY_DOWN, EVENT_KEY_UP);
+SDL3PP_EVENT_TRAITS(TextEditingEvent, edit, EVENT_TEXT_EDITING);
+SDL3PP_EVENT_TRAITS(TextInputEvent, text, EVENT_TEXT_INPUT);
+SDL3PP_EVENT_TRAITS(KeyboardDeviceEvent,
+                    kdevice,
+                    EVENT_KEYBOARD_ADDED,
+                    EVENT_KEYBOARD_REMOVED);
+SDL3PP_EVENT_TRAITS(TextEditingCandidatesEvent,
+                    edit_candidates,
+                    EVENT_TEXT_EDITING_CANDIDATES);
+SDL3PP_EVENT_TRAITS(MouseMotionEvent, motion, EVENT_MOUSE_MOTION);
+SDL3PP_EVENT_TRAITS(MouseButtonEvent,
+                    button,
+                    EVENT_MOUSE_BUTTON_DOWN,
+                    EVENT_MOUSE_BUTTON_UP);
+SDL3PP_EVENT_TRAITS(MouseWheelEvent, wheel, EVENT_MOUSE_WHEEL);
+SDL3PP_EVENT_TRAITS(MouseDeviceEvent,
+                    mdevice,
+                    EVENT_MOUSE_ADDED,
+                    EVENT_MOUSE_REMOVED);
+SDL3PP_EVENT_TRAITS(JoyAxisEvent, jaxis, EVENT_JOYSTICK_AXIS_MOTION);
+SDL3PP_EVENT_TRAITS(JoyBallEvent, jball, EVENT_JOYSTICK_BALL_MOTION);
+SDL3PP_EVENT_TRAITS(JoyHatEvent, jhat, EVENT_JOYSTICK_HAT_MOTION);
+SDL3PP_EVENT_TRAITS(JoyButtonEvent,
+                    jbutton,
+                    EVENT_JOYSTICK_BUTTON_DOWN,
+                    EVENT_JOYSTICK_BUTTON_UP);
+SDL3PP_EVENT_TRAITS(JoyDeviceEvent,
+                    jdevice,
+                    EVENT_JOYSTICK_ADDED,
+                    EVENT_JOYSTICK_REMOVED,
+                    EVENT_JOYSTICK_UPDATE_COMPLETE);
+SDL3PP_EVENT_TRAITS(JoyBatteryEvent, jbattery, EVENT_JOYSTICK_BATTERY_UPDATED);
+SDL3PP_EVENT_TRAITS(GamepadAxisEvent, gaxis, EVENT_GAMEPAD_AXIS_MOTION);
+SDL3PP_EVENT_TRAITS(GamepadButtonEvent,
+                    gbutton,
+                    EVENT_GAMEPAD_BUTTON_DOWN,
+                    EVENT_GAMEPAD_BUTTON_UP);
+SDL3PP_EVENT_TRAITS(GamepadDeviceEvent,
+                    gdevice,
+                    EVENT_GAMEPAD_ADDED,
+                    EVENT_GAMEPAD_REMOVED,
+                    EVENT_GAMEPAD_REMAPPED,
+                    EVENT_GAMEPAD_UPDATE_COMPLETE,
+                    EVENT_GAMEPAD_STEAM_HANDLE_UPDATED);
+SDL3PP_EVENT_TRAITS(GamepadTouchpadEvent,
+                    gtouchpad,
+                    EVENT_GAMEPAD_TOUCHPAD_DOWN,
+                    EVENT_GAMEPAD_TOUCHPAD_MOTION,
+                    EVENT_GAMEPAD_TOUCHPAD_UP);
+SDL3PP_EVENT_TRAITS(GamepadSensorEvent, gsensor, EVENT_GAMEPAD_SENSOR_UPDATE);
+SDL3PP_EVENT_TRAITS(TouchFingerEvent,
+                    tfinger,
+                    EVENT_FINGER_DOWN,
+                    EVENT_FINGER_UP,
+                    EVENT_FINGER_MOTION,
+                    EVENT_FINGER_CANCELED);
+#if SDL_VERSION_ATLEAST(3, 4, 0)
+SDL3PP_EVENT_TRAITS(PinchFingerEvent,
+                    pinch,
+                    EVENT_PINCH_BEGIN,
+                    EVENT_PINCH_UPDATE,
+                    EVENT_PINCH_END);
+#endif // SDL_VERSION_ATLEAST(3, 4, 0)
+SDL3PP_EVENT_TRAITS(ClipboardEvent, clipboard, EVENT_CLIPBOARD_UPDATE);
+SDL3PP_EVENT_TRAITS(DropEvent,
+                    drop,
+                    EVENT_DROP_FILE,
+                    EVENT_DROP_TEXT,
+                    EVENT_DROP_BEGIN,
+                    EVENT_DROP_COMPLETE,
+                    EVENT_DROP_POSITION);
+SDL3PP_EVENT_TRAITS(AudioDeviceEvent,
+                    adevice,
+                    EVENT_AUDIO_DEVICE_ADDED,
+                    EVENT_AUDIO_DEVICE_REMOVED,
+                    EVENT_AUDIO_DEVICE_FORMAT_CHANGED);
+SDL3PP_EVENT_TRAITS(SensorEvent, sensor, EVENT_SENSOR_UPDATE);
+SDL3PP_EVENT_TRAITS(PenProximityEvent,
+                    pproximity,
+                    EVENT_PEN_PROXIMITY_IN,
+                    EVENT_PEN_PROXIMITY_OUT);
+SDL3PP_EVENT_TRAITS(PenTouchEvent, ptouch, EVENT_PEN_DOWN, EVENT_PEN_UP);
+SDL3PP_EVENT_TRAITS(PenButtonEvent,
+                    pbutton,
+                    EVENT_PEN_BUTTON_DOWN,
+                    EVENT_PEN_BUTTON_UP);
+SDL3PP_EVENT_TRAITS(PenMotionEvent, pmotion, EVENT_PEN_MOTION);
+SDL3PP_EVENT_TRAITS(PenAxisEvent, paxis, EVENT_PEN_AXIS);
+SDL3PP_EVENT_TRAITS(CameraDeviceEvent,
+                    cdevice,
+                    EVENT_CAMERA_DEVICE_ADDED,
+                    EVENT_CAMERA_DEVICE_REMOVED,
+                    EVENT_CAMERA_DEVICE_APPROVED,
+                    EVENT_CAMERA_DEVICE_DENIED);
+SDL3PP_EVENT_TRAITS(RenderEvent,
+                    render,
+                    EVENT_RENDER_TARGETS_RESET,
+                    EVENT_RENDER_DEVICE_RESET,
+                    EVENT_RENDER_DEVICE_LOST);
+
+template<>
+struct EventTraits<DisplayEvent>
+{
+  static constexpr auto types =
+    detail::EventTypeRange<EVENT_DISPLAY_FIRST, EVENT_DISPLAY_LAST>();
+  static DisplayEvent& Get(Event& event) { return event.display; }
+  static const DisplayEvent& Get(const Event& event) { return event.display; }
+};
+
+template<>
+struct EventTraits<WindowEvent>
+{
+  static constexpr auto types =
+    detail::EventTypeRange<EVENT_WINDOW_FIRST, EVENT_WINDOW_LAST>();
+  static WindowEvent& Get(Event& event) { return event.window; }
+  static const WindowEvent& Get(const Event& event) { return event.window; }
+};
+
+/// UserEvent is matched by range, from EVENT_USER to EVENT_LAST.
+template<>
+struct EventTraits<UserEvent>
+{
+  static constexpr std::array<EventType, 0> types{};
+  static UserEvent& Get(Event& event) { return event.user; }
+  static const UserEvent& Get(const Event& event) { return event.user; }
+};
+
+/// Catch all, it receives every event without a more specific handler.
+template<>
+struct EventTraits<Event>
+{
+  static constexpr std::array<EventType, 0> types{};
+  static Event& Get(Event& event) { return event; }
+  static const Event& Get(const Event& event) { return event; }
+};
+
+/// Catch all, it receives every event without a more specific handler.
+template<>
+struct EventTraits<CommonEvent>
+{
+  static constexpr std::array<EventType, 0> types{};
+  static CommonEvent& Get(Event& event) { return event.common; }
+  static const CommonEvent& Get(const Event& event) { return event.common; }
+};
+/// @endcond
+
+#undef SDL3PP_EVENT_TRAITS
+
+/// @cond
+namespace detail {
+
+template<class F>
+struct HandlerSignature : HandlerSignature<decltype(&F::operator())>
+{};
+
+template<class R, class A>
+struct HandlerSignature<R (*)(A)>
+{
+  using Result = R;
+  using Param = A;
+  using Arg = std::remove_cvref_t<A>;
+};
+
+template<class R, class C, class A>
+struct HandlerSignature<R (C::*)(A)> : HandlerSignature<R (*)(A)>
+{};
+
+template<class R, class C, class A>
+struct HandlerSignature<R (C::*)(A) const> : HandlerSignature<R (*)(A)>
+{};
+
+template<class R, class C, class A>
+struct HandlerSignature<R (C::*)(A) noexcept> : HandlerSignature<R (*)(A)>
+{};
+
+template<class R, class C, class A>
+struct HandlerSignature<R (C::*)(A) const noexcept>
+  : HandlerSignature<R (*)(A)>
+{};
+
+template<class F>
+using HandlerArg = typename HandlerSignature<std::decay_t<F>>::Arg;
+
+template<class F>
+using HandlerParam = typename HandlerSignature<std::decay_t<F>>::Param;
+
+template<class F>
+using HandlerResult = typename HandlerSignature<std::decay_t<F>>::Result;
+
+} // namespace detail
+/// @endcond
+
+/**
+ * Dispatch events to handlers according to their parameter type.
+ *
+ * Each handler is a callable taking exactly one parameter, one of the event
+ * structures with an EventTraits specialization, like KeyboardEvent,
+ * MouseMotionEvent or GamepadAxisEvent, by value or reference. Handlers taking
+ * UserEvent receive all events from EVENT_USER to EVENT_LAST, and a handler
+ * taking Event or CommonEvent receives every event not matched by another
+ * handler.
+ *
+ * Two handlers can not take the same parameter type.
+ *
+ * All handlers must return the same type, which is also returned by the
+ * dispatcher. When no handler matches an event, a value initialized result is
+ * returned, so handlers returning AppResult can be used directly from
+ * AppInterface::Event():
+ *
+ * ```cpp
+ * SDL::AppResult Event(const SDL::Event& event)
+ * {
+ *   return m_dispatch(event);
+ * }
+ * ```
+ *
+ * The dispatch table has one byte per event type, up to the highest event type
+ * handled, so it is at most a few kilobytes.
+ *
+ * @tparam Handlers the handler types.
+ */
+template<class... Handlers>
+class EventDispatcher
+{
+  static_assert(sizeof...(Handlers) > 0, "At least one handler is required");
+  static_assert(sizeof...(Handlers) < 256, "Too many handlers");
+
+  using Result = std::common_type_t<detail::HandlerResult<Handlers>...>;
+  static_assert(
+    (std::is_same_v<Result, detail::HandlerResult<Handlers>> && ...),
+    "All handlers must return the same type");
+
+  template<size_t I>
+  using Arg =
+    detail::HandlerArg<std::tuple_element_t<I, std::tuple<Handlers...>>>;
+
+  using Indexes = std::index_sequence_for<Handlers...>;
+
+  static constexpr size_t NONE = 0xFF;
+
+  template<class T>
+  static constexpr size_t FindHandler()
+  {
+    size_t index = NONE;
+    size_t i = 0;
+    ((std::is_same_v<detail::HandlerArg<Handlers>, T> && index == NONE
+        ? index = i
+        : 0,
+      i++),
+     ...);
+    return index;
+  }
+
+  static constexpr size_t USER_HANDLER = FindHandler<UserEvent>();
+
+  static constexpr size_t DEFAULT_HANDLER = FindHandler<Event>() != NONE
+                                              ? FindHandler<Event>()
+                                              : FindHandler<CommonEvent>();
+
+  template<class T>
+  static constexpr bool IS_CATCH_ALL =
+    std::is_same_v<T, Event> || std::is_same_v<T, CommonEvent>;
+
+  template<size_t... I>
+  static constexpr bool IsUnique(std::index_sequence<I...>)
+  {
+    return ((FindHandler<Arg<I>>() == I) && ...) &&
+           (size_t(IS_CATCH_ALL<Arg<I>>) + ...) <= 1;
+  }
+
+  static_assert(IsUnique(Indexes{}),
+                "Each event structure can have one handler only");
+
+  static constexpr size_t TABLE_SIZE = [] {
+    size_t size = 0;
+    (
+      [&] {
+        for (EventType type : EventTraits<detail::HandlerArg<Handlers>>::types)
+          if (type >= size) size = type + 1;
+      }(),
+      ...);
+    return size;
+  }();
+
+  static constexpr std::array<Uint8, TABLE_SIZE> TABLE = [] {
+    std::array<Uint8, TABLE_SIZE> table{};
+    table.fill(NONE);
+    size_t i = 0;
+    (
+      [&] {
+        for (EventType type : EventTraits<detail::HandlerArg<Handlers>>::types)
+          table[type] = Uint8(i);
+        i++;
+      }(),
+      ...);
+    return table;
+  }();
+
+  template<size_t I>
+  using Param =
+    detail::HandlerParam<std::tuple_element_t<I, std::tuple<Handlers...>>>;
+
+  /// True if the handler I takes its event by non const reference
+  template<size_t I>
+  static constexpr bool TAKES_MUTABLE = [] {
+    using P = Param<I>;
+    return std::is_lvalue_reference_v<P> &&
+           !std::is_const_v<std::remove_reference_t<P>>;
+  }();
+
+  template<class E>
+  using Call = Result (*)(std::tuple<Handlers...>&, E&);
+
+  template<size_t I, class E>
+  static Result CallHandler(std::tuple<Handlers...>& handlers, E& event)
+  {
+    if constexpr (std::is_const_v<E> && TAKES_MUTABLE<I>) {
+      Event copy = event;
+      return std::get<I>(handlers)(EventTraits<Arg<I>>::Get(copy));
+    } else {
+      return std::get<I>(handlers)(EventTraits<Arg<I>>::Get(event));
+    }
+  }
+
+  template<class E, size_t... I>
+  static constexpr std::array<Call<E>, sizeof...(Handlers)> MakeCalls(
+    std::index_sequence<I...>)
+  {
+    return {&CallHandler<I, E>...};
+  }
+
+  template<class E>
+  static constexpr std::array<Call<E>, sizeof...(Handlers)> CALLS =
+    MakeCalls<E>(Indexes{});
+
+  static constexpr size_t FindIndex(Uint32 type)
+  {
+    size_t index = NONE;
+    if constexpr (TABLE_SIZE > 0) {
+      if (size_t(type) < TABLE.size()) index = TABLE[type];
+    }
+    if constexpr (USER_HANDLER != NONE) {
+      if (type >= EVENT_USER && type <= EVENT_LAST) index = USER_HANDLER;
+    }
+    if constexpr (DEFAULT_HANDLER != NONE) {
+      if (index == NONE) index = DEFAULT_HANDLER;
+    }
+    return index;
+  }
+
+  std::tuple<Handlers...> m_handlers;
+
+public:
+  /**
+   * Constructs from handlers.
+   *
+   * @param handlers the handlers.
+   */
+  constexpr EventDispatcher(Handlers... handlers)
+    : m_handlers(std::move(handlers)...)
+  {
+  }
+
+  /**
+   * Dispatch an event to the matching handler.
+   *
+   * @param event the event.
+   * @returns the handler result or a value initialized result if there is no
+   *          matching handler.
+   */
+  Result operator()(Event& event)
+  {
+    size_t index = FindIndex(event.type);
+    if (index == NONE) return Result();
+    return CALLS<Event>[index](m_handlers, event);
+  }
+
+  /**
+   * Dispatch an event to the matching handler.
+   *
+   * The event is only copied when the matching handler takes a non-const
+   * reference.
+   *
+   * @param event the event.
+   * @returns the handler result or a value initialized result if there is no
+   *          matching handler.
+   */
+  Result operator()(const Event& event)
+  {
+    size_t index = FindIndex(event.type);
+    if (index == NONE) return Result();
+    return CALLS<const Event>[index](m_handlers, event);
+  }
+
+  /**
+   * Dispatch a sequence of events, in order.
+   *
+   * If handlers return a non void type, this stops at the first result that is
+   * different from a value initialized one, and returns it. For AppResult this
+   * means it stops on anything other than APP_CONTINUE.
+   *
+   * @param events the events, for example an EventBatch.
+   * @returns the first non value initialized result or a value initialized one.
+   */
+  Result operator()(std::span<Event> events)
+  {
+    if constexpr (std::is_void_v<Result>) {
+      for (Event& event : events) (*this)(event);
+    } else {
+      for (Event& event : events) {
+        if (Result r = (*this)(event); r != Result()) return r;
+      }
+      return Result();
+    }
+  }
+};
+
+/// @}
+
+} // namespace SDL
+
+#endif /* SDL3PP_EVENT_DISPATCHER_H_ */
@@ -0,0 +1,335 @@
+#ifndef SDL3PP_EVENT_FILTER_CHAIN_H_
+#define SDL3PP_EVENT_FILTER_CHAIN_H_
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SDL3pp_callbackWrapper.h"
+#include "SDL3pp_events.h"
+#include "SDL3pp_timer.h"
+
+namespace SDL {
+
+/**
+ * @defgroup CategoryEventFilterChain Event filter chain
+ *
+ * Multiple prioritized event filters.
+ *
+ * SDL has a single event filter slot, set with SetEventFilter().
+ * EventFilterChain takes that slot and runs any number of filters from it,
+ * ordered by priority. Filters can be added and removed at any time from any
+ * thread, while the event thread keeps reading the chain without locking.
+ *
+ * ```cpp
+ * SDL::EventFilterChain filters;
+ * auto id = filters.Add(
+ *   [](SDL::Event* event) { return event->type != SDL::EVENT_MOUSE_WHEEL; },
+ *   100,
+ *   "no wheel");
+ * // ...
+ * for (auto& stats : filters.GetStats()) {
+ *   SDL::Log("%s: %" SDL_PRIu64 " ns", stats.name.c_str(), stats.totalNS);
+ * }
+ * filters.Remove(id);
+ * ```
+ *
+ * @{
+ */
+
+/// Identifies a filter on an EventFilterChain. Zero is never a valid id.
+using EventFilterID = Uint32;
+
+/**
+ * Filter function stored on EventFilterChain.
+ *
+ * It is stored inline, so adding a filter never allocates for it, and calling
+ * it has no std::function overhead.
+ *
+ * @param event the event being queued, it can be modified.
+ * @returns true to let the event go on, false to drop it.
+ */
+using EventFilterFunction = InplaceFunction<bool(Event* event)>;
+
+/**
+ * Counters of one filter in an EventFilterChain.
+ *
+ * @sa EventFilterChain.GetStats
+ */
+struct EventFilterStats
+{
+  /// The filter id
+  EventFilterID id;
+
+  /// The filter name, as given to EventFilterChain.Add()
+  std::string name;
+
+  /// The filter priority
+  int priority;
+
+  /// Number of events the filter was called with
+  Uint64 calls;
+
+  /// Number of events the filter dropped
+  Uint64 dropped;
+
+  /// Total time spent on the filter, in nanoseconds
+  Uint64 totalNS;
+
+  /// Longest single call, in nanoseconds
+  Uint64 maxNS;
+};
+
+/**
+ * Ordered chain of event filters.
+ *
+ * Constructing it installs it with SetEventFilter(). A filter already set is
+ * kept and added to the chain as the "previous filter", with priority 0.
+ * Destroying the chain restores it.
+ *
+ * Filters with higher priority run first, ties run in the order they were
+ * added. An event stops going through the chain as soon as one filter returns
+ * false.
+ *
+ * Filtering reads an immutable snapshot of the chain, so it never locks nor
+ * allocates. Adding or removing filters builds a new snapshot; older ones are
+ * released once no event is being filtered.
+ *
+ * @threadsafety It is safe to call all member functions from any thread,
+ *               including from inside a filter.
+ */
+class EventFilterChain
+{
+  struct Entry
+  {
+    EventFilterID id;
+    int priority;
+    std::string name;
+    EventFilterFunction function;
+    std::atomic<Uint64> calls{0};
+    std::atomic<Uint64> dropped{0};
+    std::atomic<Uint64> totalNS{0};
+    std::atomic<Uint64> maxNS{0};
+  };
+
+  struct Snapshot
+  {
+    std::vector<Entry*> entries;
+  };
+
+  std::mutex m_mutex;
+  std::atomic<Snapshot*> m_current;
+  std::atomic<int> m_readers{0};
+  std::atomic<bool> m_timing{true};
+  std::vector<std::unique_ptr<Entry>> m_entries;
+  std::vector<std::unique_ptr<Snapshot>> m_retiredSnapshots;
+  std::vector<std::unique_ptr<Entry>> m_retiredEntries;
+  EventFilterID m_nextID = 1;
+  EventFilter m_previousFilter = nullptr;
+  void* m_previousUserdata = nullptr;
+
+public:
+  /// Install the chain.
+  EventFilterChain()
+    : m_current(new Snapshot)
+  {
+    if (GetEventFilter(&m_previousFilter, &m_previousUserdata) &&
+        m_previousFilter) {
+      Add(m_previousFilter, m_previousUserdata, 0, "previous filter");
+    }
+    SetEventFilter(&EventFilterChain::Filter, this);
+  }
+
+  EventFilterChain(const EventFilterChain&) = delete;
+  EventFilterChain& operator=(const EventFilterChain&) = delete;
+
+  /// Restore the previous filter.
+  ~EventFilterChain()
+  {
+    SetEventFilter(m_previousFilter, m_previousUserdata);
+
+    // Calls entered before the restore may still run on other threads
+    while (m_readers.load() != 0) std::this_thread::yield();
+    delete m_current.load();
+  }
+
+  /**
+   * Add a filter.
+   *
+   * @param filter the filter function.
+   * @param priority filters with higher priority run first.
+   * @param name a name to identify the filter on GetStats().
+   * @returns the id to remove the filter later.
+   */
+  EventFilterID Add(EventFilterFunction filter,
+                    int priority = 0,
+                    std::string_view name = {})
+  {
+    auto entry = std::make_unique<Entry>();
+    entry->priority = priority;
+    entry->name = name;
+    entry->function = std::move(filter);
+
+    std::lock_guard lock{m_mutex};
+    entry->id = m_nextID++;
+    auto it = std::upper_bound(
+      m_entries.begin(), m_entries.end(), priority, [](int p, auto& e) {
+        return p > e->priority;
+      });
+    EventFilterID id = entry->id;
+    m_entries.insert(it, std::move(entry));
+    Publish();
+    return id;
+  }
+
+  /**
+   * Add a C filter.
+   *
+   * @param filter the filter function.
+   * @param userdata a pointer that is passed to `filter`.
+   * @param priority filters with higher priority run first.
+   * @param name a name to identify the filter on GetStats().
+   * @returns the id to remove the filter later.
+   */
+  EventFilterID Add(EventFilter filter,
+                    void* userdata,
+                    int priority = 0,
+                    std::string_view name = {})
+  {
+    return Add(
+      [filter, userdata](Event* event) { return filter(userdata, event); },
+      priority,
+      name);
+  }
+
+  /**
+   * Remove a filter.
+   *
+   * After this returns the filter is not called for new events, but it might
+   * still be running for an event being filtered on another thread.
+   *
+   * @param id the id returned by Add().
+   * @returns true if it was found and removed.
+   */
+  bool Remove(EventFilterID id)
+  {
+    std::lock_guard lock{m_mutex};
+    auto it = std::find_if(m_entries.begin(),
+                           m_entries.end(),
+                           [id](auto& entry) { return entry->id == id; });
+    if (it == m_entries.end()) return false;
+    m_retiredEntries.push_back(std::move(*it));
+    m_entries.erase(it);
+    Publish();
+    return true;
+  }
+
+  /**
+   * Enable or disable timing filters.
+   *
+   * Timing costs two GetTicksNS() calls per filter and event. The call and
+   * drop counters are always updated.
+   *
+   * @param enabled true to enable, it is enabled by default.
+   */
+  void SetTimingEnabled(bool enabled) { m_timing.store(enabled); }
+
+  /**
+   * Get the counters of all filters, in the order they run.
+   *
+   * @returns the counters.
+   */
+  std::vector<EventFilterStats> GetStats()
+  {
+    std::lock_guard lock{m_mutex};
+    std::vector<EventFilterStats> stats;
+    stats.reserve(m_entries.size());
+    for (auto& entry : m_entries) {
+      stats.push_back({entry->id,
+                       entry->name,
+                       entry->priority,
+                       entry->calls.load(std::memory_order_relaxed),
+                       entry->dropped.load(std::memory_order_relaxed),
+                       entry->totalNS.load(std::memory_order_relaxed),
+                       entry->maxNS.load(std::memory_order_relaxed)});
+    }
+    return stats;
+  }
+
+  /// Reset the counters of all filters.
+  void ResetStats()
+  {
+    std::lock_guard lock{m_mutex};
+    for (auto& entry : m_entries) {
+      entry->calls.store(0, std::memory_order_relaxed);
+      entry->dropped.store(0, std::memory_order_relaxed);
+      entry->totalNS.store(0, std::memory_order_relaxed);
+      entry->maxNS.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * Run the chain on an event.
+   *
+   * This is what the installed SDL event filter calls.
+   *
+   * @param event the event.
+   * @returns true if all filters let the event go on.
+   */
+  bool operator()(Event* event)
+  {
+    m_readers.fetch_add(1);
+    bool timing = m_timing.load(std::memory_order_relaxed);
+    bool result = true;
+    for (Entry* entry : m_current.load()->entries) {
+      entry->calls.fetch_add(1, std::memory_order_relaxed);
+      Uint64 start = timing ? GetTicksNS() : 0;
+      result = entry->function(event);
+      if (timing) {
+        Uint64 elapsed = GetTicksNS() - start;
+        entry->totalNS.fetch_add(elapsed, std::memory_order_relaxed);
+        Uint64 max = entry->maxNS.load(std::memory_order_relaxed);
+        while (elapsed > max &&
+               !entry->maxNS.compare_exchange_weak(
+                 max, elapsed, std::memory_order_relaxed)) {
+        }
+      }
+      if (!result) {
+        entry->dropped.fetch_add(1, std::memory_order_relaxed);
+        break;
+      }
+    }
+    m_readers.fetch_sub(1);
+    return result;
+  }
+
+private:
+  /// Must be called with m_mutex locked
+  void Publish()
+  {
+    auto snapshot = std::make_unique<Snapshot>();
+    snapshot->entries.reserve(m_entries.size());
+    for (auto& entry : m_entries) snapshot->entries.push_back(entry.get());
+    m_retiredSnapshots.emplace_back(m_current.exchange(snapshot.release()));
+
+    // Any reader that started after the exchange uses the new snapshot
+    if (m_readers.load() == 0) {
+      m_retiredSnapshots.clear();
+      m_retiredEntries.clear();
+    }
+  }
+
+  static bool SDLCALL Filter(void* userdata, Event* event)
+  {
+    return (*static_cast<EventFilterChain*>(userdata))(event);
+  }
+};
+
+/// @}
+
+} // namespace SDL
+
+#endif /* SDL3PP_EVENT_FILTER_CHAIN_H_ */
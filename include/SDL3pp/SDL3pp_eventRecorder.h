@@ -0,0 +1,617 @@
+#ifndef SDL3PP_EVENT_RECORDER_H_
+#define SDL3PP_EVENT_RECORDER_H_
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include "SDL3pp_eventDispatcher.h"
+#include "SDL3pp_events.h"
+#include "SDL3pp_iostream.h"
+#include "SDL3pp_joystick.h"
+#include "SDL3pp_timer.h"
+
+namespace SDL {
+
+/**
+ * @defgroup CategoryEventRecorder Event recording
+ *
+ * Capture events into a binary stream and replay them later.
+ *
+ * EventRecorder watches the event queue and writes every queued event, with
+ * the time it was queued, into an IOStream. EventPlayer reads it back and
+ * pushes the events again, either following the recorded timing or one frame
+ * at a time, as fast as possible.
+ *
+ * ```cpp
+ * // Recording session
+ * SDL::IOStream file = SDL::IOStream::FromFile("input.events", "wb");
+ * SDL::EventRecorder recorder{file};
+ * while (running) {
+ *   recorder.MarkFrame();
+ *   // poll and handle events, render...
+ * }
+ *
+ * // Replay, for example with SDL_VIDEO_DRIVER=dummy
+ * SDL::IOStream file = SDL::IOStream::FromFile("input.events", "rb");
+ * SDL::EventPlayer player{file, SDL::PLAYBACK_FRAME_STEP};
+ * while (!player.IsDone()) {
+ *   player.Update();
+ *   // poll and handle events, render...
+ * }
+ * ```
+ *
+ * The format stores events in their native layout, so recordings can only be
+ * replayed on the same platform and SDL version they were made with. Strings
+ * carried by text input, text editing and drop events are stored with the
+ * event. Other pointers, like UserEvent data1 and data2, are stored as they
+ * are and are most likely meaningless on replay.
+ *
+ * @{
+ */
+
+/**
+ * How EventPlayer paces the events.
+ *
+ * @sa EventPlayer
+ */
+enum EventPlaybackMode
+{
+  /// Push events following the recorded timestamps.
+  PLAYBACK_REALTIME,
+
+  /// Push the events of one recorded frame on each EventPlayer.Update().
+  PLAYBACK_FRAME_STEP,
+};
+
+/// @cond
+namespace detail {
+
+/// Magic bytes at the start of a recording.
+constexpr char EVENT_RECORDING_MAGIC[8] =
+  {'S', 'D', 'L', '3', 'E', 'V', 'T', 0};
+
+/// Recording format version.
+constexpr Uint32 EVENT_RECORDING_VERSION = 1;
+
+/// Record type marking the start of a frame.
+constexpr Uint32 EVENT_RECORDING_FRAME = EVENT_FIRST;
+
+/// Null string length.
+constexpr Uint32 EVENT_RECORDING_NULL = 0xFFFFFFFF;
+
+template<class... EVENTS>
+struct EventPayloadSizes
+{
+  static size_t Get(Uint32 type)
+  {
+    if (type >= EVENT_USER) return sizeof(UserEvent);
+    size_t size = sizeof(Event);
+    (void)((std::ranges::find(EventTraits<EVENTS>::types, type) !=
+                std::end(EventTraits<EVENTS>::types) &&
+              (size = sizeof(EVENTS), true)) ||
+           ...);
+    return size;
+  }
+};
+
+/// Size of the meaningful part of an event of the given type.
+inline size_t EventPayloadSize(Uint32 type)
+{
+  return EventPayloadSizes<QuitEvent,
+                           DisplayEvent,
+                           WindowEvent,
+                           KeyboardEvent,
+                           TextEditingEvent,
+                           TextInputEvent,
+                           KeyboardDeviceEvent,
+                           TextEditingCandidatesEvent,
+                           MouseMotionEvent,
+                           MouseButtonEvent,
+                           MouseWheelEvent,
+                           MouseDeviceEvent,
+                           JoyAxisEvent,
+                           JoyBallEvent,
+                           JoyHatEvent,
+                           JoyButtonEvent,
+                           JoyDeviceEvent,
+                           JoyBatteryEvent,
+                           GamepadAxisEvent,
+                           GamepadButtonEvent,
+                           GamepadDeviceEvent,
+                           GamepadTouchpadEvent,
+                           GamepadSensorEvent,
+                           TouchFingerEvent,
+                           ClipboardEvent,
+                           DropEvent,
+                           AudioDeviceEvent,
+                           SensorEvent,
+                           PenProximityEvent,
+                           PenTouchEvent,
+                           PenButtonEvent,
+                           PenMotionEvent,
+                           PenAxisEvent,
+                           CameraDeviceEvent,
+                           RenderEvent>::Get(type);
+}
+
+/// The string fields of an event, which are stored after its payload.
+inline std::array<const char**, 2> EventStringFields(Event& event)
+{
+  switch (event.type) {
+  case EVENT_TEXT_INPUT: return {&event.text.text, nullptr};
+  case EVENT_TEXT_EDITING: return {&event.edit.text, nullptr};
+  case EVENT_DROP_FILE:
+  case EVENT_DROP_TEXT:
+  case EVENT_DROP_BEGIN:
+  case EVENT_DROP_COMPLETE:
+  case EVENT_DROP_POSITION: return {&event.drop.source, &event.drop.data};
+  default: return {nullptr, nullptr};
+  }
+}
+
+/// Clear the pointers that can not be restored on replay.
+inline void ClearEventPointers(Event& event)
+{
+  switch (event.type) {
+  case EVENT_TEXT_EDITING_CANDIDATES:
+    event.edit_candidates.candidates = nullptr;
+    event.edit_candidates.num_candidates = 0;
+    break;
+  case EVENT_CLIPBOARD_UPDATE:
+    event.clipboard.mime_types = nullptr;
+    event.clipboard.num_mime_types = 0;
+    break;
+  default: break;
+  }
+}
+
+} // namespace detail
+/// @endcond
+
+/**
+ * Record queued events into a binary stream.
+ *
+ * Constructing it adds an event watch, so every event added to the queue from
+ * then on is recorded, together with the time elapsed since the recorder was
+ * created, taken from GetTicksNS(). Events are buffered in memory and written
+ * to the stream by Flush(), by MarkFrame() when the buffer is big enough and
+ * on destruction.
+ *
+ * @threadsafety Events are recorded from whatever thread pushes them. The
+ *               member functions can be called from any thread.
+ *
+ * @sa EventPlayer
+ */
+class EventRecorder
+{
+  IOStreamRef m_stream;
+  Uint64 m_start;
+  std::mutex m_mutex;
+  std::vector<Uint8> m_buffer;
+  Uint64 m_eventCount = 0;
+  Uint64 m_frameCount = 0;
+
+public:
+  /// MarkFrame() flushes the buffer once it has at least this many bytes.
+  static constexpr size_t FLUSH_THRESHOLD = 64 * 1024;
+
+  /**
+   * Start recording.
+   *
+   * @param stream the stream to write to. It must outlive the recorder.
+   * @throws Error on failure.
+   */
+  EventRecorder(IOStreamRef stream)
+    : m_stream(stream)
+    , m_start(GetTicksNS())
+  {
+    m_buffer.insert(m_buffer.end(),
+                    std::begin(detail::EVENT_RECORDING_MAGIC),
+                    std::end(detail::EVENT_RECORDING_MAGIC));
+    Put<Uint32>(detail::EVENT_RECORDING_VERSION);
+    Put<Uint32>(sizeof(Event));
+    AddEventWatch(&EventRecorder::Watch, this);
+  }
+
+  EventRecorder(const EventRecorder&) = delete;
+  EventRecorder& operator=(const EventRecorder&) = delete;
+
+  /// Stop recording and flush what is pending, ignoring errors.
+  ~EventRecorder()
+  {
+    RemoveEventWatch(&EventRecorder::Watch, this);
+    try {
+      Flush();
+    } catch (...) {
+    }
+  }
+
+  /**
+   * Record an event.
+   *
+   * This is called automatically for every queued event, use it only for
+   * events that are not going through the queue.
+   *
+   * @param event the event.
+   */
+  void Record(const Event& event)
+  {
+    Event copy;
+    size_t size = detail::EventPayloadSize(event.type);
+    SDL_memcpy(&copy, &event, size);
+    auto fields = detail::EventStringFields(copy);
+    Uint8 stringCount = fields[1] ? 2 : fields[0] ? 1 : 0;
+
+    std::lock_guard lock{m_mutex};
+    PutHeader(event.type, size, stringCount);
+    auto bytes = reinterpret_cast<const Uint8*>(&copy);
+    m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+    for (Uint8 i = 0; i < stringCount; i++) {
+      const char* str = *fields[i];
+      if (!str) {
+        Put<Uint32>(detail::EVENT_RECORDING_NULL);
+        continue;
+      }
+      size_t length = SDL_strlen(str);
+      Put<Uint32>(Uint32(length));
+      m_buffer.insert(m_buffer.end(), str, str + length);
+    }
+    m_eventCount++;
+  }
+
+  /**
+   * Mark the start of a frame.
+   *
+   * Frame marks are used by PLAYBACK_FRAME_STEP to push the events of each
+   * frame together. Call it once per frame, right before polling events.
+   *
+   * @throws Error if the buffer needed to be flushed and that failed.
+   */
+  void MarkFrame()
+  {
+    std::unique_lock lock{m_mutex};
+    PutHeader(detail::EVENT_RECORDING_FRAME, 0, 0);
+    m_frameCount++;
+    if (m_buffer.size() < FLUSH_THRESHOLD) return;
+    lock.unlock();
+    Flush();
+  }
+
+  /**
+   * Write all buffered data to the stream.
+   *
+   * @throws Error on failure.
+   */
+  void Flush()
+  {
+    std::lock_guard lock{m_mutex};
+    if (m_buffer.empty()) return;
+    if (WriteIO(m_stream, m_buffer) != m_buffer.size()) throw Error();
+    m_buffer.clear();
+  }
+
+  /// Number of events recorded so far.
+  Uint64 GetEventCount()
+  {
+    std::lock_guard lock{m_mutex};
+    return m_eventCount;
+  }
+
+  /// Number of frames marked so far.
+  Uint64 GetFrameCount()
+  {
+    std::lock_guard lock{m_mutex};
+    return m_frameCount;
+  }
+
+private:
+  template<class T>
+  void Put(T value)
+  {
+    for (size_t i = 0; i < sizeof(T); i++) {
+      m_buffer.push_back(Uint8(Uint64(value) >> (8 * i)));
+    }
+  }
+
+  void PutHeader(Uint32 type, size_t size, Uint8 stringCount)
+  {
+    Put<Uint64>(GetTicksNS() - m_start);
+    Put<Uint32>(type);
+    Put<Uint16>(Uint16(size));
+    Put<Uint8>(stringCount);
+    Put<Uint8>(0);
+  }
+
+  static bool SDLCALL Watch(void* userdata, Event* event)
+  {
+    try {
+      static_cast<EventRecorder*>(userdata)->Record(*event);
+    } catch (...) {
+    }
+    return true;
+  }
+};
+
+/**
+ * Replay events recorded by EventRecorder.
+ *
+ * The whole recording is read on construction. Each call to Update() pushes
+ * the events that are due with PushEvent(), according to the
+ * EventPlaybackMode.
+ *
+ * If virtual joysticks are enabled, joystick input is not pushed as events;
+ * instead a virtual joystick is attached for each recorded joystick and its
+ * axes, buttons and hats are updated, so SDL generates the joystick and
+ * gamepad events and the joystick state queries return the recorded values.
+ * This requires the joystick subsystem to be initialized.
+ *
+ * @sa EventRecorder
+ */
+class EventPlayer
+{
+  struct Record
+  {
+    Uint64 time;
+    Event event;
+  };
+
+  struct VirtualJoystick
+  {
+    JoystickIDRaw recordedID;
+    JoystickID id;
+    Joystick joystick;
+  };
+
+  EventPlaybackMode m_mode;
+  bool m_virtualJoysticks;
+  std::vector<Record> m_records;
+  std::deque<std::string> m_strings;
+  std::vector<VirtualJoystick> m_joysticks;
+  size_t m_next = 0;
+  Uint64 m_start = 0;
+
+public:
+  /// Number of axes of each virtual joystick
+  static constexpr int VIRTUAL_AXES = 8;
+
+  /// Number of buttons of each virtual joystick
+  static constexpr int VIRTUAL_BUTTONS = 32;
+
+  /// Number of hats of each virtual joystick
+  static constexpr int VIRTUAL_HATS = 4;
+
+  /**
+   * Load a recording.
+   *
+   * @param stream the stream to read from.
+   * @param mode how to pace the events.
+   * @param virtualJoysticks true to replay joystick input through virtual
+   *                         joysticks.
+   * @throws Error if the stream can not be read or is not a valid recording.
+   */
+  EventPlayer(IOStreamRef stream,
+              EventPlaybackMode mode = PLAYBACK_FRAME_STEP,
+              bool virtualJoysticks = false)
+    : m_mode(mode)
+    , m_virtualJoysticks(virtualJoysticks)
+  {
+    Parse(LoadFile_IO(stream, false));
+    Restart();
+  }
+
+  EventPlayer(const EventPlayer&) = delete;
+  EventPlayer& operator=(const EventPlayer&) = delete;
+
+  /// Detach virtual joysticks
+  ~EventPlayer() { DetachJoysticks(); }
+
+  /// Rewind to the start of the recording, resetting the clock.
+  void Restart()
+  {
+    DetachJoysticks();
+    m_next = 0;
+    m_start = GetTicksNS();
+  }
+
+  /**
+   * Push the events that are due.
+   *
+   * On PLAYBACK_REALTIME these are all events recorded before the time elapsed
+   * since construction or Restart(). On PLAYBACK_FRAME_STEP these are all
+   * events up to the next frame mark.
+   *
+   * @returns the number of records replayed.
+   * @throws Error if a virtual joystick could not be attached or updated.
+   */
+  size_t Update()
+  {
+    size_t count = 0;
+    if (m_mode == PLAYBACK_REALTIME) {
+      Uint64 now = GetTicksNS() - m_start;
+      while (m_next < m_records.size() && m_records[m_next].time <= now) {
+        if (!IsFrameMark(m_next)) {
+          Replay(m_records[m_next].event);
+          count++;
+        }
+        m_next++;
+      }
+      return count;
+    }
+    if (m_next < m_records.size() && IsFrameMark(m_next)) m_next++;
+    while (m_next < m_records.size() && !IsFrameMark(m_next)) {
+      Replay(m_records[m_next++].event);
+      count++;
+    }
+    return count;
+  }
+
+  /// True if all records were replayed.
+  bool IsDone() const { return m_next >= m_records.size(); }
+
+  /// Number of records, including frame marks.
+  size_t GetRecordCount() const { return m_records.size(); }
+
+  /// Time of the last record, in nanoseconds since the recording start.
+  Uint64 GetDuration() const
+  {
+    return m_records.empty() ? 0 : m_records.back().time;
+  }
+
+private:
+  void Parse(const StringResult& data)
+  {
+    auto bytes = reinterpret_cast<const Uint8*>(data.data());
+    size_t size = data.size();
+    size_t pos = 0;
+    auto get = [&]<class T>(T& value) {
+      if (size - pos < sizeof(T)) return false;
+      Uint64 v = 0;
+      for (size_t i = 0; i < sizeof(T); i++) {
+        v |= Uint64(bytes[pos++]) << (8 * i);
+      }
+      value = T(v);
+      return true;
+    };
+    auto fail = [] {
+      SetError("Invalid event recording");
+      throw Error();
+    };
+
+    if (size < sizeof(detail::EVENT_RECORDING_MAGIC) ||
+        SDL_memcmp(bytes,
+                   detail::EVENT_RECORDING_MAGIC,
+                   sizeof(detail::EVENT_RECORDING_MAGIC)) != 0) {
+      fail();
+    }
+    pos = sizeof(detail::EVENT_RECORDING_MAGIC);
+    Uint32 version = 0, eventSize = 0;
+    if (!get(version) || !get(eventSize) ||
+        version != detail::EVENT_RECORDING_VERSION ||
+        eventSize != sizeof(Event)) {
+      fail();
+    }
+    while (pos < size) {
+      Record record{};
+      Uint32 type;
+      Uint16 payloadSize;
+      Uint8 stringCount, reserved;
+      if (!get(record.time) || !get(type) || !get(payloadSize) ||
+          !get(stringCount) || !get(reserved) ||
+          payloadSize > sizeof(Event) || size - pos < payloadSize) {
+        fail();
+      }
+      SDL_memcpy(&record.event, bytes + pos, payloadSize);
+      pos += payloadSize;
+      record.event.type = type;
+      auto fields = detail::EventStringFields(record.event);
+      for (Uint8 i = 0; i < stringCount; i++) {
+        Uint32 length;
+        if (!get(length)) fail();
+        const char* str = nullptr;
+        if (length != detail::EVENT_RECORDING_NULL) {
+          if (size - pos < length) fail();
+          str = m_strings
+                  .emplace_back(reinterpret_cast<const char*>(bytes + pos),
+                                length)
+                  .c_str();
+          pos += length;
+        }
+        if (i < fields.size() && fields[i]) *fields[i] = str;
+      }
+      detail::ClearEventPointers(record.event);
+      m_records.push_back(record);
+    }
+  }
+
+  bool IsFrameMark(size_t index) const
+  {
+    return m_records[index].event.type == detail::EVENT_RECORDING_FRAME;
+  }
+
+  void Replay(const Event& recorded)
+  {
+    Event event = recorded;
+    if (m_virtualJoysticks && event.type >= EVENT_JOYSTICK_AXIS_MOTION &&
+        event.type < EVENT_FINGER_DOWN) {
+      ReplayJoystick(event);
+      return;
+    }
+    event.common.timestamp = 0;
+    SDL_PushEvent(&event);
+  }
+
+  VirtualJoystick* FindJoystick(JoystickIDRaw recordedID)
+  {
+    for (auto& joystick : m_joysticks) {
+      if (joystick.recordedID == recordedID) return &joystick;
+    }
+    return nullptr;
+  }
+
+  void ReplayJoystick(const Event& event)
+  {
+    switch (event.type) {
+    case EVENT_JOYSTICK_ADDED: {
+      if (FindJoystick(event.jdevice.which)) return;
+      VirtualJoystickDesc desc;
+      InitInterface(&desc);
+      desc.type = JOYSTICK_TYPE_GAMEPAD;
+      desc.naxes = VIRTUAL_AXES;
+      desc.nbuttons = VIRTUAL_BUTTONS;
+      desc.nhats = VIRTUAL_HATS;
+      desc.name = "SDL3pp replayed joystick";
+      JoystickID id = AttachVirtualJoystick(desc);
+      m_joysticks.push_back({event.jdevice.which, id, Joystick(id)});
+      break;
+    }
+    case EVENT_JOYSTICK_REMOVED:
+      for (auto it = m_joysticks.begin(); it != m_joysticks.end(); ++it) {
+        if (it->recordedID != event.jdevice.which) continue;
+        JoystickID id = it->id;
+        m_joysticks.erase(it);
+        DetachVirtualJoystick(id);
+        break;
+      }
+      break;
+    case EVENT_JOYSTICK_AXIS_MOTION:
+      if (auto j = FindJoystick(event.jaxis.which);
+          j && event.jaxis.axis < VIRTUAL_AXES) {
+        j->joystick.SetVirtualAxis(event.jaxis.axis, event.jaxis.value);
+      }
+      break;
+    case EVENT_JOYSTICK_BUTTON_DOWN:
+    case EVENT_JOYSTICK_BUTTON_UP:
+      if (auto j = FindJoystick(event.jbutton.which);
+          j && event.jbutton.button < VIRTUAL_BUTTONS) {
+        j->joystick.SetVirtualButton(event.jbutton.button, event.jbutton.down);
+      }
+      break;
+    case EVENT_JOYSTICK_HAT_MOTION:
+      if (auto j = FindJoystick(event.jhat.which);
+          j && event.jhat.hat < VIRTUAL_HATS) {
+        j->joystick.SetVirtualHat(event.jhat.hat, event.jhat.value);
+      }
+      break;
+    default:
+      // Everything else is generated by SDL from the virtual joysticks
+      break;
+    }
+  }
+
+  void DetachJoysticks()
+  {
+    while (!m_joysticks.empty()) {
+      JoystickID id = m_joysticks.back().id;
+      m_joysticks.pop_back();
+      SDL_DetachVirtualJoystick(id);
+    }
+  }
+};
+
+/// @}
+
+} // namespace SDL
+
+#endif /* SDL3PP_EVENT_RECORDER_H_ */
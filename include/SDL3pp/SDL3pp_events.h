@@ -1,6 +1,8 @@
 #ifndef SDL3PP_EVENTS_H_
 #define SDL3PP_EVENTS_H_
 
+#include <span>
+#include <vector>
 #include <SDL3/SDL_events.h>
 #include "SDL3pp_stdinc.h"
 #include "SDL3pp_video.h"
@@ -1139,6 +1141,142 @@ inline std::optional<Event> PollEvent()
   return std::nullopt;
 }
 
+/**
+ * Poll for currently pending events, in a batch.
+ *
+ * Up to `events.size()` events are removed from the queue and stored in
+ * `events`. This pumps the events once and locks the queue once for the whole
+ * batch, instead of once per event as in PollEvent(), which is much cheaper
+ * when there are many queued events, like with high rate mouse or pen input.
+ *
+ * As this function calls PumpEvents(), you can only call this function in the
+ * thread that initialized the video subsystem.
+ *
+ * ```cpp
+ * std::array<SDL::Event, 64> buffer;
+ * for (auto& event : SDL::PollEvents(buffer)) {
+ *   // decide what to do with this event.
+ * }
+ * ```
+ *
+ * @param events the buffer to be filled with events from the queue.
+ * @param minType minimum value of the event type to be considered; EVENT_FIRST
+ *                is a safe choice.
+ * @param maxType maximum value of the event type to be considered; EVENT_LAST
+ *                is a safe choice.
+ * @returns the leading part of `events` that was filled, empty if there are no
+ *          events available.
+ * @throws Error on failure.
+ *
+ * @threadsafety This function should only be called on the main thread.
+ *
+ * @sa EventBatch
+ * @sa PeepEvents
+ * @sa PollEvent
+ */
+inline std::span<Event> PollEvents(std::span<Event> events,
+                                   Uint32 minType = EVENT_FIRST,
+                                   Uint32 maxType = EVENT_LAST)
+{
+  PumpEvents();
+  int count =
+    PeepEvents(events.data(), int(events.size()), GETEVENT, minType, maxType);
+  CheckError(count >= 0);
+  return events.first(count);
+}
+
+/**
+ * Reusable buffer to drain the event queue in batches.
+ *
+ * Each call to Poll() replaces its content with the next batch of events and
+ * the events can be then iterated with range-for:
+ *
+ * ```cpp
+ * SDL::EventBatch batch;
+ * while (game_is_still_running) {
+ *   while (batch.Poll()) { // poll until all events are handled!
+ *     for (SDL::Event& event : batch) {
+ *       // decide what to do with this event.
+ *     }
+ *   }
+ *
+ *   // update game state, draw the current frame
+ * }
+ * ```
+ *
+ * @sa PollEvents
+ */
+class EventBatch
+{
+  std::vector<Event> m_buffer;
+  size_t m_size = 0;
+
+public:
+  /// Default batch capacity
+  static constexpr size_t DEFAULT_CAPACITY = 128;
+
+  /**
+   * Construct an empty batch.
+   *
+   * @param capacity the maximum number of events retrieved by each Poll().
+   */
+  explicit EventBatch(size_t capacity = DEFAULT_CAPACITY)
+    : m_buffer(capacity > 0 ? capacity : 1)
+  {
+  }
+
+  /**
+   * Replace the content with the next events from the queue.
+   *
+   * @param minType minimum value of the event type to be considered;
+   *                EVENT_FIRST is a safe choice.
+   * @param maxType maximum value of the event type to be considered;
+   *                EVENT_LAST is a safe choice.
+   * @returns true if this got any event or false if there are none available.
+   * @throws Error on failure.
+   *
+   * @threadsafety This function should only be called on the main thread.
+   */
+  bool Poll(Uint32 minType = EVENT_FIRST, Uint32 maxType = EVENT_LAST)
+  {
+    m_size = PollEvents(m_buffer, minType, maxType).size();
+    return m_size > 0;
+  }
+
+  /// Remove all events from the batch, keeping the buffer.
+  void clear() { m_size = 0; }
+
+  /// Number of events in the batch.
+  size_t size() const { return m_size; }
+
+  /// True if the batch has no events.
+  bool empty() const { return m_size == 0; }
+
+  /// Maximum number of events retrieved by each Poll().
+  size_t capacity() const { return m_buffer.size(); }
+
+  /// Get the event at `index`.
+  Event& operator[](size_t index) { return m_buffer[index]; }
+
+  /// Get the event at `index`.
+  const Event& operator[](size_t index) const { return m_buffer[index]; }
+
+  /// Iterator to the first event.
+  Event* begin() { return m_buffer.data(); }
+
+  /// Iterator to the first event.
+  const Event* begin() const { return m_buffer.data(); }
+
+  /// Iterator past the last event.
+  Event* end() { return m_buffer.data() + m_size; }
+
+  /// Iterator past the last event.
+  const Event* end() const { return m_buffer.data() + m_size; }
+
+  /// Convert to span.
+  operator std::span<Event>() { return {begin(), end()}; }
+};
+
 /**
  * Wait indefinitely for the next available event.
  *
@@ -1520,6 +1658,9 @@ inline void SetEventFilter(EventFilter filter, void* userdata)
  * Note: Events pushed onto the queue with PushEvent() get passed through the
  * event filter, but events pushed onto the queue with PeepEvents() do not.
  *
+ * There is a single filter slot, so setting a filter replaces any previous one.
+ * Use EventFilterChain to have multiple filters.
+ *
  * @param filter a function to call when an event happens.
  *
  * @threadsafety It is safe to call this function from any thread.
@@ -1529,6 +1670,7 @@ inline void SetEventFilter(EventFilter filter, void* userdata)
  * @cat listener-callback
  *
  * @sa AddEventWatch
+ * @sa EventFilterChain
  * @sa SetEventEnabled
  * @sa GetEventFilter
  * @sa PeepEvents
@@ -0,0 +1,439 @@
+#ifndef SDL3PP_FRAME_ALLOCATOR_H_
+#define SDL3PP_FRAME_ALLOCATOR_H_
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <utility>
+#include "SDL3pp_stdinc.h"
+
+namespace SDL {
+
+/**
+ * @defgroup CategoryFrameAllocator Frame allocator
+ *
+ * Arena and pool based memory backend for SDL.
+ *
+ * FrameAllocator is installed through SetMemoryFunctions() and serves every
+ * SDL allocation from one of three places:
+ *
+ * - A bump arena, for allocations done by the frame thread while a frame is
+ *   open, see FrameScope. Allocating is just moving a pointer forward and the
+ *   whole arena is rewound when the next frame starts;
+ * - Size class pools, for other small allocations. Freed blocks are kept in
+ *   free lists for reuse;
+ * - The previous malloc function, for everything else.
+ *
+ * ```cpp
+ * class Main : public SDL::AppInterface
+ * {
+ *   SDL::FrameAllocator m_allocator; // ideally created before anything else
+ *
+ *   SDL::AppResult Iterate() override
+ *   {
+ *     SDL::FrameScope frame{m_allocator};
+ *     auto files = SDL::GlobDirectory("assets", "*.png"); // from the arena
+ *     // ...
+ *     return SDL::APP_CONTINUE;
+ *   }
+ * };
+ * ```
+ *
+ * Arena blocks are reference counted per arena chunk, so blocks that are still
+ * alive when the frame ends are never overwritten: the chunk is just retired
+ * and a new one is used for the next frame. The retired chunk is released when
+ * its last block is freed. Keeping long lived objects allocated during a frame
+ * is safe, but it pins their whole chunk.
+ *
+ * @{
+ */
+
+/**
+ * Statistics of a FrameAllocator.
+ *
+ * @sa FrameAllocator.GetStats
+ */
+struct FrameAllocatorStats
+{
+  /// Blocks served from the arena
+  Uint64 arenaAllocations = 0;
+
+  /// Blocks served from size class pools
+  Uint64 poolAllocations = 0;
+
+  /// Blocks served by the previous malloc function
+  Uint64 fallbackAllocations = 0;
+
+  /// Arena allocations that did not fit and went to the pools or fallback
+  Uint64 arenaOverflows = 0;
+
+  /// Frames started
+  Uint64 frames = 0;
+
+  /// Frames that could not rewind the arena because it had live blocks
+  Uint64 retiredChunks = 0;
+
+  /// Bytes used on the current arena chunk
+  size_t arenaUsed = 0;
+};
+
+/**
+ * Arena and size class pool memory functions for SDL.
+ *
+ * Constructing it installs it with SetMemoryFunctions() and destroying it
+ * restores the previous functions. Only one can be installed at a time.
+ *
+ * Each block has a 16 bytes header describing where it came from, so like
+ * SetMemoryFunctions() itself, it must be installed before SDL allocates
+ * anything, and nothing allocated while it was installed can be freed after it
+ * is destroyed. Pools and arena chunks are never returned to the system while
+ * it is installed.
+ *
+ * @threadsafety Allocation and free functions can be called from any thread.
+ *               Constructing and destroying follows the same rules as
+ *               SetMemoryFunctions().
+ *
+ * @sa FrameScope
+ */
+class FrameAllocator
+{
+public:
+  /// Size, in bytes, of the largest block served by size class pools
+  static constexpr size_t MAX_POOLED_SIZE = 512;
+
+  /// Default arena size
+  static constexpr size_t DEFAULT_ARENA_SIZE = 1 << 20;
+
+  /**
+   * Install the allocator.
+   *
+   * @param arenaSize the size of each arena chunk, in bytes.
+   * @throws Error if there is already a FrameAllocator installed or on
+   *         failure.
+   */
+  FrameAllocator(size_t arenaSize = DEFAULT_ARENA_SIZE)
+    : m_arenaSize(AlignUp(arenaSize))
+  {
+    FrameAllocator* expected = nullptr;
+    if (!s_instance.compare_exchange_strong(expected, this)) {
+      SetError("FrameAllocator already installed");
+      throw Error();
+    }
+    GetMemoryFunctions(&m_malloc, &m_calloc, &m_realloc, &m_free);
+    m_chunk = NewChunk();
+    if (!m_chunk ||
+        !SDL_SetMemoryFunctions(Malloc, Calloc, Realloc, Free)) {
+      if (m_chunk) m_free(m_chunk);
+      s_instance.store(nullptr);
+      if (!m_chunk) SetError("Out of memory");
+      throw Error();
+    }
+  }
+
+  FrameAllocator(const FrameAllocator&) = delete;
+  FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+  /// Restore previous memory functions.
+  ~FrameAllocator()
+  {
+    SDL_SetMemoryFunctions(m_malloc, m_calloc, m_realloc, m_free);
+    s_instance.store(nullptr);
+    ReleaseChunk(m_chunk);
+    for (auto& pool : m_pools) {
+      while (pool.slabs) {
+        auto next = *static_cast<void**>(pool.slabs);
+        m_free(pool.slabs);
+        pool.slabs = next;
+      }
+    }
+  }
+
+  /**
+   * Start a frame on the current thread.
+   *
+   * Rewind the arena if all blocks from previous frame were freed, otherwise
+   * retire the current chunk and start a new one. Until EndFrame() is called,
+   * allocations from this thread are served from the arena.
+   *
+   * Prefer using FrameScope.
+   */
+  void BeginFrame()
+  {
+    m_frames.fetch_add(1, std::memory_order_relaxed);
+    // Only this thread adds blocks to the chunk, so if our own reference is
+    // the only one left, nobody else can touch it anymore.
+    if (m_chunk->live.load(std::memory_order_acquire) == 1) {
+      m_chunk->used = 0;
+    } else if (auto chunk = NewChunk()) {
+      m_retiredChunks.fetch_add(1, std::memory_order_relaxed);
+      ReleaseChunk(std::exchange(m_chunk, chunk));
+    } else {
+      // Out of memory, keep the old chunk, and let it overflow
+      m_chunk->used = m_chunk->capacity;
+    }
+    m_arenaUsed.store(m_chunk->used, std::memory_order_relaxed);
+    s_frameAllocator = this;
+  }
+
+  /// End the frame started by BeginFrame() on this thread.
+  void EndFrame() { s_frameAllocator = nullptr; }
+
+  /**
+   * Get a snapshot of the allocator statistics.
+   *
+   * @returns the statistics.
+   */
+  FrameAllocatorStats GetStats() const
+  {
+    FrameAllocatorStats r;
+    r.arenaAllocations = m_arenaAllocations.load();
+    r.poolAllocations = m_poolAllocations.load();
+    r.fallbackAllocations = m_fallbackAllocations.load();
+    r.arenaOverflows = m_arenaOverflows.load();
+    r.frames = m_frames.load();
+    r.retiredChunks = m_retiredChunks.load();
+    r.arenaUsed = m_arenaUsed.load();
+    return r;
+  }
+
+private:
+  static constexpr size_t ALIGNMENT = 16;
+  static constexpr size_t POOL_COUNT = 6; // 16, 32, 64, 128, 256 and 512
+  static constexpr size_t SLAB_SIZE = 64 * 1024;
+
+  enum BlockKind : size_t
+  {
+    BLOCK_ARENA,
+    BLOCK_POOL,
+    BLOCK_FALLBACK,
+  };
+
+  struct Chunk
+  {
+    std::atomic<size_t> live; ///< live blocks + 1 while it is the current
+    size_t used;
+    size_t capacity;
+    FrameAllocator* owner;
+  };
+
+  /// Precedes every block, keeping 16 bytes alignment
+  struct alignas(ALIGNMENT) Header
+  {
+    void* source; ///< Chunk* or pool index, depending on kind
+    size_t kindAndSize;
+  };
+  static_assert(sizeof(Header) == ALIGNMENT);
+
+  struct Pool
+  {
+    std::mutex lock;
+    void* freeList = nullptr;
+    void* slabs = nullptr;
+  };
+
+  static inline std::atomic<FrameAllocator*> s_instance{nullptr};
+  static inline thread_local FrameAllocator* s_frameAllocator = nullptr;
+
+  malloc_func m_malloc;
+  calloc_func m_calloc;
+  realloc_func m_realloc;
+  free_func m_free;
+  size_t m_arenaSize;
+  Chunk* m_chunk = nullptr;
+  std::array<Pool, POOL_COUNT> m_pools;
+  std::atomic<Uint64> m_arenaAllocations{0};
+  std::atomic<Uint64> m_poolAllocations{0};
+  std::atomic<Uint64> m_fallbackAllocations{0};
+  std::atomic<Uint64> m_arenaOverflows{0};
+  std::atomic<Uint64> m_frames{0};
+  std::atomic<Uint64> m_retiredChunks{0};
+  std::atomic<size_t> m_arenaUsed{0}; ///< Copy of m_chunk->used for GetStats()
+
+  static constexpr size_t AlignUp(size_t size)
+  {
+    return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+  }
+
+  static constexpr size_t PoolIndex(size_t size)
+  {
+    size_t index = 0;
+    for (size_t classSize = 16; classSize < size; classSize *= 2) index++;
+    return index;
+  }
+
+  static constexpr size_t PoolBlockSize(size_t index)
+  {
+    return sizeof(Header) + (size_t(16) << index);
+  }
+
+  static Header* HeaderOf(void* mem) { return static_cast<Header*>(mem) - 1; }
+
+  static void* Init(Header* header, BlockKind kind, void* source, size_t size)
+  {
+    header->source = source;
+    header->kindAndSize = (size << 2) | kind;
+    return header + 1;
+  }
+
+  Chunk* NewChunk()
+  {
+    auto mem = m_malloc(AlignUp(sizeof(Chunk)) + m_arenaSize);
+    if (!mem) return nullptr;
+    return ::new (mem) Chunk{{1}, 0, m_arenaSize, this};
+  }
+
+  void ReleaseChunk(Chunk* chunk)
+  {
+    if (chunk->live.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      chunk->~Chunk();
+      m_free(chunk);
+    }
+  }
+
+  void* AllocateArena(size_t size)
+  {
+    auto chunk = m_chunk;
+    size_t blockSize = sizeof(Header) + AlignUp(size);
+    if (chunk->used + blockSize > chunk->capacity) {
+      m_arenaOverflows.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    auto base = reinterpret_cast<std::byte*>(chunk) + AlignUp(sizeof(Chunk));
+    auto header = reinterpret_cast<Header*>(base + chunk->used);
+    chunk->used += blockSize;
+    m_arenaUsed.store(chunk->used, std::memory_order_relaxed);
+    chunk->live.fetch_add(1, std::memory_order_relaxed);
+    m_arenaAllocations.fetch_add(1, std::memory_order_relaxed);
+    return Init(header, BLOCK_ARENA, chunk, size);
+  }
+
+  void* AllocatePool(size_t size)
+  {
+    size_t index = PoolIndex(size);
+    auto& pool = m_pools[index];
+    std::lock_guard guard{pool.lock};
+    if (!pool.freeList) {
+      // Carve a new slab. Its first bytes link to the previous slab.
+      auto slab = static_cast<std::byte*>(m_malloc(SLAB_SIZE));
+      if (!slab) return nullptr;
+      *reinterpret_cast<void**>(slab) = pool.slabs;
+      pool.slabs = slab;
+      size_t blockSize = PoolBlockSize(index);
+      for (size_t offset = ALIGNMENT; offset + blockSize <= SLAB_SIZE;
+           offset += blockSize) {
+        auto block = slab + offset;
+        *reinterpret_cast<void**>(block) = pool.freeList;
+        pool.freeList = block;
+      }
+    }
+    auto header = static_cast<Header*>(pool.freeList);
+    pool.freeList = *reinterpret_cast<void**>(header);
+    m_poolAllocations.fetch_add(1, std::memory_order_relaxed);
+    return Init(header, BLOCK_POOL, reinterpret_cast<void*>(index), size);
+  }
+
+  void* AllocateFallback(size_t size)
+  {
+    auto header = static_cast<Header*>(m_malloc(sizeof(Header) + size));
+    if (!header) return nullptr;
+    m_fallbackAllocations.fetch_add(1, std::memory_order_relaxed);
+    return Init(header, BLOCK_FALLBACK, nullptr, size);
+  }
+
+  void* Allocate(size_t size)
+  {
+    if (s_frameAllocator == this) {
+      if (void* mem = AllocateArena(size)) return mem;
+    }
+    if (size <= MAX_POOLED_SIZE) {
+      if (void* mem = AllocatePool(size)) return mem;
+    }
+    return AllocateFallback(size);
+  }
+
+  void Deallocate(void* mem)
+  {
+    auto header = HeaderOf(mem);
+    switch (BlockKind(header->kindAndSize & 3)) {
+    case BLOCK_ARENA: ReleaseChunk(static_cast<Chunk*>(header->source)); break;
+    case BLOCK_POOL: {
+      auto& pool = m_pools[reinterpret_cast<size_t>(header->source)];
+      std::lock_guard guard{pool.lock};
+      *reinterpret_cast<void**>(header) = pool.freeList;
+      pool.freeList = header;
+      break;
+    }
+    case BLOCK_FALLBACK: m_free(header); break;
+    }
+  }
+
+  static void* SDLCALL Malloc(size_t size)
+  {
+    return s_instance.load(std::memory_order_acquire)->Allocate(size);
+  }
+
+  static void* SDLCALL Calloc(size_t nmemb, size_t size)
+  {
+    size_t total = nmemb * size;
+    if (size != 0 && total / size != nmemb) return nullptr;
+    void* mem = Malloc(total);
+    if (mem) SDL_memset(mem, 0, total);
+    return mem;
+  }
+
+  static void* SDLCALL Realloc(void* mem, size_t size)
+  {
+    if (!mem) return Malloc(size);
+    auto header = HeaderOf(mem);
+    size_t oldSize = header->kindAndSize >> 2;
+    if (BlockKind(header->kindAndSize & 3) == BLOCK_POOL &&
+        size <= PoolBlockSize(reinterpret_cast<size_t>(header->source)) -
+                  sizeof(Header)) {
+      header->kindAndSize = (size << 2) | BLOCK_POOL;
+      return mem;
+    }
+    void* newMem = Malloc(size);
+    if (!newMem) return nullptr;
+    SDL_memcpy(newMem, mem, oldSize < size ? oldSize : size);
+    Free(mem);
+    return newMem;
+  }
+
+  static void SDLCALL Free(void* mem)
+  {
+    if (mem) s_instance.load(std::memory_order_acquire)->Deallocate(mem);
+  }
+
+  friend class FrameScope;
+};
+
+/**
+ * Scope of a frame for FrameAllocator.
+ *
+ * Calls FrameAllocator.BeginFrame() on construction and
+ * FrameAllocator.EndFrame() on destruction.
+ */
+class FrameScope
+{
+  FrameAllocator& m_allocator;
+
+public:
+  /// Begin the frame
+  FrameScope(FrameAllocator& allocator)
+    : m_allocator(allocator)
+  {
+    m_allocator.BeginFrame();
+  }
+
+  FrameScope(const FrameScope&) = delete;
+  FrameScope& operator=(const FrameScope&) = delete;
+
+  /// End the frame
+  ~FrameScope() { m_allocator.EndFrame(); }
+};
+
+/// @}
+
+} // namespace SDL
+
+#endif /* SDL3PP_FRAME_ALLOCATOR_H_ */
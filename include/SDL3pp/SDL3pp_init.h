@@ -441,6 +441,42 @@ inline void RunOnMainThread(MainThreadCB callback, bool wait_complete)
   RunOnMainThread(&Wrapper::CallOnce, wrapped, wait_complete);
 }
 
+/**
+ * Call a function on the main thread during event processing.
+ *
+ * If this is called on the main thread, the callback is executed immediately.
+ * If this is called on another thread, this callback is queued for execution on
+ * the main thread during event processing.
+ *
+ * Unlike RunOnMainThread(MainThreadCB, bool), the callback is kept in a
+ * preallocated slot, so no heap allocation happens as long as there are less
+ * than CallbackWrapper::POOL_SIZE callbacks pending.
+ *
+ * Be careful of deadlocks when using this functionality. You should not have
+ * the main thread wait for the current thread while this function is being
+ * called with `wait_complete` true.
+ *
+ * @param callback the callback to call on the main thread.
+ * @param wait_complete true to wait for the callback to complete, false to
+ *                      return immediately.
+ * @throws Error on failure.
+ *
+ * @threadsafety It is safe to call this function from any thread.
+ *
+ * @sa IsMainThread
+ * @sa result-callback
+ *
+ * @cat result-callback
+ */
+template<size_t SIZE>
+inline void RunOnMainThread(InplaceFunction<void(), SIZE> callback,
+                            bool wait_complete)
+{
+  using Wrapper = CallbackWrapper<InplaceFunction<void(), SIZE>>;
+  void* wrapped = Wrapper::Wrap(std::move(callback));
+  RunOnMainThread(&Wrapper::CallOnce, wrapped, wait_complete);
+}
+
 /**
  * Specify basic metadata about your app.
  *
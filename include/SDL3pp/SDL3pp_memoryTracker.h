@@ -0,0 +1,467 @@
+#ifndef SDL3PP_MEMORY_TRACKER_H_
+#define SDL3PP_MEMORY_TRACKER_H_
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <thread>
+#include "SDL3pp_stdinc.h"
+
+namespace SDL {
+
+/**
+ * @defgroup CategoryMemoryTracker Memory tracking
+ *
+ * Instrumentation of the memory SDL allocates.
+ *
+ * MemoryTracker installs hooks with SetMemoryFunctions() that forward every
+ * call to the previous set of memory functions while recording statistics
+ * about it. Everything allocated through SDL_malloc(), SDL_calloc(),
+ * SDL_realloc() and released with SDL_free() is accounted for, including all
+ * memory owned by OwnPtr, OwnArray and StringResult.
+ *
+ * ```cpp
+ * SDL::MemoryTracker tracker;
+ * // ...
+ * SDL::MemoryProbe probe;
+ * renderFrame();
+ * SDL_assert(probe.GetStats().allocations == 0);
+ * ```
+ *
+ * The tracker does not change the returned pointers, so it can be installed
+ * and removed at any time, even after SDL allocated memory. Blocks allocated
+ * before it was installed are simply not accounted for when freed.
+ *
+ * @{
+ */
+
+/// The memory functions a MemoryStats keeps count of
+enum MemoryCall
+{
+  MEMORY_CALL_MALLOC,  ///< SDL_malloc()
+  MEMORY_CALL_CALLOC,  ///< SDL_calloc()
+  MEMORY_CALL_REALLOC, ///< SDL_realloc()
+  MEMORY_CALL_FREE,    ///< SDL_free()
+  MEMORY_CALL_COUNT    ///< Number of functions
+};
+
+/**
+ * Snapshot of memory statistics.
+ *
+ * Obtained from MemoryTracker.GetStats() or MemoryProbe.GetStats().
+ */
+struct MemoryStats
+{
+  /// Number of buckets in histogram
+  static constexpr size_t HISTOGRAM_SIZE = 32;
+
+  /// Number of calls for each of the memory functions, indexed by MemoryCall
+  std::array<Uint64, MEMORY_CALL_COUNT> calls{};
+
+  /// Number of blocks returned by malloc, calloc or realloc
+  Uint64 allocations = 0;
+
+  /// Number of tracked blocks released, by free or realloc
+  Uint64 deallocations = 0;
+
+  /// Total of bytes requested
+  Uint64 bytesAllocated = 0;
+
+  /// Total of bytes released
+  Uint64 bytesFreed = 0;
+
+  /// Bytes currently in use
+  Sint64 liveBytes = 0;
+
+  /// Highest value liveBytes reached
+  Sint64 peakBytes = 0;
+
+  /**
+   * Blocks whose size could not be accounted for.
+   *
+   * Either the tracker capacity was saturated or a freed block was allocated
+   * before the tracker was installed.
+   */
+  Uint64 untracked = 0;
+
+  /**
+   * Number of requests by size.
+   *
+   * Bucket `i` counts requests with `std::bit_width(size) == i`, that is sizes
+   * in range `[2^(i-1), 2^i)`, with the last bucket getting everything larger.
+   */
+  std::array<Uint64, HISTOGRAM_SIZE> histogram{};
+
+  /// Blocks currently in use
+  constexpr Sint64 GetLiveAllocations() const
+  {
+    return Sint64(allocations) - Sint64(deallocations);
+  }
+
+  /**
+   * Difference between two snapshots.
+   *
+   * Counters are subtracted, liveBytes becomes the net change and peakBytes is
+   * kept from this snapshot.
+   */
+  constexpr MemoryStats operator-(const MemoryStats& other) const
+  {
+    MemoryStats r = *this;
+    for (size_t i = 0; i < r.calls.size(); i++) r.calls[i] -= other.calls[i];
+    for (size_t i = 0; i < r.histogram.size(); i++) {
+      r.histogram[i] -= other.histogram[i];
+    }
+    r.allocations -= other.allocations;
+    r.deallocations -= other.deallocations;
+    r.bytesAllocated -= other.bytesAllocated;
+    r.bytesFreed -= other.bytesFreed;
+    r.liveBytes -= other.liveBytes;
+    r.untracked -= other.untracked;
+    return r;
+  }
+};
+
+/**
+ * Records statistics for all memory SDL allocates.
+ *
+ * Constructing it installs hooks through SetMemoryFunctions() and destroying it
+ * restores the functions that were in place before. Only one tracker can be
+ * installed at a time.
+ *
+ * The size of each live block is kept in a fixed capacity lock-free table,
+ * allocated with the previous malloc function. When the table is saturated new
+ * blocks are still served, but counted as MemoryStats.untracked.
+ *
+ * @threadsafety The hooks are safe to be called from any thread. Constructing
+ *               and destroying the tracker follow the same rules as
+ *               SetMemoryFunctions().
+ *
+ * @sa MemoryProbe
+ */
+class MemoryTracker
+{
+  struct Entry
+  {
+    std::atomic<uintptr_t> ptr;
+    std::atomic<size_t> size;
+  };
+
+  static constexpr uintptr_t EMPTY = 0;
+  static constexpr uintptr_t TOMBSTONE = 1;
+  static constexpr size_t MAX_PROBE = 64;
+
+  struct State
+  {
+    malloc_func malloc;
+    calloc_func calloc;
+    realloc_func realloc;
+    free_func free;
+    Entry* entries;
+    size_t mask;
+
+    std::array<std::atomic<Uint64>, MEMORY_CALL_COUNT> calls;
+    std::atomic<Uint64> allocations;
+    std::atomic<Uint64> deallocations;
+    std::atomic<Uint64> bytesAllocated;
+    std::atomic<Uint64> bytesFreed;
+    std::atomic<Sint64> liveBytes;
+    std::atomic<Sint64> peakBytes;
+    std::atomic<Uint64> untracked;
+    std::array<std::atomic<Uint64>, MemoryStats::HISTOGRAM_SIZE> histogram;
+  };
+
+  static inline std::atomic<State*> s_state{nullptr};
+  static inline State s_storage{};
+  static inline std::atomic<int> s_activeCalls{0};
+
+  /// Keeps the state alive while a hook uses it, see ~MemoryTracker()
+  struct ActiveCall
+  {
+    State* state;
+
+    ActiveCall()
+    {
+      s_activeCalls.fetch_add(1);
+      state = s_state.load();
+    }
+
+    ~ActiveCall() { s_activeCalls.fetch_sub(1); }
+  };
+
+  static size_t Hash(uintptr_t ptr, size_t mask)
+  {
+    // Fibonacci hashing, dropping the low bits that are always 0 due alignment
+    return size_t((Uint64(ptr >> 4) * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+  }
+
+  static void Track(State& s, void* mem, size_t size)
+  {
+    auto ptr = uintptr_t(mem);
+    s.allocations.fetch_add(1, std::memory_order_relaxed);
+    s.bytesAllocated.fetch_add(size, std::memory_order_relaxed);
+    auto bucket = std::min<size_t>(std::bit_width(size),
+                                   MemoryStats::HISTOGRAM_SIZE - 1);
+    s.histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+
+    for (size_t i = 0, h = Hash(ptr, s.mask); i < MAX_PROBE; i++) {
+      auto& entry = s.entries[(h + i) & s.mask];
+      uintptr_t current = entry.ptr.load(std::memory_order_relaxed);
+      if (current != EMPTY && current != TOMBSTONE) continue;
+      if (!entry.ptr.compare_exchange_strong(current, ptr)) continue;
+      // Nobody can free mem before we return it, so it's safe to set it now
+      entry.size.store(size, std::memory_order_relaxed);
+      auto live = s.liveBytes.fetch_add(Sint64(size)) + Sint64(size);
+      auto peak = s.peakBytes.load(std::memory_order_relaxed);
+      while (live > peak && !s.peakBytes.compare_exchange_weak(peak, live)) {}
+      return;
+    }
+    s.untracked.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  static void Untrack(State& s, void* mem)
+  {
+    auto ptr = uintptr_t(mem);
+    for (size_t i = 0, h = Hash(ptr, s.mask); i < MAX_PROBE; i++) {
+      auto& entry = s.entries[(h + i) & s.mask];
+      uintptr_t current = entry.ptr.load(std::memory_order_acquire);
+      if (current == EMPTY) break;
+      if (current != ptr) continue;
+      auto size = entry.size.load(std::memory_order_relaxed);
+      entry.ptr.store(TOMBSTONE, std::memory_order_release);
+      s.deallocations.fetch_add(1, std::memory_order_relaxed);
+      s.bytesFreed.fetch_add(size, std::memory_order_relaxed);
+      s.liveBytes.fetch_sub(Sint64(size));
+      return;
+    }
+    s.untracked.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  static void* SDLCALL Malloc(size_t size)
+  {
+    ActiveCall call;
+    if (!call.state) return s_storage.malloc(size);
+    auto& s = *call.state;
+    s.calls[MEMORY_CALL_MALLOC].fetch_add(1, std::memory_order_relaxed);
+    void* mem = s.malloc(size);
+    if (mem) Track(s, mem, size);
+    return mem;
+  }
+
+  static void* SDLCALL Calloc(size_t nmemb, size_t size)
+  {
+    ActiveCall call;
+    if (!call.state) return s_storage.calloc(nmemb, size);
+    auto& s = *call.state;
+    s.calls[MEMORY_CALL_CALLOC].fetch_add(1, std::memory_order_relaxed);
+    void* mem = s.calloc(nmemb, size);
+    if (mem) Track(s, mem, nmemb * size);
+    return mem;
+  }
+
+  static void* SDLCALL Realloc(void* mem, size_t size)
+  {
+    ActiveCall call;
+    if (!call.state) return s_storage.realloc(mem, size);
+    auto& s = *call.state;
+    s.calls[MEMORY_CALL_REALLOC].fetch_add(1, std::memory_order_relaxed);
+    void* newMem = s.realloc(mem, size);
+    if (!newMem) return newMem;
+    if (mem) Untrack(s, mem);
+    Track(s, newMem, size);
+    return newMem;
+  }
+
+  static void SDLCALL Free(void* mem)
+  {
+    ActiveCall call;
+    if (!call.state) {
+      s_storage.free(mem);
+      return;
+    }
+    auto& s = *call.state;
+    s.calls[MEMORY_CALL_FREE].fetch_add(1, std::memory_order_relaxed);
+    if (mem) Untrack(s, mem);
+    s.free(mem);
+  }
+
+public:
+  /// Default capacity for the live blocks table
+  static constexpr size_t DEFAULT_CAPACITY = 1 << 16;
+
+  /**
+   * Install the tracking hooks.
+   *
+   * All statistics start zeroed.
+   *
+   * @param capacity the maximum number of live blocks whose size is tracked.
+   *                 It is rounded up to a power of two.
+   * @throws Error if there is a tracker already installed or on failure.
+   */
+  MemoryTracker(size_t capacity = DEFAULT_CAPACITY)
+  {
+    State* expected = nullptr;
+    if (!s_state.compare_exchange_strong(expected, &s_storage)) {
+      SetError("MemoryTracker already installed");
+      throw Error();
+    }
+    auto& s = s_storage;
+    GetMemoryFunctions(&s.malloc, &s.calloc, &s.realloc, &s.free);
+    s.mask = std::bit_ceil(std::max<size_t>(capacity, MAX_PROBE)) - 1;
+    s.entries = static_cast<Entry*>(s.malloc((s.mask + 1) * sizeof(Entry)));
+    if (s.entries) std::uninitialized_value_construct_n(s.entries, s.mask + 1);
+    ResetStats();
+    if (!s.entries || !SDL_SetMemoryFunctions(Malloc, Calloc, Realloc, Free)) {
+      if (s.entries) s.free(s.entries);
+      s_state.store(nullptr);
+      if (!s.entries) SetError("Out of memory");
+      throw Error();
+    }
+  }
+
+  MemoryTracker(const MemoryTracker&) = delete;
+  MemoryTracker& operator=(const MemoryTracker&) = delete;
+
+  /**
+   * Restore the previous memory functions.
+   *
+   * Blocks allocated while the tracker was installed remain valid, as the
+   * tracker never changes the pointers returned by the underlying functions.
+   */
+  ~MemoryTracker()
+  {
+    auto& s = s_storage;
+    SDL_SetMemoryFunctions(s.malloc, s.calloc, s.realloc, s.free);
+    // Hooks entered before the restore may still run on other threads. Make
+    // them bypass the state, then wait for them before freeing the table.
+    s_state.store(nullptr);
+    while (s_activeCalls.load() != 0) std::this_thread::yield();
+    s.free(s.entries);
+    s.entries = nullptr;
+  }
+
+  /// True if there is a MemoryTracker installed
+  static bool IsInstalled()
+  {
+    return s_state.load(std::memory_order_acquire) != nullptr;
+  }
+
+  /**
+   * Get a snapshot of the current statistics.
+   *
+   * Each field is read atomically, but the snapshot as a whole is not, so
+   * values may be slightly inconsistent if other threads are allocating.
+   *
+   * @returns the statistics, all zeroes if no tracker is installed.
+   */
+  static MemoryStats GetStats()
+  {
+    MemoryStats r;
+    auto state = s_state.load(std::memory_order_acquire);
+    if (!state) return r;
+    auto& s = *state;
+    for (size_t i = 0; i < r.calls.size(); i++) r.calls[i] = s.calls[i].load();
+    for (size_t i = 0; i < r.histogram.size(); i++) {
+      r.histogram[i] = s.histogram[i].load();
+    }
+    r.allocations = s.allocations.load();
+    r.deallocations = s.deallocations.load();
+    r.bytesAllocated = s.bytesAllocated.load();
+    r.bytesFreed = s.bytesFreed.load();
+    r.liveBytes = s.liveBytes.load();
+    r.peakBytes = s.peakBytes.load();
+    r.untracked = s.untracked.load();
+    return r;
+  }
+
+  /**
+   * Reset peakBytes to the current liveBytes.
+   *
+   * Useful to measure the peak of each frame.
+   */
+  static void ResetPeak()
+  {
+    if (auto state = s_state.load(std::memory_order_acquire)) {
+      state->peakBytes.store(state->liveBytes.load());
+    }
+  }
+
+private:
+  static void ResetStats()
+  {
+    auto& s = s_storage;
+    for (auto& c : s.calls) c.store(0);
+    for (auto& c : s.histogram) c.store(0);
+    s.allocations.store(0);
+    s.deallocations.store(0);
+    s.bytesAllocated.store(0);
+    s.bytesFreed.store(0);
+    s.liveBytes.store(0);
+    s.peakBytes.store(0);
+    s.untracked.store(0);
+  }
+};
+
+/**
+ * Scoped probe of the allocations done during a block.
+ *
+ * It takes a snapshot of MemoryTracker.GetStats() on construction and
+ * GetStats() returns what happened since then. A MemoryTracker must be
+ * installed for it to record anything.
+ *
+ * ```cpp
+ * SDL::MemoryProbe probe;
+ * SDL::SetHint(SDL::HINT_RENDER_VSYNC, "1");
+ * CHECK(probe.GetAllocations() == 0);
+ * ```
+ */
+class MemoryProbe
+{
+  MemoryStats m_start;
+
+public:
+  /// Start probing.
+  MemoryProbe()
+    : m_start(MemoryTracker::GetStats())
+  {
+    MemoryTracker::ResetPeak();
+  }
+
+  /**
+   * Get statistics since this probe was constructed or last reset.
+   *
+   * Peak is relative to the live bytes at the moment the probe started. As
+   * there is a single peak counter, starting another probe resets it.
+   */
+  MemoryStats GetStats() const
+  {
+    auto r = MemoryTracker::GetStats() - m_start;
+    r.peakBytes -= m_start.liveBytes;
+    return r;
+  }
+
+  /// Number of blocks allocated since the probe started.
+  Uint64 GetAllocations() const
+  {
+    return MemoryTracker::GetStats().allocations - m_start.allocations;
+  }
+
+  /// Net bytes allocated since the probe started.
+  Sint64 GetLiveBytes() const
+  {
+    return MemoryTracker::GetStats().liveBytes - m_start.liveBytes;
+  }
+
+  /// Restart probing from now.
+  void Reset()
+  {
+    m_start = MemoryTracker::GetStats();
+    MemoryTracker::ResetPeak();
+  }
+};
+
+/// @}
+
+} // namespace SDL
+
+#endif /* SDL3PP_MEMORY_TRACKER_H_ */
@@ -0,0 +1,286 @@
+#ifndef SDL3PP_MOTION_COALESCER_H_
+#define SDL3PP_MOTION_COALESCER_H_
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <span>
+#include "SDL3pp_events.h"
+
+namespace SDL {
+
+/**
+ * @defgroup CategoryMotionCoalescer Motion coalescing
+ *
+ * Merge consecutive mouse and pen motion events.
+ *
+ * High polling rate mice and pens can push hundreds of motion events per
+ * frame. MotionCoalescer installs an event filter that keeps, for each device
+ * and window, a single motion event on the queue: following motion events are
+ * dropped and folded into it instead, accumulating relative motion and keeping
+ * the latest position, button state and timestamp.
+ *
+ * The folded values are written to the queued event when it is retrieved, by
+ * calling MotionCoalescer.Resolve() on it:
+ *
+ * ```cpp
+ * SDL::MotionCoalescer coalescer;
+ * SDL::EventBatch batch;
+ * while (batch.Poll()) {
+ *   coalescer.Resolve(batch);
+ *   for (auto& event : batch) {
+ *     // ...
+ *   }
+ * }
+ * ```
+ *
+ * Any other event closes every pending motion, so the next motion event is
+ * queued after it, preserving the order of motion relative to button, wheel,
+ * touch and all other events.
+ *
+ * @{
+ */
+
+/**
+ * Counters of a MotionCoalescer.
+ *
+ * @sa MotionCoalescer.GetStats
+ */
+struct MotionCoalescerStats
+{
+  /// Mouse motion events queued
+  Uint64 mouseMotions = 0;
+
+  /// Mouse motion events folded into a queued one
+  Uint64 mouseFolded = 0;
+
+  /// Pen motion events queued
+  Uint64 penMotions = 0;
+
+  /// Pen motion events folded into a queued one
+  Uint64 penFolded = 0;
+};
+
+/**
+ * Event filter that coalesces mouse and pen motion events.
+ *
+ * Constructing it installs it with SetEventFilter(), chaining any previously
+ * set filter, which is called first. Destroying it restores the previous
+ * filter.
+ *
+ * Every retrieved event must be passed through Resolve(), otherwise the
+ * queued motion events only have the values of the first motion folded into
+ * them.
+ *
+ * @threadsafety Resolve() can be called from any thread, but usually it is
+ *               called on the main thread, where events are polled.
+ */
+class MotionCoalescer
+{
+public:
+  /// Maximum number of motion events being folded at the same time.
+  static constexpr size_t MAX_PENDING = 16;
+
+  /// Install the filter.
+  MotionCoalescer()
+  {
+    if (!GetEventFilter(&m_previousFilter, &m_previousUserdata)) {
+      m_previousFilter = nullptr;
+      m_previousUserdata = nullptr;
+    }
+    SetEventFilter(&MotionCoalescer::Filter, this);
+  }
+
+  MotionCoalescer(const MotionCoalescer&) = delete;
+  MotionCoalescer& operator=(const MotionCoalescer&) = delete;
+
+  /// Restore the previous filter.
+  ~MotionCoalescer() { SetEventFilter(m_previousFilter, m_previousUserdata); }
+
+  /**
+   * Write the folded values into a retrieved motion event.
+   *
+   * Events other than motion events queued by this coalescer are left
+   * untouched.
+   *
+   * @param event the event retrieved from the queue.
+   */
+  void Resolve(Event& event)
+  {
+    if (event.type != EVENT_MOUSE_MOTION && event.type != EVENT_PEN_MOTION) {
+      return;
+    }
+    if ((event.common.reserved & ~MARK_MASK) != MARK) return;
+    size_t index = event.common.reserved & MARK_MASK;
+    event.common.reserved = 0;
+    if (index >= MAX_PENDING) return;
+
+    std::lock_guard lock{m_mutex};
+    Pending& pending = m_pending[index];
+    if (!pending.used) return;
+    if (event.type == EVENT_MOUSE_MOTION) {
+      event.motion.timestamp = pending.timestamp;
+      event.motion.state = pending.state;
+      event.motion.x = pending.x;
+      event.motion.y = pending.y;
+      event.motion.xrel = pending.xrel;
+      event.motion.yrel = pending.yrel;
+    } else {
+      event.pmotion.timestamp = pending.timestamp;
+      event.pmotion.pen_state = pending.state;
+      event.pmotion.x = pending.x;
+      event.pmotion.y = pending.y;
+    }
+    pending.used = false;
+    pending.open = false;
+  }
+
+  /**
+   * Write the folded values into a sequence of retrieved events.
+   *
+   * @param events the events, for example an EventBatch.
+   */
+  void Resolve(std::span<Event> events)
+  {
+    for (Event& event : events) Resolve(event);
+  }
+
+  /**
+   * Forget all pending motions.
+   *
+   * Use it after flushing the event queue, otherwise the slots for motion
+   * events that were flushed are never released.
+   */
+  void Reset()
+  {
+    std::lock_guard lock{m_mutex};
+    for (Pending& pending : m_pending) pending = {};
+  }
+
+  /**
+   * Get the counters.
+   *
+   * @returns a snapshot of the counters.
+   */
+  MotionCoalescerStats GetStats() const
+  {
+    return {
+      m_mouseMotions.load(std::memory_order_relaxed),
+      m_mouseFolded.load(std::memory_order_relaxed),
+      m_penMotions.load(std::memory_order_relaxed),
+      m_penFolded.load(std::memory_order_relaxed),
+    };
+  }
+
+private:
+  static constexpr Uint32 MARK = 0x4D4F0000; // 'MO' on the upper bits
+  static constexpr Uint32 MARK_MASK = 0xFFFF;
+
+  struct Pending
+  {
+    bool used = false; ///< There is a queued event waiting for Resolve()
+    bool open = false; ///< New motion can still be folded into it
+    Uint32 type = 0;
+    Uint32 windowID = 0;
+    Uint32 device = 0;
+    Uint64 timestamp = 0;
+    Uint32 state = 0;
+    float x = 0;
+    float y = 0;
+    float xrel = 0;
+    float yrel = 0;
+  };
+
+  EventFilter m_previousFilter = nullptr;
+  void* m_previousUserdata = nullptr;
+  std::mutex m_mutex;
+  std::array<Pending, MAX_PENDING> m_pending;
+  std::atomic<bool> m_hasOpen{false}; ///< Only written with m_mutex held
+  std::atomic<Uint64> m_mouseMotions{0};
+  std::atomic<Uint64> m_mouseFolded{0};
+  std::atomic<Uint64> m_penMotions{0};
+  std::atomic<Uint64> m_penFolded{0};
+
+  bool Coalesce(Event& event)
+  {
+    bool isMouse = event.type == EVENT_MOUSE_MOTION;
+    if (!isMouse && event.type != EVENT_PEN_MOTION) {
+      if (m_hasOpen.load(std::memory_order_acquire)) {
+        std::lock_guard lock{m_mutex};
+        if (m_hasOpen.load(std::memory_order_relaxed)) {
+          for (Pending& pending : m_pending) pending.open = false;
+          m_hasOpen.store(false, std::memory_order_relaxed);
+        }
+      }
+      return true;
+    }
+    Uint32 windowID = isMouse ? event.motion.windowID : event.pmotion.windowID;
+    Uint32 device = isMouse ? event.motion.which : event.pmotion.which;
+
+    std::lock_guard lock{m_mutex};
+    Pending* available = nullptr;
+    for (Pending& pending : m_pending) {
+      if (pending.open && pending.type == event.type &&
+          pending.windowID == windowID && pending.device == device) {
+        if (isMouse) {
+          pending.timestamp = event.motion.timestamp;
+          pending.state = event.motion.state;
+          pending.x = event.motion.x;
+          pending.y = event.motion.y;
+          pending.xrel += event.motion.xrel;
+          pending.yrel += event.motion.yrel;
+          m_mouseFolded.fetch_add(1, std::memory_order_relaxed);
+        } else {
+          pending.timestamp = event.pmotion.timestamp;
+          pending.state = event.pmotion.pen_state;
+          pending.x = event.pmotion.x;
+          pending.y = event.pmotion.y;
+          m_penFolded.fetch_add(1, std::memory_order_relaxed);
+        }
+        return false;
+      }
+      if (!available && !pending.used) available = &pending;
+    }
+    (isMouse ? m_mouseMotions : m_penMotions)
+      .fetch_add(1, std::memory_order_relaxed);
+    if (!available) return true; // Too many pending, let it go as is
+
+    *available = {.used = true,
+                  .open = true,
+                  .type = event.type,
+                  .windowID = windowID,
+                  .device = device};
+    if (isMouse) {
+      available->timestamp = event.motion.timestamp;
+      available->state = event.motion.state;
+      available->x = event.motion.x;
+      available->y = event.motion.y;
+      available->xrel = event.motion.xrel;
+      available->yrel = event.motion.yrel;
+    } else {
+      available->timestamp = event.pmotion.timestamp;
+      available->state = event.pmotion.pen_state;
+      available->x = event.pmotion.x;
+      available->y = event.pmotion.y;
+    }
+    event.common.reserved = MARK | Uint32(available - m_pending.data());
+    m_hasOpen.store(true, std::memory_order_release);
+    return true;
+  }
+
+  static bool SDLCALL Filter(void* userdata, Event* event)
+  {
+    auto self = static_cast<MotionCoalescer*>(userdata);
+    if (self->m_previousFilter &&
+        !self->m_previousFilter(self->m_previousUserdata, event)) {
+      return false;
+    }
+    return self->Coalesce(*event);
+  }
+};
+
+/// @}
+
+} // namespace SDL
+
+#endif /* SDL3PP_MOTION_COALESCER_H_ */
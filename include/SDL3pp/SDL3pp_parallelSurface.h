@@ -0,0 +1,543 @@
+#ifndef SDL3PP_PARALLEL_SURFACE_H_
+#define SDL3PP_PARALLEL_SURFACE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include "SDL3pp_cpuinfo.h"
+#include "SDL3pp_surface.h"
+
+namespace SDL {
+
+/**
+ * @defgroup CategoryParallelSurface Parallel surface operations
+ *
+ * Split surface operations into row bands over a pool of threads.
+ *
+ * Blits, scaling, conversions, alpha premultiplication and fills are done by
+ * SDL on a single thread. SurfaceThreadPool splits the destination into row
+ * bands and calls SDL for each on its own thread:
+ *
+ * ```cpp
+ * SDL::SurfaceThreadPool pool;
+ *
+ * pool.Blit(canvas, layer, nullptr, SDL::Rect{0, 0, 0, 0});
+ * pool.PremultiplyAlpha(canvas, false);
+ * SDL::Surface thumb = pool.Scale(canvas, {960, 540}, SDL::SCALEMODE_NEAREST);
+ * ```
+ *
+ * Each band gets its own surfaces sharing the pixels of the originals, so no
+ * SDL state is shared between threads. Results are the same as the serial
+ * calls, except for scaling as noted on SurfaceThreadPool.BlitScaled().
+ * Operations the bands can't reproduce, like RLE surfaces, run serially.
+ *
+ * @{
+ */
+
+namespace detail {
+
+/// Surface over rows [y0, y1) of another one's pixels
+inline Surface SurfaceRows(SurfaceRaw surface, int y0, int y1)
+{
+  Surface view{{surface->w, y1 - y0},
+               surface->format,
+               static_cast<Uint8*>(surface->pixels) +
+                 ptrdiff_t(y0) * surface->pitch,
+               surface->pitch};
+  if (SDL_Palette* palette = SDL_GetSurfacePalette(surface)) {
+    CheckError(SDL_SetSurfacePalette(view.get(), palette));
+  }
+  CheckError(
+    SDL_SetSurfaceColorspace(view.get(), SDL_GetSurfaceColorspace(surface)));
+  return view;
+}
+
+/// Copies what affects how a surface is blitted from
+inline void CopyBlitSettings(SurfaceRaw from, SurfaceRaw to)
+{
+  Uint8 r, g, b, a;
+  SDL_BlendMode blendMode;
+  Uint32 key;
+  CheckError(SDL_GetSurfaceColorMod(from, &r, &g, &b));
+  CheckError(SDL_GetSurfaceAlphaMod(from, &a));
+  CheckError(SDL_GetSurfaceBlendMode(from, &blendMode));
+  CheckError(SDL_SetSurfaceColorMod(to, r, g, b));
+  CheckError(SDL_SetSurfaceAlphaMod(to, a));
+  CheckError(SDL_SetSurfaceBlendMode(to, blendMode));
+  if (SDL_GetSurfaceColorKey(from, &key)) {
+    CheckError(SDL_SetSurfaceColorKey(to, true, key));
+  }
+}
+
+} // namespace detail
+
+/**
+ * Pool of threads running surface operations over row bands.
+ *
+ * The calling thread takes a band too, so a pool of N threads starts N - 1
+ * workers. Operations block until all bands are done, and rethrow the first
+ * error of any band.
+ *
+ * @threadsafety Operations must not be called concurrently on the same pool.
+ */
+class SurfaceThreadPool
+{
+  struct Band
+  {
+    int y0, y1;
+  };
+
+  std::vector<std::thread> m_workers;
+  std::mutex m_mutex;
+  std::condition_variable m_start;
+  std::condition_variable m_done;
+  const std::function<void(int)>* m_task = nullptr;
+  int m_count = 0;
+  std::atomic<int> m_next{0};
+  int m_running = 0;
+  Uint64 m_generation = 0;
+  std::exception_ptr m_error;
+  bool m_quit = false;
+  int m_minRows;
+
+public:
+  /**
+   * Create the pool and start its workers.
+   *
+   * @param threads the number of threads, including the calling one.
+   * @param minRows the fewest rows worth a band of their own.
+   */
+  explicit SurfaceThreadPool(int threads = GetNumLogicalCPUCores(),
+                             int minRows = 32)
+    : m_minRows(std::max(minRows, 1))
+  {
+    m_workers.reserve(std::max(threads - 1, 0));
+    try {
+      for (int i = 1; i < threads; i++) {
+        m_workers.emplace_back([this] { Work(); });
+      }
+    } catch (...) {
+      Stop();
+      throw;
+    }
+  }
+
+  SurfaceThreadPool(const SurfaceThreadPool&) = delete;
+  SurfaceThreadPool& operator=(const SurfaceThreadPool&) = delete;
+
+  /// Stop the workers.
+  ~SurfaceThreadPool() { Stop(); }
+
+  /**
+   * Get the number of threads.
+   *
+   * @returns the number of threads, including the calling one.
+   */
+  int GetThreadCount() const { return int(m_workers.size()) + 1; }
+
+  /**
+   * Run a task for each row band of a range.
+   *
+   * @param y0 the first row.
+   * @param y1 the row after the last.
+   * @param band called with the first row and the row after the last of each
+   *             band, on any thread of the pool.
+   * @param align bands start on y0 plus multiples of this.
+   * @throws the first exception thrown by band.
+   */
+  void ForEachBand(int y0,
+                   int y1,
+                   const std::function<void(int, int)>& band,
+                   int align = 1)
+  {
+    std::vector<Band> bands = Split(y0, y1, align);
+    Run(int(bands.size()), [&](int i) { band(bands[i].y0, bands[i].y1); });
+  }
+
+  /**
+   * Performs a fast blit from the source surface to the destination surface,
+   * in parallel.
+   *
+   * @param dst the Surface structure that is the blit target.
+   * @param src the Surface structure to be copied from.
+   * @param srcrect the Rect structure representing the rectangle to be copied,
+   *                or nullptr to copy the entire surface.
+   * @param dstrect the Rect structure representing the x and y position in the
+   *                destination surface, or nullptr for (0,0). The width and
+   *                height are ignored.
+   * @throws Error on failure.
+   *
+   * @sa Surface.Blit
+   */
+  void Blit(SurfaceRef dst,
+            SurfaceRef src,
+            OptionalRef<const RectRaw> srcrect,
+            OptionalRef<const RectRaw> dstrect)
+  {
+    Rect area = dstrect ? Rect{dstrect->x, dstrect->y, 0, 0} : Rect{};
+    area.h = srcrect ? srcrect->h : src->h;
+    std::vector<Band> bands;
+    if (src.get() != dst.get() && CanSplit(src) && CanSplit(dst)) {
+      bands = Split(dst, area.y, area.y + area.h, 1);
+    }
+    if (bands.size() < 2) return BlitSurface(src, srcrect, dst, dstrect);
+
+    std::vector<Surface> srcs, dsts;
+    std::vector<Rect> positions;
+    for (auto& band : bands) {
+      srcs.push_back(SourceView(src));
+      dsts.push_back(DestinationView(dst, band));
+      positions.push_back({area.x, area.y - band.y0, 0, 0});
+    }
+    Run(int(bands.size()), [&](int i) {
+      CheckError(SDL_BlitSurface(srcs[i].get(),
+                                 srcrect,
+                                 dsts[i].get(),
+                                 &positions[i]));
+    });
+  }
+
+  /**
+   * Perform a scaled blit to a destination surface, in parallel.
+   *
+   * Only SCALEMODE_NEAREST is split into bands, other modes sample across
+   * band edges and run serially. Bands start on destination rows mapping to
+   * whole source rows. The result is the same as the serial blit when the
+   * vertical scale factor is exact in binary, like 2 or 0.5; otherwise a row
+   * at a band edge may take its neighbouring source row.
+   *
+   * @param dst the Surface structure that is the blit target.
+   * @param src the Surface structure to be copied from.
+   * @param srcrect the Rect structure representing the rectangle to be copied,
+   *                or nullptr to copy the entire surface.
+   * @param dstrect the Rect structure representing the target rectangle in the
+   *                destination surface, or nullptr to fill the entire
+   *                destination surface.
+   * @param scaleMode the ScaleMode to be used.
+   * @throws Error on failure.
+   *
+   * @sa Surface.BlitScaled
+   */
+  void BlitScaled(SurfaceRef dst,
+                  SurfaceRef src,
+                  OptionalRef<const RectRaw> srcrect,
+                  OptionalRef<const RectRaw> dstrect,
+                  ScaleMode scaleMode)
+  {
+    Rect area = dstrect ? Rect(*dstrect) : Rect{0, 0, dst->w, dst->h};
+    int srcRows = srcrect ? srcrect->h : src->h;
+    std::vector<Band> bands;
+    if (scaleMode == SCALEMODE_NEAREST && srcRows > 0 && area.h > 0 &&
+        src.get() != dst.get() && CanSplit(src) && CanSplit(dst)) {
+      bands =
+        Split(dst, area.y, area.y + area.h, area.h / std::gcd(srcRows, area.h));
+    }
+    if (bands.size() < 2) {
+      return BlitSurfaceScaled(src, srcrect, dst, dstrect, scaleMode);
+    }
+
+    std::vector<Surface> srcs, dsts;
+    std::vector<Rect> areas;
+    for (auto& band : bands) {
+      srcs.push_back(SourceView(src));
+      dsts.push_back(DestinationView(dst, band));
+      areas.push_back({area.x, area.y - band.y0, area.w, area.h});
+    }
+    Run(int(bands.size()), [&](int i) {
+      CheckError(SDL_BlitSurfaceScaled(
+        srcs[i].get(), srcrect, dsts[i].get(), &areas[i], scaleMode));
+    });
+  }
+
+  /**
+   * Creates a new surface identical to the existing surface, scaled to the
+   * desired size, in parallel.
+   *
+   * Like BlitScaled(), only SCALEMODE_NEAREST is split into bands.
+   *
+   * @param surface the surface to duplicate and scale.
+   * @param size the width and height of the new surface.
+   * @param scaleMode the ScaleMode to be used.
+   * @returns the new Surface.
+   * @throws Error on failure.
+   *
+   * @sa Surface.Scale
+   */
+  Surface Scale(SurfaceRef surface, const PointRaw& size, ScaleMode scaleMode)
+  {
+    if (scaleMode != SCALEMODE_NEAREST || !CanSplit(surface) ||
+        SDL_SurfaceHasColorKey(surface)) {
+      return Surface(CheckError(
+        SDL_ScaleSurface(surface, size.x, size.y, SDL_ScaleMode(scaleMode))));
+    }
+
+    // As SDL does: copy ignoring mods, then give them to the copy
+    Surface scaled{size, surface->format};
+    if (SDL_Palette* palette = SDL_GetSurfacePalette(surface)) {
+      CheckError(SDL_SetSurfacePalette(scaled.get(), palette));
+    }
+    CheckError(SDL_SetSurfaceColorspace(scaled.get(),
+                                        SDL_GetSurfaceColorspace(surface)));
+    Surface source = detail::SurfaceRows(surface, 0, surface->h);
+    CheckError(SDL_SetSurfaceBlendMode(source.get(), SDL_BLENDMODE_NONE));
+    BlitScaled(scaled, source, nullptr, nullptr, scaleMode);
+    detail::CopyBlitSettings(surface, scaled.get());
+    return scaled;
+  }
+
+  /**
+   * Copy an existing surface to a new surface of the specified format, in
+   * parallel.
+   *
+   * Surfaces with a color key, RLE, alternate images, indexed formats or
+   * another colorspace than sRGB are converted serially.
+   *
+   * @param surface the existing Surface structure to convert.
+   * @param format the new pixel format.
+   * @returns the new Surface.
+   * @throws Error on failure.
+   *
+   * @sa Surface.Convert
+   */
+  Surface Convert(SurfaceRef surface, PixelFormat format)
+  {
+    auto isPlain = [](SDL_PixelFormat f) {
+      return !SDL_ISPIXELFORMAT_INDEXED(f) && !SDL_ISPIXELFORMAT_FOURCC(f);
+    };
+    std::vector<Band> bands;
+    if (isPlain(surface->format) && isPlain(format) &&
+        CanSplit(surface) && !SDL_SurfaceHasColorKey(surface) &&
+        !SDL_SurfaceHasAlternateImages(surface) &&
+        SDL_GetSurfaceColorspace(surface) == SDL_COLORSPACE_SRGB) {
+      bands = Split(0, surface->h, 1);
+    }
+    if (bands.size() < 2) {
+      Surface converted = ConvertSurface(surface, format);
+      if (!converted) throw Error();
+      return converted;
+    }
+
+    Surface converted{{surface->w, surface->h}, format};
+    Run(int(bands.size()), [&](int i) {
+      const Band& band = bands[i];
+      ConvertPixels(
+        {surface->w, band.y1 - band.y0},
+        surface->format,
+        static_cast<const Uint8*>(surface->pixels) +
+          ptrdiff_t(band.y0) * surface->pitch,
+        surface->pitch,
+        format,
+        static_cast<Uint8*>(converted->pixels) +
+          ptrdiff_t(band.y0) * converted->pitch,
+        converted->pitch);
+    });
+
+    CheckError(detail::CopyConvertSettings(surface, converted.get()));
+    return converted;
+  }
+
+  /**
+   * Premultiply the alpha in a surface, in parallel.
+   *
+   * @param surface the surface to modify.
+   * @param linear true to convert from sRGB to linear space for the alpha
+   *               multiplication, false to do multiplication in sRGB space.
+   * @throws Error on failure.
+   *
+   * @sa Surface.PremultiplyAlpha
+   */
+  void PremultiplyAlpha(SurfaceRef surface, bool linear)
+  {
+    SDL_PixelFormat format = surface->format;
+    std::vector<Band> bands;
+    if (CanSplit(surface) && !SDL_ISPIXELFORMAT_FOURCC(format) &&
+        !SDL_ISPIXELFORMAT_FLOAT(format) && !SDL_ISPIXELFORMAT_10BIT(format) &&
+        SDL_GetSurfaceColorspace(surface) == SDL_COLORSPACE_SRGB) {
+      bands = Split(0, surface->h, 1);
+    }
+    if (bands.size() < 2) return PremultiplySurfaceAlpha(surface, linear);
+
+    Run(int(bands.size()), [&](int i) {
+      auto pixels = static_cast<Uint8*>(surface->pixels) +
+                    ptrdiff_t(bands[i].y0) * surface->pitch;
+      CheckError(SDL_PremultiplyAlpha(surface->w,
+                                      bands[i].y1 - bands[i].y0,
+                                      format,
+                                      pixels,
+                                      surface->pitch,
+                                      format,
+                                      pixels,
+                                      surface->pitch,
+                                      linear));
+    });
+  }
+
+  /**
+   * Perform a fast fill of a set of rectangles with a specific color, in
+   * parallel.
+   *
+   * @param dst the Surface structure that is the drawing target.
+   * @param rects an array of Rects representing the rectangles to fill.
+   * @param color the color to fill with.
+   * @throws Error on failure.
+   *
+   * @sa Surface.FillRects
+   */
+  void FillRects(SurfaceRef dst, SpanRef<const RectRaw> rects, Uint32 color)
+  {
+    std::vector<Band> bands;
+    if (CanSplit(dst)) bands = Split(dst, 0, dst->h, 1);
+    if (bands.size() < 2) return FillSurfaceRects(dst, rects, color);
+
+    std::vector<Surface> dsts;
+    std::vector<std::vector<RectRaw>> shifted(bands.size());
+    for (size_t i = 0; i < bands.size(); i++) {
+      dsts.push_back(DestinationView(dst, bands[i]));
+      for (const RectRaw& rect : rects) {
+        if (rect.y < bands[i].y1 && rect.y + rect.h > bands[i].y0) {
+          shifted[i].push_back(
+            {rect.x, rect.y - bands[i].y0, rect.w, rect.h});
+        }
+      }
+    }
+    Run(int(bands.size()), [&](int i) {
+      if (shifted[i].empty()) return;
+      CheckError(SDL_FillSurfaceRects(dsts[i].get(),
+                                      shifted[i].data(),
+                                      narrowS32(shifted[i].size()),
+                                      color));
+    });
+  }
+
+private:
+  void Stop()
+  {
+    {
+      std::lock_guard lock{m_mutex};
+      m_quit = true;
+    }
+    m_start.notify_all();
+    for (auto& worker : m_workers) worker.join();
+  }
+
+  /// Surfaces needing locks can't be shared between threads
+  static bool CanSplit(SurfaceRaw surface)
+  {
+    return surface && surface->pixels && !MustLock(surface) &&
+           !SDL_SurfaceHasRLE(surface);
+  }
+
+  std::vector<Band> Split(int y0, int y1, int align) const
+  {
+    std::vector<Band> bands;
+    int rows = y1 - y0;
+    if (rows <= 0) return bands;
+    align = std::max(align, 1);
+    int count = std::clamp(rows / m_minRows, 1, GetThreadCount());
+    int step = (rows + count - 1) / count;
+    step = (step + align - 1) / align * align;
+    for (int y = y0; y < y1; y += step) {
+      bands.push_back({y, std::min(y + step, y1)});
+    }
+    return bands;
+  }
+
+  /// Bands of [y0, y1) within the clip rectangle, aligned relative to y0
+  std::vector<Band> Split(SurfaceRaw dst, int y0, int y1, int align) const
+  {
+    Rect clip;
+    SDL_GetSurfaceClipRect(dst, &clip);
+    int top = std::max(y0, clip.y);
+    if (align > 1) top = y0 + (top - y0) / align * align;
+    return Split(top, std::min(y1, clip.y + clip.h), align);
+  }
+
+  static Surface SourceView(SurfaceRaw src)
+  {
+    Surface view = detail::SurfaceRows(src, 0, src->h);
+    detail::CopyBlitSettings(src, view.get());
+    return view;
+  }
+
+  static Surface DestinationView(SurfaceRaw dst, const Band& band)
+  {
+    Surface view = detail::SurfaceRows(dst, band.y0, band.y1);
+    Rect clip;
+    SDL_GetSurfaceClipRect(dst, &clip);
+    clip.y -= band.y0;
+    SDL_SetSurfaceClipRect(view.get(), &clip);
+    return view;
+  }
+
+  void Run(int count, const std::function<void(int)>& task)
+  {
+    if (count <= 0) return;
+    if (count == 1 || m_workers.empty()) {
+      for (int i = 0; i < count; i++) task(i);
+      return;
+    }
+    {
+      std::lock_guard lock{m_mutex};
+      m_task = &task;
+      m_count = count;
+      m_next = 0;
+      m_error = nullptr;
+      m_running = int(m_workers.size());
+      m_generation++;
+    }
+    m_start.notify_all();
+    Claim(task);
+    std::exception_ptr error;
+    {
+      std::unique_lock lock{m_mutex};
+      m_done.wait(lock, [&] { return m_running == 0; });
+      m_task = nullptr;
+      error = m_error;
+    }
+    if (error) std::rethrow_exception(error);
+  }
+
+  void Claim(const std::function<void(int)>& task)
+  {
+    for (int i = m_next++; i < m_count; i = m_next++) {
+      try {
+        task(i);
+      } catch (...) {
+        std::lock_guard lock{m_mutex};
+        if (!m_error) m_error = std::current_exception();
+      }
+    }
+  }
+
+  void Work()
+  {
+    Uint64 seen = 0;
+    for (;;) {
+      const std::function<void(int)>* task;
+      {
+        std::unique_lock lock{m_mutex};
+        m_start.wait(lock, [&] { return m_quit || m_generation != seen; });
+        if (m_quit) return;
+        seen = m_generation;
+        task = m_task;
+      }
+      Claim(*task);
+      {
+        std::lock_guard lock{m_mutex};
+        if (--m_running == 0) m_done.notify_one();
+      }
+    }
+  }
+};
+
+/// @}
+
+} // namespace SDL
+
+#endif /* SDL3PP_PARALLEL_SURFACE_H_ */
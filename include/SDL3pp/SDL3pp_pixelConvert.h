@@ -0,0 +1,522 @@
+#ifndef SDL3PP_PIXEL_CONVERT_H_
+#define SDL3PP_PIXEL_CONVERT_H_
+
+#include <algorithm>
+#include <cstring>
+#include <span>
+#include "SDL3pp_cpuinfo.h"
+#include "SDL3pp_intrin.h"
+#include "SDL3pp_pixels.h"
+#include "SDL3pp_rect.h"
+
+namespace SDL {
+
+/**
+ * @defgroup CategoryPixelConvert SIMD Pixel Conversion
+ *
+ * Vectorized conversions between the common 8 bits per channel formats.
+ *
+ * SDL converts pixels through generic blitters, which are slow for what are
+ * byte swizzles. ConvertPixelsFast() handles conversions from any 32 bits
+ * format with 8 bit channels, PIXELFORMAT_RGB24 or PIXELFORMAT_BGR24 to a 32
+ * bits format with alpha: PIXELFORMAT_RGBA8888, PIXELFORMAT_ARGB8888,
+ * PIXELFORMAT_ABGR8888, PIXELFORMAT_BGRA8888 and their aliases like
+ * PIXELFORMAT_RGBA32. Alpha is filled with 255 when the source has none,
+ * giving the same result as SDL.
+ *
+ * The best instruction set is selected at runtime: AVX2, SSE2 or NEON, with a
+ * scalar fallback. ConvertPixels() and Surface.Convert() use it
+ * automatically when both formats are supported, and SDL otherwise:
+ *
+ * ```cpp
+ * // Fast path, if the surface is on PIXELFORMAT_XRGB8888 or RGB24
+ * SDL::Surface converted = surface.Convert(SDL::PIXELFORMAT_RGBA32);
+ * ```
+ *
+ * MapColors() and GetColors() do the same for arrays of colors and pixel
+ * values, as MapColor() and GetColor() would one at a time:
+ *
+ * ```cpp
+ * std::vector<Uint32> pixels(colors.size());
+ * SDL::MapColors(SDL::PIXELFORMAT_ARGB8888, colors, pixels);
+ * ```
+ *
+ * @{
+ */
+
+/**
+ * Instruction sets ConvertPixelsFast() can use.
+ *
+ * @sa GetPixelConvertPath
+ */
+enum PixelConvertPath
+{
+  PIXEL_CONVERT_SCALAR, ///< Plain C++, always available
+  PIXEL_CONVERT_SSE2,   ///< SSE2, 24 bits sources are converted as scalar
+  PIXEL_CONVERT_AVX2,   ///< AVX2
+  PIXEL_CONVERT_NEON,   ///< ARM NEON
+};
+
+namespace detail {
+
+/// Memory offset of each channel on a pixel, or -1 if missing
+struct PixelLayout
+{
+  int bytes;
+  int r, g, b, a;
+};
+
+constexpr int PackedByte(int shift)
+{
+  return SDL_BYTEORDER == SDL_LIL_ENDIAN ? shift / 8 : 3 - shift / 8;
+}
+
+constexpr bool GetPixelLayout(PixelFormatRaw format, PixelLayout* layout)
+{
+  constexpr int P0 = PackedByte(0), P8 = PackedByte(8),
+                P16 = PackedByte(16), P24 = PackedByte(24);
+  switch (format) {
+  case SDL_PIXELFORMAT_RGBA8888: *layout = {4, P24, P16, P8, P0}; break;
+  case SDL_PIXELFORMAT_ARGB8888: *layout = {4, P16, P8, P0, P24}; break;
+  case SDL_PIXELFORMAT_ABGR8888: *layout = {4, P0, P8, P16, P24}; break;
+  case SDL_PIXELFORMAT_BGRA8888: *layout = {4, P8, P16, P24, P0}; break;
+  case SDL_PIXELFORMAT_RGBX8888: *layout = {4, P24, P16, P8, -1}; break;
+  case SDL_PIXELFORMAT_XRGB8888: *layout = {4, P16, P8, P0, -1}; break;
+  case SDL_PIXELFORMAT_XBGR8888: *layout = {4, P0, P8, P16, -1}; break;
+  case SDL_PIXELFORMAT_BGRX8888: *layout = {4, P8, P16, P24, -1}; break;
+  case SDL_PIXELFORMAT_RGB24: *layout = {3, 0, 1, 2, -1}; break;
+  case SDL_PIXELFORMAT_BGR24: *layout = {3, 2, 1, 0, -1}; break;
+  default: return false;
+  }
+  return true;
+}
+
+/// Byte value meaning the destination byte is set to 255
+constexpr Uint8 PIXEL_SHUFFLE_FILL = 0x80;
+
+/// Byte value meaning the destination byte is set to 0
+constexpr Uint8 PIXEL_SHUFFLE_ZERO = 0x81;
+
+/// Source offset for each destination byte of a pixel
+struct PixelShuffle
+{
+  int srcBytes;
+  Uint8 index[4];
+};
+
+constexpr bool GetPixelShuffle(PixelFormatRaw src_format,
+                               PixelFormatRaw dst_format,
+                               PixelShuffle* shuffle)
+{
+  PixelLayout src{}, dst{};
+  if (!GetPixelLayout(src_format, &src) || !GetPixelLayout(dst_format, &dst) ||
+      dst.bytes != 4 || dst.a < 0) {
+    return false;
+  }
+  shuffle->srcBytes = src.bytes;
+  shuffle->index[dst.r] = Uint8(src.r);
+  shuffle->index[dst.g] = Uint8(src.g);
+  shuffle->index[dst.b] = Uint8(src.b);
+  shuffle->index[dst.a] = src.a < 0 ? PIXEL_SHUFFLE_FILL : Uint8(src.a);
+  return true;
+}
+
+/// Shuffle from Color arrays to 32 bits pixel values, like MapRGBA()
+constexpr bool GetColorShuffle(PixelFormatRaw format, PixelShuffle* shuffle)
+{
+  PixelLayout dst{};
+  if (!GetPixelLayout(format, &dst) || dst.bytes != 4) return false;
+  shuffle->srcBytes = 4;
+  for (auto& index : shuffle->index) index = PIXEL_SHUFFLE_ZERO;
+  shuffle->index[dst.r] = 0;
+  shuffle->index[dst.g] = 1;
+  shuffle->index[dst.b] = 2;
+  if (dst.a >= 0) shuffle->index[dst.a] = 3;
+  return true;
+}
+
+inline void ConvertRowScalar(const PixelShuffle& shuffle,
+                             const Uint8* src,
+                             Uint8* dst,
+                             int count)
+{
+  for (int i = 0; i < count; i++, src += shuffle.srcBytes, dst += 4) {
+    for (int k = 0; k < 4; k++) {
+      Uint8 index = shuffle.index[k];
+      if (index == PIXEL_SHUFFLE_FILL) {
+        dst[k] = 0xFF;
+      } else if (index == PIXEL_SHUFFLE_ZERO) {
+        dst[k] = 0;
+      } else {
+        dst[k] = src[index];
+      }
+    }
+  }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+
+inline int SDL_TARGETING("sse2") ConvertRowSSE2(const PixelShuffle& shuffle,
+                                                const Uint8* src,
+                                                Uint8* dst,
+                                                int count)
+{
+  if (shuffle.srcBytes != 4) return 0;
+
+  // Each destination byte is its source byte shifted into place and masked
+  __m128i fill = _mm_setzero_si128();
+  __m128i left[4] = {}, right[4] = {}, mask[4] = {};
+  bool used[4];
+  for (int k = 0; k < 4; k++) {
+    int index = shuffle.index[k];
+    used[k] = index < PIXEL_SHUFFLE_FILL;
+    if (index == PIXEL_SHUFFLE_FILL) {
+      fill = _mm_or_si128(fill, _mm_set1_epi32(int(0xFFu << (8 * k))));
+    }
+    if (!used[k]) continue;
+    left[k] = _mm_cvtsi32_si128(index < k ? 8 * (k - index) : 0);
+    right[k] = _mm_cvtsi32_si128(index > k ? 8 * (index - k) : 0);
+    mask[k] = _mm_set1_epi32(int(0xFFu << (8 * k)));
+  }
+
+  int i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * i));
+    __m128i out = fill;
+    for (int k = 0; k < 4; k++) {
+      if (!used[k]) continue;
+      __m128i moved = _mm_srl_epi32(_mm_sll_epi32(in, left[k]), right[k]);
+      out = _mm_or_si128(out, _mm_and_si128(moved, mask[k]));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4 * i), out);
+  }
+  return i;
+}
+
+#endif // SDL_SSE2_INTRINSICS
+
+#ifdef SDL_AVX2_INTRINSICS
+
+inline int SDL_TARGETING("avx2") ConvertRowAVX2(const PixelShuffle& shuffle,
+                                                const Uint8* src,
+                                                Uint8* dst,
+                                                int count)
+{
+  // Same control for both lanes, 4 pixels each
+  alignas(32) Uint8 control[32];
+  alignas(32) Uint8 fill[32];
+  for (int j = 0; j < 8; j++) {
+    for (int k = 0; k < 4; k++) {
+      Uint8 index = shuffle.index[k];
+      bool used = index < PIXEL_SHUFFLE_FILL;
+      control[4 * j + k] =
+        used ? Uint8((j % 4) * shuffle.srcBytes + index) : 0x80;
+      fill[4 * j + k] = index == PIXEL_SHUFFLE_FILL ? 0xFF : 0;
+    }
+  }
+  __m256i ctrl = _mm256_load_si256(reinterpret_cast<const __m256i*>(control));
+  __m256i alpha = _mm256_load_si256(reinterpret_cast<const __m256i*>(fill));
+
+  int i = 0;
+  if (shuffle.srcBytes == 4) {
+    for (; i + 8 <= count; i += 8) {
+      __m256i in =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 4 * i));
+      __m256i out = _mm256_or_si256(_mm256_shuffle_epi8(in, ctrl), alpha);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 4 * i), out);
+    }
+  } else {
+    // Lanes load 16 bytes at 12 byte steps, stop before reading past the row
+    for (; i + 10 <= count; i += 8) {
+      const Uint8* p = src + 3 * i;
+      __m256i in = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(p))),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 12)),
+        1);
+      __m256i out = _mm256_or_si256(_mm256_shuffle_epi8(in, ctrl), alpha);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 4 * i), out);
+    }
+  }
+  return i;
+}
+
+#endif // SDL_AVX2_INTRINSICS
+
+#ifdef SDL_NEON_INTRINSICS
+
+inline int ConvertRowNEON(const PixelShuffle& shuffle,
+                          const Uint8* src,
+                          Uint8* dst,
+                          int count)
+{
+  // Deinterleave 16 pixels into one register per byte, then reinterleave
+  uint8x16_t opaque = vdupq_n_u8(0xFF);
+  uint8x16_t zero = vdupq_n_u8(0);
+  int i = 0;
+  for (; i + 16 <= count; i += 16) {
+    uint8x16_t planes[4];
+    if (shuffle.srcBytes == 4) {
+      uint8x16x4_t in = vld4q_u8(src + 4 * i);
+      for (int k = 0; k < 4; k++) planes[k] = in.val[k];
+    } else {
+      uint8x16x3_t in = vld3q_u8(src + 3 * i);
+      for (int k = 0; k < 3; k++) planes[k] = in.val[k];
+    }
+    uint8x16x4_t out;
+    for (int k = 0; k < 4; k++) {
+      Uint8 index = shuffle.index[k];
+      if (index == PIXEL_SHUFFLE_FILL) {
+        out.val[k] = opaque;
+      } else if (index == PIXEL_SHUFFLE_ZERO) {
+        out.val[k] = zero;
+      } else {
+        out.val[k] = planes[index];
+      }
+    }
+    vst4q_u8(dst + 4 * i, out);
+  }
+  return i;
+}
+
+#endif // SDL_NEON_INTRINSICS
+
+/// Convert a row with the given path, finishing what it leaves with scalar
+inline void ConvertRow(PixelConvertPath path,
+                       const PixelShuffle& shuffle,
+                       const Uint8* src,
+                       Uint8* dst,
+                       int count)
+{
+  int done = 0;
+  switch (path) {
+#ifdef SDL_SSE2_INTRINSICS
+  case PIXEL_CONVERT_SSE2:
+    done = ConvertRowSSE2(shuffle, src, dst, count);
+    break;
+#endif
+#ifdef SDL_AVX2_INTRINSICS
+  case PIXEL_CONVERT_AVX2:
+    done = ConvertRowAVX2(shuffle, src, dst, count);
+    break;
+#endif
+#ifdef SDL_NEON_INTRINSICS
+  case PIXEL_CONVERT_NEON:
+    done = ConvertRowNEON(shuffle, src, dst, count);
+    break;
+#endif
+  default: break;
+  }
+  ConvertRowScalar(
+    shuffle, src + done * shuffle.srcBytes, dst + done * 4, count - done);
+}
+
+} // namespace detail
+
+/**
+ * Check if an instruction set can be used by ConvertPixelsFast().
+ *
+ * @param path the instruction set.
+ * @returns true if it was available at compile time and is supported by this
+ *          CPU.
+ *
+ * @threadsafety It is safe to call this function from any thread.
+ *
+ * @sa GetPixelConvertPath
+ */
+inline bool HasPixelConvertPath(PixelConvertPath path)
+{
+  switch (path) {
+  case PIXEL_CONVERT_SCALAR: return true;
+#ifdef SDL_SSE2_INTRINSICS
+  case PIXEL_CONVERT_SSE2: return HasSSE2();
+#endif
+#ifdef SDL_AVX2_INTRINSICS
+  case PIXEL_CONVERT_AVX2: return HasAVX2();
+#endif
+#ifdef SDL_NEON_INTRINSICS
+  case PIXEL_CONVERT_NEON: return HasNEON();
+#endif
+  default: return false;
+  }
+}
+
+/**
+ * Get the fastest instruction set ConvertPixelsFast() can use.
+ *
+ * @returns the fastest path available.
+ *
+ * @threadsafety It is safe to call this function from any thread.
+ *
+ * @sa HasPixelConvertPath
+ */
+inline PixelConvertPath GetPixelConvertPath()
+{
+  if (HasPixelConvertPath(PIXEL_CONVERT_AVX2)) return PIXEL_CONVERT_AVX2;
+  if (HasPixelConvertPath(PIXEL_CONVERT_NEON)) return PIXEL_CONVERT_NEON;
+  if (HasPixelConvertPath(PIXEL_CONVERT_SSE2)) return PIXEL_CONVERT_SSE2;
+  return PIXEL_CONVERT_SCALAR;
+}
+
+/**
+ * Check if ConvertPixelsFast() handles a pair of formats.
+ *
+ * @param src_format the source format.
+ * @param dst_format the destination format.
+ * @returns true if the conversion is supported.
+ *
+ * @threadsafety It is safe to call this function from any thread.
+ *
+ * @sa ConvertPixelsFast
+ */
+constexpr bool CanConvertPixelsFast(PixelFormat src_format,
+                                    PixelFormat dst_format)
+{
+  detail::PixelShuffle shuffle{};
+  return detail::GetPixelShuffle(src_format, dst_format, &shuffle);
+}
+
+/**
+ * Copy a block of pixels of one format to another with SIMD, if supported.
+ *
+ * The result is the same as ConvertPixels(), which calls this first.
+ *
+ * @param size the width and height of the block, in pixels.
+ * @param src_format the `src` pixels format.
+ * @param src a pointer to the source pixels.
+ * @param src_pitch the pitch of the source pixels, in bytes.
+ * @param dst_format the `dst` pixels format.
+ * @param dst a pointer to be filled in with new pixel data.
+ * @param dst_pitch the pitch of the destination pixels, in bytes.
+ * @param path the instruction set to use. It falls back to scalar if it is not
+ *             available.
+ * @returns true on success, false if the conversion is not supported, in which
+ *          case nothing is written.
+ *
+ * @threadsafety The same destination pixels should not be used from two threads
+ *               at once. It is safe to use the same source pixels from multiple
+ *               threads.
+ *
+ * @sa CanConvertPixelsFast
+ */
+inline bool ConvertPixelsFast(const PointRaw& size,
+                              PixelFormat src_format,
+                              const void* src,
+                              int src_pitch,
+                              PixelFormat dst_format,
+                              void* dst,
+                              int dst_pitch,
+                              PixelConvertPath path = GetPixelConvertPath())
+{
+  detail::PixelShuffle shuffle{};
+  if (!src || !dst || size.x < 0 || size.y < 0 ||
+      !detail::GetPixelShuffle(src_format, dst_format, &shuffle)) {
+    return false;
+  }
+  if (!HasPixelConvertPath(path)) path = PIXEL_CONVERT_SCALAR;
+
+  auto srcRow = static_cast<const Uint8*>(src);
+  auto dstRow = static_cast<Uint8*>(dst);
+  for (int y = 0; y < size.y; y++, srcRow += src_pitch, dstRow += dst_pitch) {
+    if (src_format == dst_format) {
+      std::memcpy(dstRow, srcRow, size_t(size.x) * 4);
+      continue;
+    }
+    detail::ConvertRow(path, shuffle, srcRow, dstRow, size.x);
+  }
+  return true;
+}
+
+/**
+ * Map an array of colors to pixel values.
+ *
+ * The result is the same as calling MapColor() on each color. Formats with 8
+ * bits per channel and 32 bits per pixel are mapped with SIMD, others one
+ * color at a time by SDL.
+ *
+ * @param format the pixel format details, a PixelFormat also works.
+ * @param colors the colors to map.
+ * @param pixels receives the pixel values. Only the first
+ *               `min(colors.size(), pixels.size())` values are written.
+ * @param palette an optional palette for indexed formats, may be nullptr.
+ * @param path the instruction set to use. It falls back to scalar if it is not
+ *             available.
+ *
+ * @threadsafety It is safe to call this function from any thread, as long as
+ *               the palette is not modified.
+ *
+ * @sa GetColors
+ * @sa MapColor
+ */
+inline void MapColors(const PixelFormatDetails& format,
+                      SpanRef<const ColorRaw> colors,
+                      std::span<Uint32> pixels,
+                      PaletteConstRef palette = {},
+                      PixelConvertPath path = GetPixelConvertPath())
+{
+  int count = int(std::min(colors.size(), pixels.size()));
+  detail::PixelShuffle shuffle{};
+  if (!detail::GetColorShuffle(format.format, &shuffle)) {
+    for (int i = 0; i < count; i++) {
+      pixels[i] = MapColor(format, colors.data()[i], palette);
+    }
+    return;
+  }
+  if (!HasPixelConvertPath(path)) path = PIXEL_CONVERT_SCALAR;
+  detail::ConvertRow(path,
+                     shuffle,
+                     reinterpret_cast<const Uint8*>(colors.data()),
+                     reinterpret_cast<Uint8*>(pixels.data()),
+                     count);
+}
+
+/**
+ * Get the colors of an array of pixel values.
+ *
+ * The result is the same as calling GetColor() on each value. Formats with 8
+ * bits per channel and 32 bits per pixel are read with SIMD, others one value
+ * at a time by SDL.
+ *
+ * @param format the pixel format details, a PixelFormat also works.
+ * @param pixels the pixel values.
+ * @param colors receives the colors. Only the first
+ *               `min(pixels.size(), colors.size())` colors are written.
+ * @param palette an optional palette for indexed formats, may be nullptr.
+ * @param path the instruction set to use. It falls back to scalar if it is not
+ *             available.
+ *
+ * @threadsafety It is safe to call this function from any thread, as long as
+ *               the palette is not modified.
+ *
+ * @sa MapColors
+ * @sa GetColor
+ */
+inline void GetColors(const PixelFormatDetails& format,
+                      std::span<const Uint32> pixels,
+                      SpanRef<ColorRaw> colors,
+                      PaletteConstRef palette = {},
+                      PixelConvertPath path = GetPixelConvertPath())
+{
+  int count = int(std::min(pixels.size(), colors.size()));
+  detail::PixelShuffle shuffle{};
+  if (SDL_BYTESPERPIXEL(format.format) != 4 ||
+      !detail::GetPixelShuffle(
+        format.format, SDL_PIXELFORMAT_RGBA32, &shuffle)) {
+    for (int i = 0; i < count; i++) {
+      colors.data()[i] = GetColor(pixels[i], format, palette);
+    }
+    return;
+  }
+  if (!HasPixelConvertPath(path)) path = PIXEL_CONVERT_SCALAR;
+  detail::ConvertRow(path,
+                     shuffle,
+                     reinterpret_cast<const Uint8*>(pixels.data()),
+                     reinterpret_cast<Uint8*>(colors.data()),
+                     count);
+}
+
+/// @}
+
+} // namespace SDL
+
+#endif /* SDL3PP_PIXEL_CONVERT_H_ */
@@ -0,0 +1,755 @@
+#ifndef SDL3PP_PIXEL_VIEW_H_
+#define SDL3PP_PIXEL_VIEW_H_
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "SDL3pp_error.h"
+#include "SDL3pp_pixels.h"
+#include "SDL3pp_rect.h"
+#include "SDL3pp_render.h"
+#include "SDL3pp_surface.h"
+
+namespace SDL {
+
+/**
+ * @defgroup CategoryPixelView Typed Pixel Views
+ *
+ * Pixel access with the format known at compile time.
+ *
+ * Surface.ReadPixel() and Surface.WritePixel() look up the format details on
+ * every call, which dominates per pixel loops. PixelView and ConstPixelView
+ * take the pixel format as template parameter instead, so reading and writing
+ * a pixel is an inlined load or store and a few shifts.
+ *
+ * Views are non owning, like std::mdspan: they are obtained from a
+ * SurfaceLock or a TextureLock, and must not outlive it. A view is a random
+ * access range of rows, each row a random access range of pixels, so loops can
+ * be written with range for or handed to the parallel algorithms:
+ *
+ * ```cpp
+ * auto lock = surface.Lock();
+ * SDL::PixelView<SDL::PIXELFORMAT_RGBA32> view(lock);
+ * std::for_each(std::execution::par, view.begin(), view.end(), [](auto row) {
+ *   for (auto pixel : row) {
+ *     SDL::Color c = pixel;
+ *     pixel = SDL::Color(255 - c.r, 255 - c.g, 255 - c.b, c.a);
+ *   }
+ * });
+ * ```
+ *
+ * Packed formats with up to 8 bits per channel and PIXELFORMAT_RGB24 and
+ * PIXELFORMAT_BGR24 are supported. Pixels are packed and unpacked the same way
+ * as MapRGBA() and GetRGBA() do.
+ *
+ * @{
+ */
+
+namespace detail {
+
+/// Bit size and shift of a channel on a raw pixel value
+struct PixelChannel
+{
+  int bits;
+  int shift;
+};
+
+/// Channels of a pixel format, bytes is 0 if not supported
+struct PixelChannels
+{
+  int bytes;
+  PixelChannel r, g, b, a;
+};
+
+constexpr PixelChannels GetPixelChannels(PixelFormatRaw format)
+{
+  PixelChannels channels{};
+  if (SDL_ISPIXELFORMAT_FOURCC(format)) return channels;
+  if (SDL_PIXELTYPE(format) == SDL_PIXELTYPE_ARRAYU8 &&
+      SDL_BYTESPERPIXEL(format) == 3) {
+    // Raw value is the 3 bytes as a native endian integer, as SDL reads them
+    constexpr bool LIL = SDL_BYTEORDER == SDL_LIL_ENDIAN;
+    int first = LIL ? 0 : 16, last = LIL ? 16 : 0;
+    switch (SDL_PIXELORDER(format)) {
+    case SDL_ARRAYORDER_RGB:
+      return {3, {8, first}, {8, 8}, {8, last}, {0, 0}};
+    case SDL_ARRAYORDER_BGR:
+      return {3, {8, last}, {8, 8}, {8, first}, {0, 0}};
+    default: return channels;
+    }
+  }
+  switch (SDL_PIXELTYPE(format)) {
+  case SDL_PIXELTYPE_PACKED8:
+  case SDL_PIXELTYPE_PACKED16:
+  case SDL_PIXELTYPE_PACKED32: break;
+  default: return channels;
+  }
+
+  // Bits of each channel, from the most significant
+  std::array<int, 4> bits;
+  switch (SDL_PIXELLAYOUT(format)) {
+  case SDL_PACKEDLAYOUT_332: bits = {0, 3, 3, 2}; break;
+  case SDL_PACKEDLAYOUT_4444: bits = {4, 4, 4, 4}; break;
+  case SDL_PACKEDLAYOUT_1555: bits = {1, 5, 5, 5}; break;
+  case SDL_PACKEDLAYOUT_5551: bits = {5, 5, 5, 1}; break;
+  case SDL_PACKEDLAYOUT_565: bits = {0, 5, 6, 5}; break;
+  case SDL_PACKEDLAYOUT_8888: bits = {8, 8, 8, 8}; break;
+  default: return channels;
+  }
+  const char* order = nullptr;
+  switch (SDL_PIXELORDER(format)) {
+  case SDL_PACKEDORDER_XRGB: order = "XRGB"; break;
+  case SDL_PACKEDORDER_RGBX: order = "RGBX"; break;
+  case SDL_PACKEDORDER_ARGB: order = "ARGB"; break;
+  case SDL_PACKEDORDER_RGBA: order = "RGBA"; break;
+  case SDL_PACKEDORDER_XBGR: order = "XBGR"; break;
+  case SDL_PACKEDORDER_BGRX: order = "BGRX"; break;
+  case SDL_PACKEDORDER_ABGR: order = "ABGR"; break;
+  case SDL_PACKEDORDER_BGRA: order = "BGRA"; break;
+  default: return channels;
+  }
+  int shift = bits[0] + bits[1] + bits[2] + bits[3];
+  for (int i = 0; i < 4; i++) {
+    shift -= bits[i];
+    PixelChannel channel{bits[i], shift};
+    switch (order[i]) {
+    case 'R': channels.r = channel; break;
+    case 'G': channels.g = channel; break;
+    case 'B': channels.b = channel; break;
+    case 'A': channels.a = channel; break;
+    default: break;
+    }
+  }
+  channels.bytes = SDL_BYTESPERPIXEL(format);
+  return channels;
+}
+
+/// Pack an 8 bits value on a channel, like MapRGBA()
+constexpr Uint32 PackChannel(Uint8 value, PixelChannel channel)
+{
+  if (channel.bits == 0) return 0;
+  return Uint32(value >> (8 - channel.bits)) << channel.shift;
+}
+
+/// Expand a channel to 8 bits by bit replication, like GetRGBA()
+constexpr Uint8 UnpackChannel(Uint32 raw, PixelChannel channel)
+{
+  if (channel.bits == 0) return 255;
+  Uint32 value = (raw >> channel.shift) & ((1u << channel.bits) - 1);
+  value <<= 8 - channel.bits;
+  for (int filled = channel.bits; filled < 8; filled *= 2) {
+    value |= value >> filled;
+  }
+  return Uint8(value);
+}
+
+} // namespace detail
+
+/**
+ * Compile time pack and unpack for a pixel format.
+ *
+ * @tparam FORMAT the pixel format. Packed formats with up to 8 bits per
+ *                channel, PIXELFORMAT_RGB24 and PIXELFORMAT_BGR24 are
+ *                supported.
+ *
+ * @sa PixelView
+ */
+template<PixelFormatRaw FORMAT>
+struct PixelTraits
+{
+  /// The channel layout.
+  static constexpr detail::PixelChannels CHANNELS =
+    detail::GetPixelChannels(FORMAT);
+
+  static_assert(CHANNELS.bytes != 0, "Pixel format not supported");
+
+  /// Size of a pixel in bytes.
+  static constexpr int BYTES = CHANNELS.bytes;
+
+  /// The smallest integer holding a raw pixel value.
+  using RawType =
+    std::conditional_t<BYTES == 1,
+                       Uint8,
+                       std::conditional_t<BYTES == 2, Uint16, Uint32>>;
+
+  /// Read the raw value of the pixel at `p`.
+  static RawType Load(const Uint8* p)
+  {
+    if constexpr (BYTES == 3) {
+      if constexpr (SDL_BYTEORDER == SDL_LIL_ENDIAN) {
+        return p[0] | (p[1] << 8) | (p[2] << 16);
+      } else {
+        return (p[0] << 16) | (p[1] << 8) | p[2];
+      }
+    } else {
+      RawType raw;
+      std::memcpy(&raw, p, sizeof(raw));
+      return raw;
+    }
+  }
+
+  /// Write the raw value of the pixel at `p`.
+  static void Store(Uint8* p, RawType raw)
+  {
+    if constexpr (BYTES == 3) {
+      if constexpr (SDL_BYTEORDER == SDL_LIL_ENDIAN) {
+        p[0] = Uint8(raw), p[1] = Uint8(raw >> 8), p[2] = Uint8(raw >> 16);
+      } else {
+        p[0] = Uint8(raw >> 16), p[1] = Uint8(raw >> 8), p[2] = Uint8(raw);
+      }
+    } else {
+      std::memcpy(p, &raw, sizeof(raw));
+    }
+  }
+
+  /// Map a color to a raw pixel value, like MapRGBA().
+  static constexpr RawType Pack(const ColorRaw& c)
+  {
+    return RawType(detail::PackChannel(c.r, CHANNELS.r) |
+                   detail::PackChannel(c.g, CHANNELS.g) |
+                   detail::PackChannel(c.b, CHANNELS.b) |
+                   detail::PackChannel(c.a, CHANNELS.a));
+  }
+
+  /// Get the color of a raw pixel value, like GetRGBA().
+  static constexpr Color Unpack(RawType raw)
+  {
+    return {detail::UnpackChannel(raw, CHANNELS.r),
+            detail::UnpackChannel(raw, CHANNELS.g),
+            detail::UnpackChannel(raw, CHANNELS.b),
+            detail::UnpackChannel(raw, CHANNELS.a)};
+  }
+};
+
+/**
+ * Reference to a single pixel on a BasicPixelView.
+ *
+ * Converts to Color and can be assigned a Color, packing and unpacking on
+ * the fly. Assigning another PixelRef copies the pixel, not the reference.
+ *
+ * @tparam FORMAT the pixel format.
+ * @tparam CONST true if the pixel is read-only.
+ */
+template<PixelFormatRaw FORMAT, bool CONST>
+class PixelRef
+{
+  using Traits = PixelTraits<FORMAT>;
+
+  using DataType = std::conditional_t<CONST, const Uint8, Uint8>;
+
+  DataType* m_data;
+
+public:
+  /// The raw pixel value type.
+  using RawType = typename Traits::RawType;
+
+  /// Wraps the pixel at `data`.
+  constexpr explicit PixelRef(DataType* data)
+    : m_data(data)
+  {
+  }
+
+  /// Copy constructor
+  constexpr PixelRef(const PixelRef& other) = default;
+
+  /// Copy the referenced pixel.
+  const PixelRef& operator=(const PixelRef& other) const
+    requires(!CONST)
+  {
+    SetRaw(other.GetRaw());
+    return *this;
+  }
+
+  /// Get the raw pixel value.
+  RawType GetRaw() const { return Traits::Load(m_data); }
+
+  /// Set the raw pixel value.
+  void SetRaw(RawType raw) const
+    requires(!CONST)
+  {
+    Traits::Store(m_data, raw);
+  }
+
+  /// Get the pixel color.
+  operator Color() const { return Traits::Unpack(GetRaw()); }
+
+  /// Set the pixel color.
+  const PixelRef& operator=(const ColorRaw& c) const
+    requires(!CONST)
+  {
+    SetRaw(Traits::Pack(c));
+    return *this;
+  }
+
+  /// Get the pixel address.
+  constexpr DataType* data() const { return m_data; }
+};
+
+/**
+ * A row of pixels on a BasicPixelView.
+ *
+ * @tparam FORMAT the pixel format.
+ * @tparam CONST true if the pixels are read-only.
+ */
+template<PixelFormatRaw FORMAT, bool CONST>
+class PixelRow
+{
+  using Traits = PixelTraits<FORMAT>;
+
+  using DataType = std::conditional_t<CONST, const Uint8, Uint8>;
+
+  DataType* m_data = nullptr;
+
+  int m_width = 0;
+
+public:
+  /// The raw pixel value type.
+  using RawType = typename Traits::RawType;
+
+  /// Reference to a pixel.
+  using Reference = PixelRef<FORMAT, CONST>;
+
+  /**
+   * Random access iterator over the pixels of a row.
+   *
+   * Dereferencing gives a PixelRef proxy by value. Like
+   * `std::vector<bool>::iterator`, it still reports the random access category
+   * so parallel algorithms can split the range.
+   */
+  class Iterator
+  {
+    DataType* m_data = nullptr;
+
+  public:
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = Color;
+    using difference_type = std::ptrdiff_t;
+    using reference = Reference;
+    using pointer = void;
+
+    constexpr Iterator() = default;
+
+    constexpr explicit Iterator(DataType* data)
+      : m_data(data)
+    {
+    }
+
+    constexpr Reference operator*() const { return Reference(m_data); }
+
+    constexpr Reference operator[](difference_type n) const
+    {
+      return Reference(m_data + n * Traits::BYTES);
+    }
+
+    constexpr Iterator& operator++() { return *this += 1; }
+
+    constexpr Iterator operator++(int)
+    {
+      return std::exchange(*this, *this + 1);
+    }
+
+    constexpr Iterator& operator--() { return *this -= 1; }
+
+    constexpr Iterator operator--(int)
+    {
+      return std::exchange(*this, *this - 1);
+    }
+
+    constexpr Iterator& operator+=(difference_type n)
+    {
+      m_data += n * Traits::BYTES;
+      return *this;
+    }
+
+    constexpr Iterator& operator-=(difference_type n) { return *this += -n; }
+
+    constexpr Iterator operator+(difference_type n) const
+    {
+      return Iterator(m_data + n * Traits::BYTES);
+    }
+
+    friend constexpr Iterator operator+(difference_type n, const Iterator& it)
+    {
+      return it + n;
+    }
+
+    constexpr Iterator operator-(difference_type n) const
+    {
+      return *this + -n;
+    }
+
+    constexpr difference_type operator-(const Iterator& other) const
+    {
+      return (m_data - other.m_data) / Traits::BYTES;
+    }
+
+    constexpr bool operator==(const Iterator& other) const = default;
+
+    constexpr auto operator<=>(const Iterator& other) const = default;
+  };
+
+  constexpr PixelRow() = default;
+
+  /// Wraps `width` pixels starting at `data`.
+  constexpr PixelRow(DataType* data, int width)
+    : m_data(data)
+    , m_width(width)
+  {
+  }
+
+  /// Get the number of pixels.
+  constexpr int size() const { return m_width; }
+
+  /// Get the first pixel address.
+  constexpr DataType* data() const { return m_data; }
+
+  /// Iterator to the first pixel.
+  constexpr Iterator begin() const { return Iterator(m_data); }
+
+  /// Iterator past the last pixel.
+  constexpr Iterator end() const
+  {
+    return Iterator(m_data + m_width * Traits::BYTES);
+  }
+
+  /// Get a reference to the pixel at `x`.
+  constexpr Reference operator[](int x) const
+  {
+    SDL_assert_paranoid(x >= 0 && x < m_width);
+    return Reference(m_data + x * Traits::BYTES);
+  }
+
+  /// Read the raw pixel value at `x`.
+  RawType ReadPixelRaw(int x) const { return (*this)[x].GetRaw(); }
+
+  /// Write the raw pixel value at `x`.
+  void WritePixelRaw(int x, RawType raw) const
+    requires(!CONST)
+  {
+    (*this)[x].SetRaw(raw);
+  }
+
+  /// Read the pixel color at `x`.
+  Color ReadPixel(int x) const { return (*this)[x]; }
+
+  /// Write the pixel color at `x`.
+  void WritePixel(int x, const ColorRaw& c) const
+    requires(!CONST)
+  {
+    (*this)[x] = c;
+  }
+};
+
+/**
+ * Non owning 2D view over pixels of a known format.
+ *
+ * Use the aliases PixelView and ConstPixelView.
+ *
+ * @tparam FORMAT the pixel format, checked against the lock at runtime.
+ * @tparam CONST true if the pixels are read-only.
+ *
+ * @sa PixelTraits
+ */
+template<PixelFormatRaw FORMAT, bool CONST>
+class BasicPixelView
+{
+  using Traits = PixelTraits<FORMAT>;
+
+  using DataType = std::conditional_t<CONST, const Uint8, Uint8>;
+
+  using VoidType = std::conditional_t<CONST, const void, void>;
+
+  DataType* m_data = nullptr;
+
+  int m_pitch = 0;
+
+  Point m_size;
+
+  static void CheckFormat(PixelFormat format)
+  {
+    if (format == FORMAT) return;
+    SetError("Pixel view expected {}, got {}",
+             PixelFormat(FORMAT).GetName(),
+             format.GetName());
+    throw Error();
+  }
+
+public:
+  /// The raw pixel value type.
+  using RawType = typename Traits::RawType;
+
+  /// Reference to a pixel.
+  using Reference = PixelRef<FORMAT, CONST>;
+
+  /// A row of pixels.
+  using Row = PixelRow<FORMAT, CONST>;
+
+  /**
+   * Random access iterator over the rows of a view.
+   *
+   * Rows are returned by value. Like `std::vector<bool>::iterator`, it still
+   * reports the random access category so parallel algorithms can split the
+   * range.
+   */
+  class Iterator
+  {
+    Row m_row;
+
+    int m_pitch = 0;
+
+  public:
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = Row;
+    using difference_type = std::ptrdiff_t;
+    using reference = Row;
+    using pointer = void;
+
+    constexpr Iterator() = default;
+
+    constexpr Iterator(Row row, int pitch)
+      : m_row(row)
+      , m_pitch(pitch)
+    {
+    }
+
+    constexpr Row operator*() const { return m_row; }
+
+    constexpr Row operator[](difference_type n) const { return *(*this + n); }
+
+    constexpr Iterator& operator++() { return *this += 1; }
+
+    constexpr Iterator operator++(int)
+    {
+      return std::exchange(*this, *this + 1);
+    }
+
+    constexpr Iterator& operator--() { return *this -= 1; }
+
+    constexpr Iterator operator--(int)
+    {
+      return std::exchange(*this, *this - 1);
+    }
+
+    constexpr Iterator& operator+=(difference_type n)
+    {
+      m_row = Row(m_row.data() + n * m_pitch, m_row.size());
+      return *this;
+    }
+
+    constexpr Iterator& operator-=(difference_type n) { return *this += -n; }
+
+    constexpr Iterator operator+(difference_type n) const
+    {
+      Iterator it = *this;
+      return it += n;
+    }
+
+    friend constexpr Iterator operator+(difference_type n, const Iterator& it)
+    {
+      return it + n;
+    }
+
+    constexpr Iterator operator-(difference_type n) const
+    {
+      return *this + -n;
+    }
+
+    constexpr difference_type operator-(const Iterator& other) const
+    {
+      return (m_row.data() - other.m_row.data()) / m_pitch;
+    }
+
+    constexpr bool operator==(const Iterator& other) const
+    {
+      return m_row.data() == other.m_row.data();
+    }
+
+    constexpr auto operator<=>(const Iterator& other) const
+    {
+      return m_row.data() <=> other.m_row.data();
+    }
+  };
+
+  constexpr BasicPixelView() = default;
+
+  /**
+   * Wraps pixels already known to be on FORMAT.
+   *
+   * @param pixels the first pixel.
+   * @param pitch the length of one row in bytes.
+   * @param size the width and height in pixels.
+   */
+  constexpr BasicPixelView(VoidType* pixels, int pitch, const PointRaw& size)
+    : m_data(static_cast<DataType*>(pixels))
+    , m_pitch(pitch)
+    , m_size(size)
+  {
+  }
+
+  /**
+   * View the pixels of a locked surface.
+   *
+   * @param lock the surface lock, must outlive the view.
+   * @throws Error if the surface is not on FORMAT.
+   */
+  BasicPixelView(
+    std::conditional_t<CONST, const SurfaceLock&, SurfaceLock&> lock)
+    : BasicPixelView(lock.GetPixels(), lock.GetPitch(), lock.GetSize())
+  {
+    CheckFormat(lock.GetFormat());
+  }
+
+  /**
+   * View the pixels of a locked texture.
+   *
+   * Texture locks are write-only, the initial contents are undefined.
+   *
+   * @param lock the texture lock, must outlive the view.
+   * @throws Error if the texture is not on FORMAT.
+   */
+  BasicPixelView(
+    std::conditional_t<CONST, const TextureLock&, TextureLock&> lock)
+    : BasicPixelView(lock.GetPixels(), lock.GetPitch(), lock.GetSize())
+  {
+    CheckFormat(lock.GetFormat());
+  }
+
+  /// Read-only view of a mutable one.
+  constexpr BasicPixelView(const BasicPixelView<FORMAT, false>& other)
+    requires(CONST)
+    : BasicPixelView(other.GetPixels(), other.GetPitch(), other.GetSize())
+  {
+  }
+
+  /// Get the pixel format.
+  static constexpr PixelFormat GetFormat() { return FORMAT; }
+
+  /// Get the width in pixels.
+  constexpr int GetWidth() const { return m_size.x; }
+
+  /// Get the height in pixels.
+  constexpr int GetHeight() const { return m_size.y; }
+
+  /// Get the size in pixels.
+  constexpr Point GetSize() const { return m_size; }
+
+  /// Get pitch in bytes.
+  constexpr int GetPitch() const { return m_pitch; }
+
+  /// Get the pixels.
+  constexpr VoidType* GetPixels() const { return m_data; }
+
+  /// Get the row at `y`.
+  constexpr Row GetRow(int y) const
+  {
+    SDL_assert_paranoid(y >= 0 && y < m_size.y);
+    return Row(m_data + std::ptrdiff_t(y) * m_pitch, m_size.x);
+  }
+
+  /// Iterator to the first row.
+  constexpr Iterator begin() const
+  {
+    return Iterator(Row(m_data, m_size.x), m_pitch);
+  }
+
+  /// Iterator past the last row.
+  constexpr Iterator end() const { return begin() + m_size.y; }
+
+  /// Get the number of rows.
+  constexpr int size() const { return m_size.y; }
+
+  /**
+   * Get a view on a part of this one.
+   *
+   * @param rect the area, must be inside this view.
+   * @returns the view, sharing the same pixels.
+   */
+  constexpr BasicPixelView GetSubview(const RectRaw& rect) const
+  {
+    SDL_assert_paranoid(rect.x >= 0 && rect.y >= 0 && rect.w >= 0 &&
+                        rect.h >= 0 && rect.x + rect.w <= m_size.x &&
+                        rect.y + rect.h <= m_size.y);
+    return BasicPixelView(m_data + std::ptrdiff_t(rect.y) * m_pitch +
+                            rect.x * Traits::BYTES,
+                          m_pitch,
+                          {rect.w, rect.h});
+  }
+
+  /// Get a reference to the pixel at `p`.
+  constexpr Reference operator[](const PointRaw& p) const
+  {
+    return GetRow(p.y)[p.x];
+  }
+
+  /**
+   * Read the raw value of a pixel, without unpacking it.
+   *
+   * @param p the coordinates, 0 <= x < width, 0 <= y < height.
+   * @returns the pixel value, as MapRGBA() would return it.
+   */
+  RawType ReadPixelRaw(const PointRaw& p) const { return (*this)[p].GetRaw(); }
+
+  /**
+   * Write the raw value of a pixel.
+   *
+   * @param p the coordinates, 0 <= x < width, 0 <= y < height.
+   * @param raw the pixel value, as returned by MapRGBA().
+   */
+  void WritePixelRaw(const PointRaw& p, RawType raw) const
+    requires(!CONST)
+  {
+    (*this)[p].SetRaw(raw);
+  }
+
+  /**
+   * Read the color of a pixel.
+   *
+   * Same result as Surface.ReadPixel() for 8 bits per channel formats.
+   *
+   * @param p the coordinates, 0 <= x < width, 0 <= y < height.
+   * @returns the pixel color.
+   */
+  Color ReadPixel(const PointRaw& p) const { return (*this)[p]; }
+
+  /**
+   * Write the color of a pixel.
+   *
+   * Same result as Surface.WritePixel().
+   *
+   * @param p the coordinates, 0 <= x < width, 0 <= y < height.
+   * @param c the color.
+   */
+  void WritePixel(const PointRaw& p, const ColorRaw& c) const
+    requires(!CONST)
+  {
+    (*this)[p] = c;
+  }
+};
+
+/**
+ * Mutable view over pixels of a known format.
+ *
+ * @tparam FORMAT the pixel format.
+ */
+template<PixelFormatRaw FORMAT>
+using PixelView = BasicPixelView<FORMAT, false>;
+
+/**
+ * Read-only view over pixels of a known format.
+ *
+ * @tparam FORMAT the pixel format.
+ */
+template<PixelFormatRaw FORMAT>
+using ConstPixelView = BasicPixelView<FORMAT, true>;
+
+/// @}
+
+} // namespace SDL
+
+#endif /* SDL3PP_PIXEL_VIEW_H_ */
@@ -998,6 +998,44 @@ inline void SetPointerPropertyWithCleanup(PropertiesRef props,
                                     Wrapper::Wrap(std::move(cleanup)));
 }
 
+/**
+ * Set a pointer property in a group of properties with a cleanup function that
+ * is called when the property is deleted.
+ *
+ * Same as SetPointerPropertyWithCleanup(PropertiesRef, StringParam, void*,
+ * CleanupPropertyCB), but the cleanup is kept in a preallocated slot until the
+ * property is deleted, so no heap allocation is done on our side to track it.
+ * Slots are shared with every InplaceFunction of the same type, so prefer it
+ * for short lived properties.
+ *
+ * @param props the properties to modify.
+ * @param name the name of the property to modify.
+ * @param value the new value of the property, or nullptr to delete the
+ *              property.
+ * @param cleanup the function to call when this property is deleted.
+ * @throws Error on failure.
+ *
+ * @threadsafety It is safe to call this function from any thread.
+ *
+ * @since This function is available since SDL 3.2.0.
+ *
+ * @sa result-callback
+ *
+ * @cat result-callback
+ */
+template<size_t SIZE>
+inline void SetPointerPropertyWithCleanup(
+  PropertiesRef props,
+  StringParam name,
+  void* value,
+  InplaceFunction<void(void* value), SIZE> cleanup)
+{
+  using Wrapper = CallbackWrapper<InplaceFunction<void(void* value), SIZE>>;
+  void* userdata = Wrapper::Wrap(std::move(cleanup));
+  CheckError(SDL_SetPointerPropertyWithCleanup(
+    props, std::move(name), value, &Wrapper::CallOnce, userdata));
+}
+
 inline void Properties::SetPointerPropertyWithCleanup(
   StringParam name,
   void* value,
@@ -6,6 +6,7 @@
 #include "SDL3pp_events.h"
 #include "SDL3pp_gpu.h"
 #include "SDL3pp_pixels.h"
+#include "SDL3pp_renderStats.h"
 #include "SDL3pp_video.h"
 
 namespace SDL {
@@ -363,7 +364,11 @@ struct Renderer : ResourceBase<RendererRaw>
   Renderer(SurfaceRef surface);
 
   /// Destructor
-  ~Renderer() { SDL_DestroyRenderer(get()); }
+  ~Renderer()
+  {
+    SDL3PP_RENDER_STATS_FORGET(get());
+    SDL_DestroyRenderer(get());
+  }
 
   /// Assignment operator.
   constexpr Renderer& operator=(Renderer&& other) noexcept
@@ -3327,6 +3332,12 @@ class TextureLock
 {
   TextureRef m_lock;
 
+  void* m_pixels = nullptr;
+
+  int m_pitch = 0;
+
+  Point m_size;
+
 public:
   /**
    * Lock a portion of the texture for **write-only** pixel access.
@@ -3368,6 +3379,9 @@ public:
   /// Move constructor
   TextureLock(TextureLock&& other) noexcept
     : m_lock(std::move(other.m_lock))
+    , m_pixels(other.m_pixels)
+    , m_pitch(other.m_pitch)
+    , m_size(other.m_size)
   {
   }
 
@@ -3396,6 +3410,9 @@ public:
   TextureLock& operator=(TextureLock&& other) noexcept
   {
     std::swap(m_lock, other.m_lock);
+    std::swap(m_pixels, other.m_pixels);
+    std::swap(m_pitch, other.m_pitch);
+    std::swap(m_size, other.m_size);
     return *this;
   }
 
@@ -3421,6 +3438,24 @@ public:
    */
   void reset();
 
+  /// Get the width in pixels of the locked area.
+  constexpr int GetWidth() const { return m_size.x; }
+
+  /// Get the height in pixels of the locked area.
+  constexpr int GetHeight() const { return m_size.y; }
+
+  /// Get the size in pixels of the locked area.
+  constexpr Point GetSize() const { return m_size; }
+
+  /// Get pitch in bytes.
+  constexpr int GetPitch() const { return m_pitch; }
+
+  /// Get the pixel format.
+  PixelFormat GetFormat() const { return m_lock.GetFormat(); }
+
+  /// Get the locked pixels.
+  constexpr void* GetPixels() const { return m_pixels; }
+
   /// Get the reference to locked resource.
   TextureRef resource() const { return m_lock; }
 
@@ -5775,6 +5810,9 @@ inline TextureLock::TextureLock(TextureRef resource,
   : m_lock(std::move(resource))
 {
   LockTexture(m_lock, rect, pixels, pitch);
+  m_pixels = *pixels;
+  m_pitch = *pitch;
+  m_size = rect ? Point(rect->w, rect->h) : m_lock.GetSize();
 }
 
 /**
@@ -5875,6 +5913,9 @@ inline void TextureLock::reset()
   if (!m_lock) return;
   UnlockTexture(m_lock);
   m_lock = {};
+  m_pixels = nullptr;
+  m_pitch = 0;
+  m_size = {};
 }
 
 /**
@@ -5903,6 +5944,7 @@ inline void TextureLock::reset()
  */
 inline void SetRenderTarget(RendererRef renderer, TextureRef texture)
 {
+  SDL3PP_RENDER_STATS_SCOPE(renderer, RENDER_STATS_TARGET);
   CheckError(SDL_SetRenderTarget(renderer, texture));
 }
 
@@ -6598,6 +6640,7 @@ inline FPoint Renderer::GetScale() const { return SDL::GetRenderScale(get()); }
  */
 inline void SetRenderDrawColor(RendererRef renderer, ColorRaw c)
 {
+  SDL3PP_RENDER_STATS_SCOPE(renderer, RENDER_STATS_DRAW_COLOR);
   CheckError(SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a));
 }
 
@@ -6625,6 +6668,7 @@ inline void Renderer::SetDrawColor(ColorRaw c)
  */
 inline void SetRenderDrawColorFloat(RendererRef renderer, const FColorRaw& c)
 {
+  SDL3PP_RENDER_STATS_SCOPE(renderer, RENDER_STATS_DRAW_COLOR);
   CheckError(SDL_SetRenderDrawColorFloat(renderer, c.r, c.g, c.b, c.a));
 }
 
@@ -6830,6 +6874,7 @@ inline float Renderer::GetColorScale() const
  */
 inline void SetRenderDrawBlendMode(RendererRef renderer, BlendMode blendMode)
 {
+  SDL3PP_RENDER_STATS_SCOPE(renderer, RENDER_STATS_BLEND_MODE);
   CheckError(SDL_SetRenderDrawBlendMode(renderer, blendMode));
 }
 
@@ -6882,6 +6927,7 @@ inline BlendMode Renderer::GetDrawBlendMode() const
  */
 inline void RenderClear(RendererRef renderer)
 {
+  SDL3PP_RENDER_STATS_SCOPE(renderer, RENDER_STATS_CLEAR);
   CheckError(SDL_RenderClear(renderer));
 }
 
@@ -6902,6 +6948,7 @@ inline void Renderer::RenderClear() { SDL::RenderClear(get()); }
  */
 inline void RenderPoint(RendererRef renderer, const FPointRaw& p)
 {
+  SDL3PP_RENDER_STATS_SCOPE(renderer, RENDER_STATS_DRAW, 1);
   CheckError(SDL_RenderPoint(renderer, p.x, p.y));
 }
 
@@ -6925,6 +6972,7 @@ inline void Renderer::RenderPoint(const FPointRaw& p)
  */
 inline void RenderPoints(RendererRef renderer, SpanRef<const FPointRaw> points)
 {
+  SDL3PP_RENDER_STATS_SCOPE(renderer, RENDER_STATS_DRAW, points.size());
   CheckError(
     SDL_RenderPoints(renderer, points.data(), narrowS32(points.size())));
 }
@@ -6952,6 +7000,7 @@ inline void RenderLine(RendererRef renderer,
                        const FPointRaw& p1,
                        const FPointRaw& p2)
 {
+  SDL3PP_RENDER_STATS_SCOPE(renderer, RENDER_STATS_DRAW, 2);
   CheckError(SDL_RenderLine(renderer, p1.x, p1.y, p2.x, p2.y));
 }
 
@@ -6976,6 +7025,7 @@ inline void Renderer::RenderLine(const FPointRaw& p1, const FPointRaw& p2)
  */
 inline void RenderLines(RendererRef renderer, SpanRef<const FPointRaw> points)
 {
+  SDL3PP_RENDER_STATS_SCOPE(renderer, RENDER_STATS_DRAW, points.size());
   CheckError(
     SDL_RenderLines(renderer, points.data(), narrowS32(points.size())));
 }
@@ -7001,6 +7051,7 @@ inline void Renderer::RenderLines(SpanRef<const FPointRaw> points)
  */
 inline void RenderRect(RendererRef renderer, OptionalRef<const FRectRaw> rect)
 {
+  SDL3PP_RENDER_STATS_SCOPE(renderer, RENDER_STATS_DRAW, 4);
   CheckError(SDL_RenderRect(renderer, rect));
 }
 
@@ -7025,6 +7076,7 @@ inline void Renderer::RenderRect(OptionalRef<const FRectRaw> rect)
  */
 inline void RenderRects(RendererRef renderer, SpanRef<const FRectRaw> rects)
 {
+  SDL3PP_RENDER_STATS_SCOPE(renderer, RENDER_STATS_DRAW, 4 * rects.size());
   CheckError(SDL_RenderRects(renderer, rects.data(), narrowS32(rects.size())));
 }
 
@@ -7051,6 +7103,7 @@ inline void Renderer::RenderRects(SpanRef<const FRectRaw> rects)
 inline void RenderFillRect(RendererRef renderer,
                            OptionalRef<const FRectRaw> rect)
 {
+  SDL3PP_RENDER_STATS_SCOPE(renderer, RENDER_STATS_DRAW, 4);
   CheckError(SDL_RenderFillRect(renderer, rect));
 }
 
@@ -7075,6 +7128,7 @@ inline void Renderer::RenderFillRect(OptionalRef<const FRectRaw> rect)
  */
 inline void RenderFillRects(RendererRef renderer, SpanRef<const FRectRaw> rects)
 {
+  SDL3PP_RENDER_STATS_SCOPE(renderer, RENDER_STATS_DRAW, 4 * rects.size());
   CheckError(
     SDL_RenderFillRects(renderer, rects.data(), narrowS32(rects.size())));
 }
@@ -7108,6 +7162,7 @@ inline void RenderTexture(RendererRef renderer,
                           OptionalRef<const FRectRaw> srcrect,
                           OptionalRef<const FRectRaw> dstrect)
 {
+  SDL3PP_RENDER_STATS_SCOPE(renderer, RENDER_STATS_DRAW, 4, texture);
   CheckError(SDL_RenderTexture(renderer, texture, srcrect, dstrect));
 }
 
@@ -7151,6 +7206,7 @@ inline void RenderTextureRotated(RendererRef renderer,
                                  OptionalRef<const FPointRaw> center,
                                  FlipMode flip = FlipMode::SDL_FLIP_NONE)
 {
+  SDL3PP_RENDER_STATS_SCOPE(renderer, RENDER_STATS_DRAW, 4, texture);
   CheckError(SDL_RenderTextureRotated(
     renderer, texture, srcrect, dstrect, angle, center, flip));
 }
@@ -7198,6 +7254,7 @@ inline void RenderTextureAffine(RendererRef renderer,
                                 OptionalRef<const FPointRaw> right,
                                 OptionalRef<const FPointRaw> down)
 {
+  SDL3PP_RENDER_STATS_SCOPE(renderer, RENDER_STATS_DRAW, 4, texture);
   CheckError(
     SDL_RenderTextureAffine(renderer, texture, srcrect, origin, right, down));
 }
@@ -7241,6 +7298,7 @@ inline void RenderTextureTiled(RendererRef renderer,
                                float scale,
                                OptionalRef<const FRectRaw> dstrect)
 {
+  SDL3PP_RENDER_STATS_SCOPE(renderer, RENDER_STATS_DRAW, 4, texture);
   CheckError(
     SDL_RenderTextureTiled(renderer, texture, srcrect, scale, dstrect));
 }
@@ -7295,6 +7353,7 @@ inline void RenderTexture9Grid(RendererRef renderer,
                                float scale,
                                OptionalRef<const FRectRaw> dstrect)
 {
+  SDL3PP_RENDER_STATS_SCOPE(renderer, RENDER_STATS_DRAW, 36, texture);
   CheckError(SDL_RenderTexture9Grid(renderer,
                                     texture,
                                     srcrect,
@@ -7374,6 +7433,7 @@ inline void RenderTexture9GridTiled(RendererRef renderer,
                                     const FRectRaw& dstrect,
                                     float tileScale)
 {
+  SDL3PP_RENDER_STATS_SCOPE(renderer, RENDER_STATS_DRAW, 36, texture);
   CheckError(SDL_RenderTexture9GridTiled(renderer,
                                          texture,
                                          &srcrect,
@@ -7435,6 +7495,10 @@ inline void RenderGeometry(RendererRef renderer,
                            std::span<const Vertex> vertices,
                            std::span<const int> indices = {})
 {
+  SDL3PP_RENDER_STATS_SCOPE(renderer,
+                            RENDER_STATS_DRAW,
+                            indices.empty() ? vertices.size() : indices.size(),
+                            texture);
   CheckError(SDL_RenderGeometry(renderer,
                                 texture,
                                 vertices.data(),
@@ -7490,6 +7554,10 @@ inline void RenderGeometryRaw(RendererRef renderer,
                               int num_indices,
                               int size_indices)
 {
+  SDL3PP_RENDER_STATS_SCOPE(renderer,
+                            RENDER_STATS_DRAW,
+                            num_indices > 0 ? num_indices : num_vertices,
+                            texture);
   CheckError(SDL_RenderGeometryRaw(renderer,
                                    texture,
                                    xy,
@@ -7679,6 +7747,7 @@ inline Surface Renderer::ReadPixels(OptionalRef<const RectRaw> rect) const
  */
 inline void RenderPresent(RendererRef renderer)
 {
+  SDL3PP_RENDER_STATS_SCOPE(renderer, RENDER_STATS_PRESENT);
   CheckError(SDL_RenderPresent(renderer));
 }
 
@@ -7718,6 +7787,7 @@ inline void Texture::Destroy() { DestroyTexture(release()); }
  */
 inline void DestroyRenderer(RendererRaw renderer)
 {
+  SDL3PP_RENDER_STATS_FORGET(renderer);
   SDL_DestroyRenderer(renderer);
 }
 
@@ -7971,6 +8041,8 @@ inline void RenderDebugText(RendererRef renderer,
                             const FPointRaw& p,
                             StringParam str)
 {
+  SDL3PP_RENDER_STATS_SCOPE(
+    renderer, RENDER_STATS_DRAW, 4 * SDL_utf8strlen(str));
   CheckError(SDL_RenderDebugText(renderer, p.x, p.y, str));
 }
 
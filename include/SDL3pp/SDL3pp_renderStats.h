@@ -0,0 +1,390 @@
+#ifndef SDL3PP_RENDER_STATS_H_
+#define SDL3PP_RENDER_STATS_H_
+
+#include <algorithm>
+#include <array>
+#include <format>
+#include <memory>
+#include <vector>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_render.h>
+#include <SDL3/SDL_timer.h>
+#include "SDL3pp_stdinc.h"
+
+namespace SDL {
+
+#if defined(SDL3PP_ENABLE_RENDER_STATS) || defined(SDL3PP_DOC)
+
+/**
+ * @defgroup CategoryRenderStats Renderer statistics
+ *
+ * Count and time what each frame asks from a Renderer.
+ *
+ * This is opt-in: define SDL3PP_ENABLE_RENDER_STATS for all translation units,
+ * for example with the CMake option of the same name, and every draw, clear
+ * and state call made through the Renderer wrappers is counted and timed with
+ * GetPerformanceCounter(). Calls made directly on the C API are not seen.
+ *
+ * Counters are kept for each renderer, and closed at each Renderer.Present()
+ * into a history of the last frames:
+ *
+ * ```cpp
+ * #ifdef SDL3PP_ENABLE_RENDER_STATS
+ * auto& stats = SDL::GetRenderStats(renderer);
+ * stats.RenderOverlay(renderer, 8, 8);
+ * if (dumpRequested) stats.LogHistory();
+ * #endif
+ * renderer.Present();
+ * ```
+ *
+ * Without SDL3PP_ENABLE_RENDER_STATS nothing of this exists, and the
+ * instrumentation expands to nothing.
+ *
+ * @{
+ */
+
+/**
+ * Counters of one frame of a renderer.
+ *
+ * @sa RenderStats
+ */
+struct RenderFrameStats
+{
+  /// The frame number, counting calls to Renderer.Present()
+  Uint64 frame = 0;
+
+  /// Draw calls, of all kinds (points, lines, rects, textures, geometry and
+  /// debug text)
+  Uint32 drawCalls = 0;
+
+  /// Vertices submitted, with 4 vertices counted for each rectangle, texture
+  /// copy and debug text character
+  Uint64 vertices = 0;
+
+  /// Draw calls using a different texture than the previous textured one
+  Uint32 textureBinds = 0;
+
+  /// Calls to Renderer.SetDrawColor() and Renderer.SetDrawColorFloat()
+  Uint32 drawColorChanges = 0;
+
+  /// Calls to Renderer.SetDrawBlendMode()
+  Uint32 blendModeChanges = 0;
+
+  /// Calls to Renderer.SetTarget()
+  Uint32 targetChanges = 0;
+
+  /// Calls to Renderer.RenderClear()
+  Uint32 clears = 0;
+
+  /// Performance counter ticks spent on draw calls
+  Uint64 drawTicks = 0;
+
+  /// Performance counter ticks spent on clears and state calls
+  Uint64 stateTicks = 0;
+
+  /// Performance counter ticks spent on Renderer.Present()
+  Uint64 presentTicks = 0;
+
+  /// Performance counter ticks from the previous Renderer.Present() to the
+  /// end of this one
+  Uint64 frameTicks = 0;
+};
+
+/**
+ * Kinds of calls counted by RenderStats.
+ *
+ * @sa RenderStats.Record
+ */
+enum RenderStatsCall
+{
+  RENDER_STATS_DRAW,       ///< A draw call
+  RENDER_STATS_CLEAR,      ///< Renderer.RenderClear()
+  RENDER_STATS_DRAW_COLOR, ///< Renderer.SetDrawColor()
+  RENDER_STATS_BLEND_MODE, ///< Renderer.SetDrawBlendMode()
+  RENDER_STATS_TARGET,     ///< Renderer.SetTarget()
+  RENDER_STATS_PRESENT,    ///< Renderer.Present()
+};
+
+/**
+ * Statistics of one renderer.
+ *
+ * Get it with GetRenderStats().
+ *
+ * @threadsafety This class should only be used on the main thread.
+ */
+class RenderStats
+{
+public:
+  /// Number of frames kept in the history.
+  static constexpr size_t HISTORY_SIZE = 128;
+
+  /**
+   * Get the counters of the frame being rendered.
+   *
+   * @returns the counters.
+   */
+  const RenderFrameStats& GetCurrent() const { return m_current; }
+
+  /**
+   * Get the number of frames on the history.
+   *
+   * @returns the number of frames, up to HISTORY_SIZE.
+   */
+  size_t GetHistorySize() const
+  {
+    return size_t(std::min<Uint64>(m_current.frame, HISTORY_SIZE));
+  }
+
+  /**
+   * Get the counters of a presented frame.
+   *
+   * @param age 0 for the last presented frame, 1 for the one before and so
+   *            on, up to GetHistorySize() - 1.
+   * @returns the counters.
+   */
+  const RenderFrameStats& GetHistory(size_t age = 0) const
+  {
+    return m_history[(m_current.frame - 1 - age) % HISTORY_SIZE];
+  }
+
+  /**
+   * Log the history, oldest frame first, with SDL_LOG_CATEGORY_RENDER.
+   */
+  void LogHistory() const
+  {
+    for (size_t age = GetHistorySize(); age > 0; age--) {
+      SDL_LogInfo(
+        SDL_LOG_CATEGORY_RENDER, "%s", Format(GetHistory(age - 1)).c_str());
+    }
+  }
+
+  /**
+   * Format the counters of a frame as a single line.
+   *
+   * @param stats the counters.
+   * @returns the text.
+   */
+  static std::string Format(const RenderFrameStats& stats)
+  {
+    double ms = 1000.0 / double(SDL_GetPerformanceFrequency());
+    return std::format("frame {}: {} draws, {} vertices, {} binds, "
+                       "{} colors, {} blends, {} targets, {} clears, "
+                       "{:.3f}/{:.3f}/{:.3f} ms draw/state/present, "
+                       "{:.3f} ms frame",
+                       stats.frame,
+                       stats.drawCalls,
+                       stats.vertices,
+                       stats.textureBinds,
+                       stats.drawColorChanges,
+                       stats.blendModeChanges,
+                       stats.targetChanges,
+                       stats.clears,
+                       stats.drawTicks * ms,
+                       stats.stateTicks * ms,
+                       stats.presentTicks * ms,
+                       stats.frameTicks * ms);
+  }
+
+  /**
+   * Draw the counters of the last presented frame with SDL_RenderDebugText().
+   *
+   * The overlay itself is not counted.
+   *
+   * @param renderer the renderer.
+   * @param x the x coordinate of the top left corner.
+   * @param y the y coordinate of the top left corner.
+   */
+  void RenderOverlay(SDL_Renderer* renderer, float x, float y) const
+  {
+    if (m_current.frame == 0) return;
+    const RenderFrameStats& stats = GetHistory();
+    double ms = 1000.0 / double(SDL_GetPerformanceFrequency());
+    std::string lines[] = {
+      std::format("frame {} {:.2f} ms", stats.frame, stats.frameTicks * ms),
+      std::format("draws {} verts {} binds {}",
+                  stats.drawCalls,
+                  stats.vertices,
+                  stats.textureBinds),
+      std::format("color {} blend {} target {} clear {}",
+                  stats.drawColorChanges,
+                  stats.blendModeChanges,
+                  stats.targetChanges,
+                  stats.clears),
+      std::format("draw {:.2f} state {:.2f} present {:.2f} ms",
+                  stats.drawTicks * ms,
+                  stats.stateTicks * ms,
+                  stats.presentTicks * ms),
+    };
+    for (auto& line : lines) {
+      SDL_RenderDebugText(renderer, x, y, line.c_str());
+      y += SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE + 2;
+    }
+  }
+
+  /**
+   * Count a call.
+   *
+   * The Renderer wrappers call this, it is only needed to count calls made
+   * otherwise.
+   *
+   * @param call the kind of call.
+   * @param ticks the performance counter ticks it took.
+   * @param vertices the vertices submitted, for draw calls.
+   * @param texture the texture used, for draw calls.
+   */
+  void Record(RenderStatsCall call,
+              Uint64 ticks,
+              Uint64 vertices = 0,
+              SDL_Texture* texture = nullptr)
+  {
+    switch (call) {
+    case RENDER_STATS_DRAW:
+      m_current.drawCalls++;
+      m_current.vertices += vertices;
+      if (texture && texture != m_lastTexture) {
+        m_current.textureBinds++;
+        m_lastTexture = texture;
+      }
+      m_current.drawTicks += ticks;
+      return;
+    case RENDER_STATS_CLEAR: m_current.clears++; break;
+    case RENDER_STATS_DRAW_COLOR: m_current.drawColorChanges++; break;
+    case RENDER_STATS_BLEND_MODE: m_current.blendModeChanges++; break;
+    case RENDER_STATS_TARGET: m_current.targetChanges++; break;
+    case RENDER_STATS_PRESENT: EndFrame(ticks); return;
+    }
+    m_current.stateTicks += ticks;
+  }
+
+private:
+  RenderFrameStats m_current;
+  std::array<RenderFrameStats, HISTORY_SIZE> m_history{};
+  SDL_Texture* m_lastTexture = nullptr;
+  Uint64 m_frameStart = SDL_GetPerformanceCounter();
+
+  void EndFrame(Uint64 ticks)
+  {
+    Uint64 now = SDL_GetPerformanceCounter();
+    m_current.presentTicks = ticks;
+    m_current.frameTicks = now - m_frameStart;
+    m_frameStart = now;
+    m_history[m_current.frame % HISTORY_SIZE] = m_current;
+    m_current = {.frame = m_current.frame + 1};
+  }
+};
+
+/// @cond
+namespace detail {
+
+struct RenderStatsEntry
+{
+  SDL_Renderer* renderer;
+  std::unique_ptr<RenderStats> stats;
+};
+
+inline std::vector<RenderStatsEntry>& GetRenderStatsRegistry()
+{
+  static std::vector<RenderStatsEntry> registry;
+  return registry;
+}
+
+inline void ForgetRenderStats(SDL_Renderer* renderer)
+{
+  auto& registry = GetRenderStatsRegistry();
+  std::erase_if(registry,
+                [&](auto& entry) { return entry.renderer == renderer; });
+}
+
+} // namespace detail
+/// @endcond
+
+/**
+ * Get the statistics of a renderer.
+ *
+ * They are created on first use and released when the renderer is destroyed
+ * through the wrappers.
+ *
+ * @param renderer the renderer.
+ * @returns the statistics.
+ *
+ * @threadsafety This function should only be called on the main thread.
+ */
+inline RenderStats& GetRenderStats(SDL_Renderer* renderer)
+{
+  auto& registry = detail::GetRenderStatsRegistry();
+  for (auto& entry : registry) {
+    if (entry.renderer == renderer) return *entry.stats;
+  }
+  registry.push_back({renderer, std::make_unique<RenderStats>()});
+  return *registry.back().stats;
+}
+
+/// @cond
+namespace detail {
+
+/// Times the enclosing call and records it on destruction
+class RenderStatsScope
+{
+  SDL_Renderer* m_renderer;
+  RenderStatsCall m_call;
+  Uint64 m_vertices;
+  SDL_Texture* m_texture;
+  Uint64 m_start;
+
+public:
+  RenderStatsScope(SDL_Renderer* renderer,
+                   RenderStatsCall call,
+                   Uint64 vertices = 0,
+                   SDL_Texture* texture = nullptr)
+    : m_renderer(renderer)
+    , m_call(call)
+    , m_vertices(vertices)
+    , m_texture(texture)
+    , m_start(SDL_GetPerformanceCounter())
+  {
+  }
+
+  RenderStatsScope(const RenderStatsScope&) = delete;
+  RenderStatsScope& operator=(const RenderStatsScope&) = delete;
+
+  ~RenderStatsScope()
+  {
+    if (!m_renderer) return;
+    GetRenderStats(m_renderer)
+      .Record(m_call,
+              SDL_GetPerformanceCounter() - m_start,
+              m_vertices,
+              m_texture);
+  }
+};
+
+} // namespace detail
+/// @endcond
+
+/**
+ * Count and time the rest of the enclosing scope as a call on a renderer.
+ *
+ * @param renderer the SDL_Renderer.
+ * @param ... the RenderStatsCall, followed by the number of vertices and the
+ *            SDL_Texture for draw calls.
+ */
+#define SDL3PP_RENDER_STATS_SCOPE(renderer, ...)                               \
+  SDL::detail::RenderStatsScope sdl3ppRenderStatsScope(renderer, __VA_ARGS__)
+
+/// Forget the statistics of a renderer being destroyed.
+#define SDL3PP_RENDER_STATS_FORGET(renderer)                                   \
+  SDL::detail::ForgetRenderStats(renderer)
+
+/// @}
+
+#else // defined(SDL3PP_ENABLE_RENDER_STATS) || defined(SDL3PP_DOC)
+
+#define SDL3PP_RENDER_STATS_SCOPE(renderer, ...) ((void)0)
+
+#define SDL3PP_RENDER_STATS_FORGET(renderer) ((void)0)
+
+#endif // defined(SDL3PP_ENABLE_RENDER_STATS) || defined(SDL3PP_DOC)
+
+} // namespace SDL
+
+#endif /* SDL3PP_RENDER_STATS_H_ */
@@ -0,0 +1,938 @@
+#ifndef SDL3PP_SHAPE_BATCH_H_
+#define SDL3PP_SHAPE_BATCH_H_
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+#include "SDL3pp_render.h"
+
+namespace SDL {
+
+/**
+ * @defgroup CategoryShapeBatch Shape batching
+ *
+ * Draw anti-aliased circles, arcs, rounded rectangles and thick lines.
+ *
+ * The renderer only draws points, one pixel lines and rectangles. Anything
+ * else has to be tessellated into triangles and drawn with
+ * Renderer.RenderGeometry(). ShapeTessellator does the tessellation, with an
+ * optional one pixel wide fringe fading to transparent for anti-aliasing.
+ * ShapeBatch memoizes the resulting meshes by shape parameters and draws all
+ * shapes queued on a frame with one call:
+ *
+ * ```cpp
+ * SDL::ShapeBatch shapes{renderer};
+ *
+ * // each frame
+ * shapes.SetColor({0.2f, 0.6f, 1, 1});
+ * shapes.FillRoundedRect({10, 10, 200, 80}, 12);
+ * shapes.SetColor({1, 1, 1, 1});
+ * shapes.StrokeArc({110, 50}, 30, -90, 180, 4);
+ * shapes.StrokePolyline(path, 2.5f);
+ * shapes.Flush();
+ * ```
+ *
+ * Meshes are kept in local coordinates, so moving a shape still hits the
+ * cache. Only changing its size or form does not.
+ *
+ * @{
+ */
+
+/**
+ * Triangles of a tessellated shape.
+ *
+ * Vertices are white, with alpha holding the coverage, 1 inside the shape and
+ * fading to 0 on the anti-aliasing fringe.
+ *
+ * @sa ShapeTessellator
+ */
+struct ShapeMesh
+{
+  /// The vertices.
+  std::vector<Vertex> vertices;
+
+  /// Indices into vertices, three per triangle.
+  std::vector<int> indices;
+
+  /// Remove all vertices and indices.
+  void clear()
+  {
+    vertices.clear();
+    indices.clear();
+  }
+};
+
+/**
+ * How thick lines are joined at their inner points.
+ *
+ * @sa ShapeTessellator.SetLineJoin
+ */
+enum LineJoin
+{
+  /// Extend the outer edges until they meet, up to the miter limit.
+  LINE_JOIN_MITER,
+
+  /// Cut the corner with a straight edge.
+  LINE_JOIN_BEVEL,
+
+  /// Round the corner.
+  LINE_JOIN_ROUND,
+};
+
+/**
+ * Tessellates shapes into ShapeMesh.
+ *
+ * Every function appends to the mesh passed, so several shapes can share a
+ * mesh. Angles are in degrees, clockwise from the positive x axis, as in
+ * Renderer.RenderTextureRotated().
+ *
+ * Curves get as many segments as needed to stay within the tolerance of the
+ * exact curve.
+ */
+class ShapeTessellator
+{
+  /// Width of the anti-aliasing fringe, in pixels.
+  static constexpr float FRINGE = 1;
+
+  bool m_antiAlias = true;
+  LineJoin m_join = LINE_JOIN_MITER;
+  float m_miterLimit = 4;
+  float m_tolerance = 0.25f;
+  std::vector<FPoint> m_points;
+  std::vector<FPoint> m_normals;
+
+public:
+  /**
+   * Set whether shapes get an anti-aliasing fringe.
+   *
+   * @param antiAlias true to anti-alias, the default.
+   */
+  void SetAntiAlias(bool antiAlias) { m_antiAlias = antiAlias; }
+
+  /**
+   * Get whether shapes get an anti-aliasing fringe.
+   *
+   * @returns true if anti-aliasing.
+   */
+  bool GetAntiAlias() const { return m_antiAlias; }
+
+  /**
+   * Set how thick lines are joined.
+   *
+   * @param join the join, LINE_JOIN_MITER by default.
+   */
+  void SetLineJoin(LineJoin join) { m_join = join; }
+
+  /**
+   * Get how thick lines are joined.
+   *
+   * @returns the join.
+   */
+  LineJoin GetLineJoin() const { return m_join; }
+
+  /**
+   * Set the miter limit.
+   *
+   * Miter joins longer than this, as a multiple of half the line thickness,
+   * are beveled instead.
+   *
+   * @param limit the limit, 4 by default.
+   */
+  void SetMiterLimit(float limit) { m_miterLimit = std::max(limit, 1.f); }
+
+  /**
+   * Get the miter limit.
+   *
+   * @returns the limit.
+   */
+  float GetMiterLimit() const { return m_miterLimit; }
+
+  /**
+   * Set the maximum distance between curves and their segments.
+   *
+   * @param tolerance the distance in pixels, 0.25 by default.
+   */
+  void SetTolerance(float tolerance)
+  {
+    m_tolerance = std::max(tolerance, 0.01f);
+  }
+
+  /**
+   * Get the maximum distance between curves and their segments.
+   *
+   * @returns the distance in pixels.
+   */
+  float GetTolerance() const { return m_tolerance; }
+
+  /**
+   * Tessellate a filled circle centered at the origin.
+   *
+   * @param mesh the mesh to append to.
+   * @param radius the radius.
+   */
+  void FillCircle(ShapeMesh& mesh, float radius)
+  {
+    CirclePoints(radius);
+    FillPath(mesh);
+  }
+
+  /**
+   * Tessellate the outline of a circle centered at the origin.
+   *
+   * @param mesh the mesh to append to.
+   * @param radius the radius, at the middle of the line.
+   * @param thickness the line thickness.
+   */
+  void StrokeCircle(ShapeMesh& mesh, float radius, float thickness)
+  {
+    CirclePoints(radius);
+    StrokePath(mesh, thickness, true);
+  }
+
+  /**
+   * Tessellate an arc centered at the origin.
+   *
+   * @param mesh the mesh to append to.
+   * @param radius the radius, at the middle of the line.
+   * @param startAngle the angle where the arc starts.
+   * @param endAngle the angle where the arc ends, it can be less than
+   *                 startAngle to go counter clockwise.
+   * @param thickness the line thickness.
+   */
+  void StrokeArc(ShapeMesh& mesh,
+                 float radius,
+                 float startAngle,
+                 float endAngle,
+                 float thickness)
+  {
+    float span = (endAngle - startAngle) * SDL_PI_F / 180;
+    if (std::abs(span) >= 2 * SDL_PI_F) {
+      StrokeCircle(mesh, radius, thickness);
+      return;
+    }
+    float start = startAngle * SDL_PI_F / 180;
+    int count = Segments(radius, std::abs(span));
+    m_points.clear();
+    for (int i = 0; i <= count; i++) {
+      float angle = start + span * float(i) / float(count);
+      m_points.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+    }
+    StrokePath(mesh, thickness, false);
+  }
+
+  /**
+   * Tessellate a filled rounded rectangle with its top left corner at the
+   * origin.
+   *
+   * @param mesh the mesh to append to.
+   * @param size the width and height.
+   * @param radius the corner radius, clamped to half the smaller side.
+   */
+  void FillRoundedRect(ShapeMesh& mesh, const FPointRaw& size, float radius)
+  {
+    RoundedRectPoints(size, radius);
+    FillPath(mesh);
+  }
+
+  /**
+   * Tessellate the outline of a rounded rectangle with its top left corner at
+   * the origin.
+   *
+   * @param mesh the mesh to append to.
+   * @param size the width and height, at the middle of the line.
+   * @param radius the corner radius, clamped to half the smaller side.
+   * @param thickness the line thickness.
+   */
+  void StrokeRoundedRect(ShapeMesh& mesh,
+                         const FPointRaw& size,
+                         float radius,
+                         float thickness)
+  {
+    RoundedRectPoints(size, radius);
+    StrokePath(mesh, thickness, true);
+  }
+
+  /**
+   * Tessellate a thick polyline.
+   *
+   * Inner points are joined as set by SetLineJoin(), open ends are cut square
+   * at the end points.
+   *
+   * @param mesh the mesh to append to.
+   * @param points the points.
+   * @param thickness the line thickness.
+   * @param closed true to join the last point back to the first one.
+   */
+  void StrokePolyline(ShapeMesh& mesh,
+                      SpanRef<const FPointRaw> points,
+                      float thickness,
+                      bool closed = false)
+  {
+    m_points.assign(points.data(), points.data() + points.size());
+    StrokePath(mesh, thickness, closed);
+  }
+
+  /**
+   * Tessellate a filled convex polygon.
+   *
+   * @param mesh the mesh to append to.
+   * @param points the points, in either winding order.
+   */
+  void FillConvex(ShapeMesh& mesh, SpanRef<const FPointRaw> points)
+  {
+    m_points.assign(points.data(), points.data() + points.size());
+    FillPath(mesh);
+  }
+
+private:
+  static FPoint Normalize(const FPoint& v)
+  {
+    float length = std::sqrt(v.x * v.x + v.y * v.y);
+    return length > 0 ? v / length : FPoint{};
+  }
+
+  static float Dot(const FPoint& a, const FPoint& b)
+  {
+    return a.x * b.x + a.y * b.y;
+  }
+
+  static float Cross(const FPoint& a, const FPoint& b)
+  {
+    return a.x * b.y - a.y * b.x;
+  }
+
+  static int Add(ShapeMesh& mesh, const FPoint& p, float coverage)
+  {
+    mesh.vertices.push_back({p, {1, 1, 1, coverage}, {0, 0}});
+    return int(mesh.vertices.size() - 1);
+  }
+
+  static void Triangle(ShapeMesh& mesh, int a, int b, int c)
+  {
+    mesh.indices.insert(mesh.indices.end(), {a, b, c});
+  }
+
+  static void Quad(ShapeMesh& mesh, int a, int b, int c, int d)
+  {
+    mesh.indices.insert(mesh.indices.end(), {a, b, c, a, c, d});
+  }
+
+  int Segments(float radius, float span) const
+  {
+    int full = 8;
+    if (radius > m_tolerance) {
+      float step = 2 * std::acos(1 - m_tolerance / radius);
+      full = std::clamp(int(std::ceil(2 * SDL_PI_F / step)), 8, 1024);
+    }
+    return std::max(1, int(std::ceil(float(full) * span / (2 * SDL_PI_F))));
+  }
+
+  void CirclePoints(float radius)
+  {
+    int count = Segments(radius, 2 * SDL_PI_F);
+    m_points.clear();
+    for (int i = 0; i < count; i++) {
+      float angle = 2 * SDL_PI_F * float(i) / float(count);
+      m_points.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+    }
+  }
+
+  void RoundedRectPoints(const FPointRaw& size, float radius)
+  {
+    float r = std::clamp(radius, 0.f, std::min(size.x, size.y) / 2);
+    FPoint centers[] = {
+      {size.x - r, r}, {size.x - r, size.y - r}, {r, size.y - r}, {r, r}};
+    int count = r > 0 ? Segments(r, SDL_PI_F / 2) : 0;
+    m_points.clear();
+    for (int corner = 0; corner < 4; corner++) {
+      for (int i = 0; i <= count; i++) {
+        float angle = SDL_PI_F / 2 * (float(corner - 1) +
+                                      (count ? float(i) / float(count) : 0));
+        m_points.push_back(centers[corner] +
+                           FPoint(std::cos(angle), std::sin(angle)) * r);
+      }
+    }
+  }
+
+  void RemoveDuplicates(bool closed)
+  {
+    auto same = [](const FPoint& a, const FPoint& b) {
+      return std::abs(a.x - b.x) < 1e-4f && std::abs(a.y - b.y) < 1e-4f;
+    };
+    m_points.erase(std::unique(m_points.begin(), m_points.end(), same),
+                   m_points.end());
+    while (closed && m_points.size() > 1 &&
+           same(m_points.front(), m_points.back())) {
+      m_points.pop_back();
+    }
+  }
+
+  void FillPath(ShapeMesh& mesh)
+  {
+    RemoveDuplicates(true);
+    int n = int(m_points.size());
+    if (n < 3) return;
+    int base = int(mesh.vertices.size());
+    if (!m_antiAlias) {
+      for (auto& p : m_points) Add(mesh, p, 1);
+      for (int i = 1; i + 1 < n; i++) {
+        Triangle(mesh, base, base + i, base + i + 1);
+      }
+      return;
+    }
+
+    // Outward vertex normals, scaled so the fringe keeps its width at corners
+    float area = 0;
+    for (int i = 0; i < n; i++) {
+      area += Cross(m_points[i], m_points[(i + 1) % n]);
+    }
+    float outward = area >= 0 ? 1 : -1;
+    m_normals.resize(n);
+    for (int i = 0; i < n; i++) {
+      FPoint d = Normalize(m_points[(i + 1) % n] - m_points[i]);
+      m_normals[i] = FPoint(d.y, -d.x) * outward;
+    }
+    for (int i = 0; i < n; i++) {
+      const FPoint& prev = m_normals[(i + n - 1) % n];
+      const FPoint& next = m_normals[i];
+      FPoint m = Normalize(prev + next);
+      m *= FRINGE / 2 / std::max(Dot(m, next), 0.25f);
+      Add(mesh, m_points[i] - m, 1);
+      Add(mesh, m_points[i] + m, 0);
+    }
+    for (int i = 1; i + 1 < n; i++) {
+      Triangle(mesh, base, base + 2 * i, base + 2 * i + 2);
+    }
+    for (int i = 0; i < n; i++) {
+      int j = (i + 1) % n;
+      Quad(
+        mesh, base + 2 * i, base + 2 * j, base + 2 * j + 1, base + 2 * i + 1);
+    }
+  }
+
+  void StrokePath(ShapeMesh& mesh, float thickness, bool closed)
+  {
+    RemoveDuplicates(closed);
+    int n = int(m_points.size());
+    if (n < 2 || thickness <= 0) return;
+    if (n == 2) closed = false;
+
+    float half = thickness / 2;
+    float core = half, outer = half, alpha = 1;
+    if (m_antiAlias) {
+      core = std::max(half - FRINGE / 2, 0.f);
+      outer = half + FRINGE / 2;
+      alpha = std::min(thickness / FRINGE, 1.f);
+    }
+
+    int segments = closed ? n : n - 1;
+    for (int i = 0; i < segments; i++) {
+      FPoint a = m_points[i];
+      FPoint b = m_points[(i + 1) % n];
+      FPoint d = Normalize(b - a);
+      FPoint normal{-d.y, d.x};
+      int v = Add(mesh, a + normal * core, alpha);
+      Add(mesh, b + normal * core, alpha);
+      Add(mesh, b - normal * core, alpha);
+      Add(mesh, a - normal * core, alpha);
+      if (core > 0) Quad(mesh, v, v + 1, v + 2, v + 3);
+      if (!m_antiAlias) continue;
+
+      int o = Add(mesh, a + normal * outer, 0);
+      Add(mesh, b + normal * outer, 0);
+      Add(mesh, b - normal * outer, 0);
+      Add(mesh, a - normal * outer, 0);
+      Quad(mesh, v, v + 1, o + 1, o);
+      Quad(mesh, v + 3, v + 2, o + 2, o + 3);
+      if (closed) continue;
+      if (i == 0) Cap(mesh, a, -d, normal, core, outer, v, v + 3, o, o + 3);
+      if (i == segments - 1) {
+        Cap(mesh, b, d, normal, core, outer, v + 1, v + 2, o + 1, o + 2);
+      }
+    }
+
+    for (int i = closed ? 0 : 1; i < (closed ? n : n - 1); i++) {
+      Join(mesh,
+           m_points[(i + n - 1) % n],
+           m_points[i],
+           m_points[(i + 1) % n],
+           core,
+           outer,
+           alpha);
+    }
+  }
+
+  /// Fringe past an open end, from the existing side vertices
+  void Cap(ShapeMesh& mesh,
+           const FPoint& p,
+           const FPoint& forward,
+           const FPoint& normal,
+           float core,
+           float outer,
+           int corePlus,
+           int coreMinus,
+           int outerPlus,
+           int outerMinus)
+  {
+    FPoint tip = p + forward * FRINGE;
+    int v = Add(mesh, tip + normal * core, 0);
+    Add(mesh, tip - normal * core, 0);
+    Add(mesh, tip + normal * outer, 0);
+    Add(mesh, tip - normal * outer, 0);
+    Quad(mesh, corePlus, coreMinus, v + 1, v);
+    Quad(mesh, corePlus, v, v + 2, outerPlus);
+    Quad(mesh, coreMinus, outerMinus, v + 3, v + 1);
+  }
+
+  /// Fills the gap on the outer side of a turn
+  void Join(ShapeMesh& mesh,
+            const FPoint& prev,
+            const FPoint& p,
+            const FPoint& next,
+            float core,
+            float outer,
+            float alpha)
+  {
+    FPoint d0 = Normalize(p - prev);
+    FPoint d1 = Normalize(next - p);
+    float cross = Cross(d0, d1);
+    if (std::abs(cross) < 1e-4f && Dot(d0, d1) > 0) return;
+    float side = cross > 0 ? -1 : 1;
+    FPoint o0 = FPoint(-d0.y, d0.x) * side;
+    FPoint o1 = FPoint(-d1.y, d1.x) * side;
+
+    m_normals.clear();
+    m_normals.push_back(o0);
+    if (m_join == LINE_JOIN_ROUND) {
+      float angle = std::atan2(Cross(o0, o1), Dot(o0, o1));
+      int count = Segments(outer, std::abs(angle));
+      for (int i = 1; i < count; i++) {
+        float a = angle * float(i) / float(count);
+        float c = std::cos(a), s = std::sin(a);
+        m_normals.emplace_back(o0.x * c - o0.y * s, o0.x * s + o0.y * c);
+      }
+    } else if (m_join == LINE_JOIN_MITER) {
+      FPoint m = Normalize(o0 + o1);
+      float c = Dot(m, o0);
+      if (c * m_miterLimit >= 1) m_normals.push_back(m / c);
+    }
+    m_normals.push_back(o1);
+
+    int count = int(m_normals.size());
+    int center = Add(mesh, p, alpha);
+    int v = int(mesh.vertices.size());
+    for (auto& dir : m_normals) Add(mesh, p + dir * core, alpha);
+    for (int i = 0; core > 0 && i + 1 < count; i++) {
+      Triangle(mesh, center, v + i, v + i + 1);
+    }
+    if (!m_antiAlias) return;
+    int o = int(mesh.vertices.size());
+    for (auto& dir : m_normals) Add(mesh, p + dir * outer, 0);
+    for (int i = 0; i + 1 < count; i++) {
+      Quad(mesh, v + i, v + i + 1, o + i + 1, o + i);
+    }
+  }
+};
+
+/**
+ * Counters of a ShapeBatch.
+ *
+ * @sa ShapeBatch.GetStats
+ */
+struct ShapeBatchStats
+{
+  /// Shapes drawn
+  Uint64 shapes = 0;
+
+  /// Shapes whose mesh was found on the cache
+  Uint64 cacheHits = 0;
+
+  /// Shapes that had to be tessellated
+  Uint64 cacheMisses = 0;
+
+  /// Meshes dropped from the cache after going unused
+  Uint64 evicted = 0;
+
+  /// Vertices submitted
+  Uint64 vertices = 0;
+
+  /// Calls to Renderer.RenderGeometry()
+  Uint64 drawCalls = 0;
+};
+
+/**
+ * Accumulates shapes and draws them with Renderer.RenderGeometry().
+ *
+ * Meshes are memoized by shape kind, parameters and tessellator settings, in
+ * coordinates relative to the shape position. Meshes not used for a number of
+ * flushes are dropped from the cache.
+ *
+ * Nothing is drawn until Flush() is called. Pending shapes are discarded when
+ * the batch is destroyed.
+ *
+ * @threadsafety This class should only be used on the main thread.
+ */
+class ShapeBatch
+{
+  enum Kind
+  {
+    FILL_CIRCLE,
+    STROKE_CIRCLE,
+    STROKE_ARC,
+    FILL_ROUNDED_RECT,
+    STROKE_ROUNDED_RECT,
+    STROKE_POLYLINE,
+    FILL_CONVEX,
+  };
+
+  struct Entry
+  {
+    ShapeMesh mesh;
+    Uint64 lastUsed;
+  };
+
+  struct KeyHash
+  {
+    size_t operator()(const std::vector<float>& key) const
+    {
+      Uint64 hash = 14695981039346656037ull;
+      for (float value : key) {
+        hash = (hash ^ std::bit_cast<Uint32>(value)) * 1099511628211ull;
+      }
+      return size_t(hash);
+    }
+  };
+
+  RendererRef m_renderer;
+  ShapeTessellator m_tessellator;
+  std::unordered_map<std::vector<float>, Entry, KeyHash> m_cache;
+  std::vector<float> m_key;
+  std::vector<FPoint> m_relative;
+  std::vector<Vertex> m_vertices;
+  std::vector<int> m_indices;
+  FColor m_color{1, 1, 1, 1};
+  BlendMode m_blendMode = BLENDMODE_BLEND;
+  Uint64 m_frame = 0;
+  Uint64 m_keepFrames = 60;
+  ShapeBatchStats m_stats;
+
+public:
+  /**
+   * Create the batch.
+   *
+   * @param renderer the renderer to draw to.
+   */
+  explicit ShapeBatch(RendererRef renderer)
+    : m_renderer(renderer)
+  {
+  }
+
+  ShapeBatch(const ShapeBatch&) = delete;
+  ShapeBatch& operator=(const ShapeBatch&) = delete;
+
+  /**
+   * Get the tessellator, to change anti-aliasing, joins and tolerance.
+   *
+   * @returns the tessellator.
+   */
+  ShapeTessellator& GetTessellator() { return m_tessellator; }
+
+  /**
+   * Set the color of the shapes drawn next.
+   *
+   * @param color the color, white by default.
+   */
+  void SetColor(const FColorRaw& color) { m_color = color; }
+
+  /**
+   * Get the color of the shapes drawn next.
+   *
+   * @returns the color.
+   */
+  const FColor& GetColor() const { return m_color; }
+
+  /**
+   * Set the blend mode used to draw.
+   *
+   * Anti-aliasing needs blending, the renderer draw blend mode is replaced by
+   * this one during Flush().
+   *
+   * @param blendMode the blend mode, BLENDMODE_BLEND by default.
+   */
+  void SetBlendMode(BlendMode blendMode) { m_blendMode = blendMode; }
+
+  /**
+   * Get the blend mode used to draw.
+   *
+   * @returns the blend mode.
+   */
+  BlendMode GetBlendMode() const { return m_blendMode; }
+
+  /**
+   * Set for how many flushes unused meshes are kept on the cache.
+   *
+   * @param frames the number of flushes, 0 keeps only the meshes drawn on the
+   *               last frame.
+   */
+  void SetCacheFrames(Uint64 frames) { m_keepFrames = frames; }
+
+  /**
+   * Get the number of meshes on the cache.
+   *
+   * @returns the number of meshes.
+   */
+  size_t GetCacheSize() const { return m_cache.size(); }
+
+  /**
+   * Queue a filled circle.
+   *
+   * @param center the center.
+   * @param radius the radius.
+   */
+  void FillCircle(const FPointRaw& center, float radius)
+  {
+    BeginKey(FILL_CIRCLE, {radius});
+    Emit(center,
+         [&](ShapeMesh& mesh) { m_tessellator.FillCircle(mesh, radius); });
+  }
+
+  /**
+   * Queue the outline of a circle.
+   *
+   * @param center the center.
+   * @param radius the radius, at the middle of the line.
+   * @param thickness the line thickness.
+   */
+  void StrokeCircle(const FPointRaw& center, float radius, float thickness)
+  {
+    BeginKey(STROKE_CIRCLE, {radius, thickness});
+    Emit(center, [&](ShapeMesh& mesh) {
+      m_tessellator.StrokeCircle(mesh, radius, thickness);
+    });
+  }
+
+  /**
+   * Queue an arc.
+   *
+   * @param center the center.
+   * @param radius the radius, at the middle of the line.
+   * @param startAngle the angle where the arc starts, in degrees clockwise
+   *                   from the positive x axis.
+   * @param endAngle the angle where the arc ends.
+   * @param thickness the line thickness.
+   */
+  void StrokeArc(const FPointRaw& center,
+                 float radius,
+                 float startAngle,
+                 float endAngle,
+                 float thickness)
+  {
+    BeginKey(STROKE_ARC, {radius, startAngle, endAngle, thickness});
+    Emit(center, [&](ShapeMesh& mesh) {
+      m_tessellator.StrokeArc(mesh, radius, startAngle, endAngle, thickness);
+    });
+  }
+
+  /**
+   * Queue a filled rounded rectangle.
+   *
+   * @param rect the rectangle.
+   * @param radius the corner radius.
+   */
+  void FillRoundedRect(const FRectRaw& rect, float radius)
+  {
+    BeginKey(FILL_ROUNDED_RECT, {rect.w, rect.h, radius});
+    Emit({rect.x, rect.y}, [&](ShapeMesh& mesh) {
+      m_tessellator.FillRoundedRect(mesh, {rect.w, rect.h}, radius);
+    });
+  }
+
+  /**
+   * Queue the outline of a rounded rectangle.
+   *
+   * @param rect the rectangle, at the middle of the line.
+   * @param radius the corner radius.
+   * @param thickness the line thickness.
+   */
+  void StrokeRoundedRect(const FRectRaw& rect, float radius, float thickness)
+  {
+    BeginKey(STROKE_ROUNDED_RECT, {rect.w, rect.h, radius, thickness});
+    Emit({rect.x, rect.y}, [&](ShapeMesh& mesh) {
+      m_tessellator.StrokeRoundedRect(
+        mesh, {rect.w, rect.h}, radius, thickness);
+    });
+  }
+
+  /**
+   * Queue a thick polyline.
+   *
+   * @param points the points.
+   * @param thickness the line thickness.
+   * @param closed true to join the last point back to the first one.
+   */
+  void StrokePolyline(SpanRef<const FPointRaw> points,
+                      float thickness,
+                      bool closed = false)
+  {
+    if (points.size() == 0) return;
+    BeginKey(STROKE_POLYLINE, {thickness, float(closed)});
+    FPoint origin = points.data()[0];
+    Relative(points, origin);
+    Emit(origin, [&](ShapeMesh& mesh) {
+      m_tessellator.StrokePolyline(mesh, m_relative, thickness, closed);
+    });
+  }
+
+  /**
+   * Queue a filled convex polygon.
+   *
+   * @param points the points, in either winding order.
+   */
+  void FillConvex(SpanRef<const FPointRaw> points)
+  {
+    if (points.size() == 0) return;
+    BeginKey(FILL_CONVEX, {});
+    FPoint origin = points.data()[0];
+    Relative(points, origin);
+    Emit(origin,
+         [&](ShapeMesh& mesh) { m_tessellator.FillConvex(mesh, m_relative); });
+  }
+
+  /**
+   * Get the number of vertices queued.
+   *
+   * @returns the number of vertices.
+   */
+  size_t size() const { return m_vertices.size(); }
+
+  /**
+   * Check if nothing is queued.
+   *
+   * @returns true if empty.
+   */
+  bool empty() const { return m_vertices.empty(); }
+
+  /// Discard queued shapes, keeping the cache.
+  void clear()
+  {
+    m_vertices.clear();
+    m_indices.clear();
+  }
+
+  /**
+   * Draw all queued shapes with one Renderer.RenderGeometry() call.
+   *
+   * This also ends a frame for the cache, dropping the meshes that went
+   * unused for too long.
+   *
+   * @throws Error on failure. Queued shapes are discarded anyway.
+   */
+  void Flush()
+  {
+    struct Cleanup
+    {
+      ShapeBatch* self;
+      ~Cleanup()
+      {
+        self->clear();
+        self->Evict();
+      }
+    } cleanup{this};
+
+    if (m_indices.empty()) return;
+    m_stats.drawCalls++;
+    m_stats.vertices += m_vertices.size();
+    BlendMode previous = GetRenderDrawBlendMode(m_renderer);
+    bool swapBlendMode = previous != m_blendMode;
+    if (swapBlendMode) SetRenderDrawBlendMode(m_renderer, m_blendMode);
+    bool ok;
+    {
+      SDL3PP_RENDER_STATS_SCOPE(
+        m_renderer, RENDER_STATS_DRAW, m_indices.size(), nullptr);
+      ok = SDL_RenderGeometry(m_renderer,
+                              nullptr,
+                              m_vertices.data(),
+                              narrowS32(m_vertices.size()),
+                              m_indices.data(),
+                              narrowS32(m_indices.size()));
+    }
+    if (swapBlendMode) SDL_SetRenderDrawBlendMode(m_renderer, previous);
+    CheckError(ok);
+  }
+
+  /**
+   * Get the counters.
+   *
+   * @returns the counters since creation or the last ResetStats().
+   */
+  const ShapeBatchStats& GetStats() const { return m_stats; }
+
+  /// Reset the counters.
+  void ResetStats() { m_stats = {}; }
+
+private:
+  void BeginKey(Kind kind, std::initializer_list<float> params)
+  {
+    m_key.clear();
+    m_key.insert(m_key.end(),
+                 {float(kind),
+                  float(m_tessellator.GetAntiAlias()),
+                  float(m_tessellator.GetLineJoin()),
+                  m_tessellator.GetMiterLimit(),
+                  m_tessellator.GetTolerance()});
+    m_key.insert(m_key.end(), params);
+  }
+
+  void Relative(SpanRef<const FPointRaw> points, const FPoint& origin)
+  {
+    m_relative.clear();
+    for (size_t i = 0; i < points.size(); i++) {
+      FPoint p = FPoint(points.data()[i]) - origin;
+      m_relative.push_back(p);
+      m_key.insert(m_key.end(), {p.x, p.y});
+    }
+  }
+
+  template<class TESSELLATE>
+  void Emit(const FPointRaw& offset, TESSELLATE tessellate)
+  {
+    m_stats.shapes++;
+    auto it = m_cache.find(m_key);
+    if (it == m_cache.end()) {
+      m_stats.cacheMisses++;
+      ShapeMesh mesh;
+      tessellate(mesh);
+      it = m_cache.emplace(m_key, Entry{std::move(mesh), 0}).first;
+    } else {
+      m_stats.cacheHits++;
+    }
+    Entry& entry = it->second;
+    entry.lastUsed = m_frame;
+
+    int base = int(m_vertices.size());
+    for (Vertex vertex : entry.mesh.vertices) {
+      vertex.position.x += offset.x;
+      vertex.position.y += offset.y;
+      vertex.color = {
+        m_color.r, m_color.g, m_color.b, m_color.a * vertex.color.a};
+      m_vertices.push_back(vertex);
+    }
+    for (int index : entry.mesh.indices) m_indices.push_back(base + index);
+  }
+
+  void Evict()
+  {
+    m_frame++;
+    m_stats.evicted += std::erase_if(m_cache, [&](auto& entry) {
+      return m_frame - entry.second.lastUsed > m_keepFrames + 1;
+    });
+  }
+};
+
+/// @}
+
+} // namespace SDL
+
+#endif /* SDL3PP_SHAPE_BATCH_H_ */
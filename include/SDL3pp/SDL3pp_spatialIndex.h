@@ -0,0 +1,670 @@
+#ifndef SDL3PP_SPATIAL_INDEX_H_
+#define SDL3PP_SPATIAL_INDEX_H_
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+#include "SDL3pp_rect.h"
+
+namespace SDL {
+
+/**
+ * @defgroup CategorySpatialIndex Spatial index
+ *
+ * Find the rectangles overlapping an area or a point without testing them all.
+ *
+ * Culling or hit testing with FRect.HasIntersection() or FPoint.InRect() over
+ * every object is linear on the number of objects. Two indexes are offered,
+ * with the same interface:
+ *
+ * - SpatialGrid buckets rectangles on a uniform grid. It is the fastest when
+ *   objects have similar sizes, and the cell size is close to them.
+ * - AABBTree keeps a balanced tree of bounding boxes. It adapts to any mix of
+ *   sizes and distributions.
+ *
+ * ```cpp
+ * SDL::AABBTree index;
+ * for (auto& sprite : sprites) sprite.handle = index.Insert(sprite.rect);
+ *
+ * // when a sprite moves
+ * index.Move(sprite.handle, sprite.rect);
+ *
+ * // each frame
+ * visible.clear();
+ * index.Query(camera, visible);
+ * ```
+ *
+ * Results are exactly those of HasRectIntersectionFloat() and
+ * PointInRectFloat(), in no particular order. Rect converts implicitly to
+ * FRect, so integer rectangles can be used too.
+ *
+ * @{
+ */
+
+/**
+ * Identifies a rectangle on a SpatialGrid or AABBTree.
+ *
+ * Handles of removed rectangles are reused.
+ */
+using SpatialHandle = Uint32;
+
+/**
+ * Spatial index bucketing rectangles on a uniform grid.
+ *
+ * Only cells holding rectangles take memory, so the grid is unbounded.
+ * Rectangles are on every cell they touch.
+ *
+ * @threadsafety Queries can run concurrently, modifications need exclusive
+ *               access.
+ */
+class SpatialGrid
+{
+  struct Item
+  {
+    FRect rect;
+    int x0, y0, x1, y1;
+    bool used;
+  };
+
+  float m_cellSize;
+  std::unordered_map<Uint64, std::vector<SpatialHandle>> m_cells;
+  std::vector<Item> m_items;
+  std::vector<SpatialHandle> m_free;
+  int m_minX = 0, m_minY = 0, m_maxX = -1, m_maxY = -1;
+
+public:
+  /**
+   * Create an empty grid.
+   *
+   * @param cellSize the width and height of each cell.
+   */
+  explicit SpatialGrid(float cellSize = 64)
+    : m_cellSize(cellSize > 0 ? cellSize : 64)
+  {
+  }
+
+  /**
+   * Get the cell size.
+   *
+   * @returns the width and height of each cell.
+   */
+  float GetCellSize() const { return m_cellSize; }
+
+  /**
+   * Add a rectangle.
+   *
+   * @param rect the rectangle.
+   * @returns the handle to move, remove or identify it on query results.
+   */
+  SpatialHandle Insert(const FRectRaw& rect)
+  {
+    SpatialHandle handle;
+    if (m_free.empty()) {
+      handle = SpatialHandle(m_items.size());
+      m_items.emplace_back();
+    } else {
+      handle = m_free.back();
+      m_free.pop_back();
+    }
+    Item& item = m_items[handle];
+    item.rect = rect;
+    item.used = true;
+    CellRange(rect, item.x0, item.y0, item.x1, item.y1);
+    Link(handle);
+    return handle;
+  }
+
+  /**
+   * Change the rectangle of a handle.
+   *
+   * @param handle the handle, as returned by Insert().
+   * @param rect the new rectangle.
+   */
+  void Move(SpatialHandle handle, const FRectRaw& rect)
+  {
+    Item& item = m_items[handle];
+    item.rect = rect;
+    int x0, y0, x1, y1;
+    CellRange(rect, x0, y0, x1, y1);
+    if (x0 == item.x0 && y0 == item.y0 && x1 == item.x1 && y1 == item.y1) {
+      return;
+    }
+    Unlink(handle);
+    item.x0 = x0;
+    item.y0 = y0;
+    item.x1 = x1;
+    item.y1 = y1;
+    Link(handle);
+  }
+
+  /**
+   * Remove a rectangle.
+   *
+   * @param handle the handle, as returned by Insert(). It may be reused by
+   *               later insertions.
+   */
+  void Remove(SpatialHandle handle)
+  {
+    Unlink(handle);
+    m_items[handle].used = false;
+    m_free.push_back(handle);
+  }
+
+  /**
+   * Get the rectangle of a handle.
+   *
+   * @param handle the handle, as returned by Insert().
+   * @returns the rectangle.
+   */
+  const FRect& GetRect(SpatialHandle handle) const
+  {
+    return m_items[handle].rect;
+  }
+
+  /**
+   * Get the number of rectangles.
+   *
+   * @returns the number of rectangles.
+   */
+  size_t size() const { return m_items.size() - m_free.size(); }
+
+  /// Remove all rectangles.
+  void clear()
+  {
+    m_cells.clear();
+    m_items.clear();
+    m_free.clear();
+    m_minX = m_minY = 0;
+    m_maxX = m_maxY = -1;
+  }
+
+  /**
+   * Find the rectangles intersecting an area.
+   *
+   * @param area the area.
+   * @param results where the handles of intersecting rectangles are appended.
+   */
+  void Query(const FRectRaw& area, std::vector<SpatialHandle>& results) const
+  {
+    int x0, y0, x1, y1;
+    CellRange(area, x0, y0, x1, y1);
+    x0 = std::max(x0, m_minX);
+    y0 = std::max(y0, m_minY);
+    x1 = std::min(x1, m_maxX);
+    y1 = std::min(y1, m_maxY);
+    for (int y = y0; y <= y1; y++) {
+      for (int x = x0; x <= x1; x++) {
+        auto it = m_cells.find(Key(x, y));
+        if (it == m_cells.end()) continue;
+        for (SpatialHandle handle : it->second) {
+          const Item& item = m_items[handle];
+          // Report rectangles on many cells only from the first shared one
+          if (x != std::max(x0, item.x0) || y != std::max(y0, item.y0)) {
+            continue;
+          }
+          if (HasRectIntersectionFloat(item.rect, area)) {
+            results.push_back(handle);
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Find the rectangles containing a point.
+   *
+   * @param p the point.
+   * @param results where the handles of rectangles containing p are appended.
+   */
+  void QueryPoint(const FPointRaw& p,
+                  std::vector<SpatialHandle>& results) const
+  {
+    auto it = m_cells.find(Key(Cell(p.x), Cell(p.y)));
+    if (it == m_cells.end()) return;
+    for (SpatialHandle handle : it->second) {
+      if (PointInRectFloat(p, m_items[handle].rect)) results.push_back(handle);
+    }
+  }
+
+private:
+  static Uint64 Key(int x, int y)
+  {
+    return Uint64(Uint32(x)) << 32 | Uint32(y);
+  }
+
+  int Cell(float coord) const
+  {
+    return int(std::clamp(std::floor(coord / m_cellSize), -1e9f, 1e9f));
+  }
+
+  void CellRange(const FRectRaw& rect, int& x0, int& y0, int& x1, int& y1)
+    const
+  {
+    x0 = Cell(rect.x);
+    y0 = Cell(rect.y);
+    x1 = std::max(Cell(rect.x + rect.w), x0);
+    y1 = std::max(Cell(rect.y + rect.h), y0);
+  }
+
+  void Link(SpatialHandle handle)
+  {
+    const Item& item = m_items[handle];
+    for (int y = item.y0; y <= item.y1; y++) {
+      for (int x = item.x0; x <= item.x1; x++) {
+        m_cells[Key(x, y)].push_back(handle);
+      }
+    }
+    if (m_maxX < m_minX) {
+      m_minX = item.x0;
+      m_minY = item.y0;
+      m_maxX = item.x1;
+      m_maxY = item.y1;
+      return;
+    }
+    m_minX = std::min(m_minX, item.x0);
+    m_minY = std::min(m_minY, item.y0);
+    m_maxX = std::max(m_maxX, item.x1);
+    m_maxY = std::max(m_maxY, item.y1);
+  }
+
+  void Unlink(SpatialHandle handle)
+  {
+    const Item& item = m_items[handle];
+    for (int y = item.y0; y <= item.y1; y++) {
+      for (int x = item.x0; x <= item.x1; x++) {
+        auto it = m_cells.find(Key(x, y));
+        auto& cell = it->second;
+        *std::find(cell.begin(), cell.end(), handle) = cell.back();
+        cell.pop_back();
+        if (cell.empty()) m_cells.erase(it);
+      }
+    }
+  }
+};
+
+/**
+ * Spatial index keeping rectangles on a dynamic bounding volume tree.
+ *
+ * Leaves store their rectangle enlarged by a margin, so small movements don't
+ * change the tree. The tree is kept balanced with rotations as rectangles are
+ * inserted and removed.
+ *
+ * @threadsafety Queries use an internal stack, so they need exclusive access
+ *               too.
+ */
+class AABBTree
+{
+  static constexpr int NONE = -1;
+
+  struct Box
+  {
+    float x0, y0, x1, y1;
+  };
+
+  struct Node
+  {
+    Box box;
+    FRect rect;
+    int parent;
+    int child1;
+    int child2;
+    int height;
+
+    bool IsLeaf() const { return child1 == NONE; }
+  };
+
+  float m_margin;
+  std::vector<Node> m_nodes;
+  int m_root = NONE;
+  int m_free = NONE;
+  size_t m_count = 0;
+  mutable std::vector<int> m_stack;
+
+public:
+  /**
+   * Create an empty tree.
+   *
+   * @param margin how much rectangles are enlarged on each side, so moving
+   *               them less than this doesn't change the tree.
+   */
+  explicit AABBTree(float margin = 4)
+    : m_margin(std::max(margin, 0.f))
+  {
+  }
+
+  /**
+   * Add a rectangle.
+   *
+   * @param rect the rectangle.
+   * @returns the handle to move, remove or identify it on query results.
+   */
+  SpatialHandle Insert(const FRectRaw& rect)
+  {
+    int leaf = Allocate();
+    Node& node = m_nodes[leaf];
+    node.rect = rect;
+    node.box = Fatten(rect);
+    node.height = 0;
+    InsertLeaf(leaf);
+    m_count++;
+    return SpatialHandle(leaf);
+  }
+
+  /**
+   * Change the rectangle of a handle.
+   *
+   * @param handle the handle, as returned by Insert().
+   * @param rect the new rectangle.
+   */
+  void Move(SpatialHandle handle, const FRectRaw& rect)
+  {
+    Node& node = m_nodes[handle];
+    node.rect = rect;
+    Box box = ToBox(rect);
+    const Box& fat = node.box;
+    if (fat.x0 <= box.x0 && fat.y0 <= box.y0 && box.x1 <= fat.x1 &&
+        box.y1 <= fat.y1) {
+      return;
+    }
+    RemoveLeaf(int(handle));
+    m_nodes[handle].box = Fatten(rect);
+    InsertLeaf(int(handle));
+  }
+
+  /**
+   * Remove a rectangle.
+   *
+   * @param handle the handle, as returned by Insert(). It may be reused by
+   *               later insertions.
+   */
+  void Remove(SpatialHandle handle)
+  {
+    RemoveLeaf(int(handle));
+    Free(int(handle));
+    m_count--;
+  }
+
+  /**
+   * Get the rectangle of a handle.
+   *
+   * @param handle the handle, as returned by Insert().
+   * @returns the rectangle.
+   */
+  const FRect& GetRect(SpatialHandle handle) const
+  {
+    return m_nodes[handle].rect;
+  }
+
+  /**
+   * Get the number of rectangles.
+   *
+   * @returns the number of rectangles.
+   */
+  size_t size() const { return m_count; }
+
+  /**
+   * Get the height of the tree.
+   *
+   * @returns the number of levels below the root, or -1 if empty.
+   */
+  int GetHeight() const { return m_root == NONE ? -1 : m_nodes[m_root].height; }
+
+  /// Remove all rectangles.
+  void clear()
+  {
+    m_nodes.clear();
+    m_root = m_free = NONE;
+    m_count = 0;
+  }
+
+  /**
+   * Find the rectangles intersecting an area.
+   *
+   * @param area the area.
+   * @param results where the handles of intersecting rectangles are appended.
+   */
+  void Query(const FRectRaw& area, std::vector<SpatialHandle>& results) const
+  {
+    Box box = ToBox(area);
+    Traverse(box, [&](int leaf) {
+      if (HasRectIntersectionFloat(m_nodes[leaf].rect, area)) {
+        results.push_back(SpatialHandle(leaf));
+      }
+    });
+  }
+
+  /**
+   * Find the rectangles containing a point.
+   *
+   * @param p the point.
+   * @param results where the handles of rectangles containing p are appended.
+   */
+  void QueryPoint(const FPointRaw& p,
+                  std::vector<SpatialHandle>& results) const
+  {
+    Traverse({p.x, p.y, p.x, p.y}, [&](int leaf) {
+      if (PointInRectFloat(p, m_nodes[leaf].rect)) {
+        results.push_back(SpatialHandle(leaf));
+      }
+    });
+  }
+
+private:
+  static Box ToBox(const FRectRaw& rect)
+  {
+    return {rect.x, rect.y, rect.x + rect.w, rect.y + rect.h};
+  }
+
+  Box Fatten(const FRectRaw& rect) const
+  {
+    Box box = ToBox(rect);
+    return {box.x0 - m_margin,
+            box.y0 - m_margin,
+            box.x1 + m_margin,
+            box.y1 + m_margin};
+  }
+
+  static Box Union(const Box& a, const Box& b)
+  {
+    return {std::min(a.x0, b.x0),
+            std::min(a.y0, b.y0),
+            std::max(a.x1, b.x1),
+            std::max(a.y1, b.y1)};
+  }
+
+  static float Perimeter(const Box& box)
+  {
+    return 2 * ((box.x1 - box.x0) + (box.y1 - box.y0));
+  }
+
+  static bool Overlaps(const Box& a, const Box& b)
+  {
+    return a.x0 <= b.x1 && b.x0 <= a.x1 && a.y0 <= b.y1 && b.y0 <= a.y1;
+  }
+
+  template<class LEAF>
+  void Traverse(const Box& box, LEAF leaf) const
+  {
+    if (m_root == NONE) return;
+    m_stack.clear();
+    m_stack.push_back(m_root);
+    while (!m_stack.empty()) {
+      int index = m_stack.back();
+      m_stack.pop_back();
+      const Node& node = m_nodes[index];
+      if (!Overlaps(node.box, box)) continue;
+      if (node.IsLeaf()) {
+        leaf(index);
+      } else {
+        m_stack.push_back(node.child1);
+        m_stack.push_back(node.child2);
+      }
+    }
+  }
+
+  int Allocate()
+  {
+    if (m_free == NONE) {
+      m_nodes.push_back({});
+      m_free = int(m_nodes.size() - 1);
+      m_nodes[m_free].parent = NONE;
+    }
+    int index = m_free;
+    Node& node = m_nodes[index];
+    m_free = node.parent;
+    node.parent = node.child1 = node.child2 = NONE;
+    node.height = 0;
+    return index;
+  }
+
+  void Free(int index)
+  {
+    m_nodes[index].parent = m_free;
+    m_nodes[index].height = -1;
+    m_free = index;
+  }
+
+  /// Recomputes height and box of inner nodes from index up to the root
+  void Refit(int index)
+  {
+    while (index != NONE) {
+      index = Balance(index);
+      Node& node = m_nodes[index];
+      const Node& child1 = m_nodes[node.child1];
+      const Node& child2 = m_nodes[node.child2];
+      node.height = 1 + std::max(child1.height, child2.height);
+      node.box = Union(child1.box, child2.box);
+      index = node.parent;
+    }
+  }
+
+  /// Finds the cheapest sibling by the perimeter heuristic
+  void InsertLeaf(int leaf)
+  {
+    if (m_root == NONE) {
+      m_root = leaf;
+      m_nodes[leaf].parent = NONE;
+      return;
+    }
+
+    Box box = m_nodes[leaf].box;
+    int index = m_root;
+    while (!m_nodes[index].IsLeaf()) {
+      const Node& node = m_nodes[index];
+      float area = Perimeter(node.box);
+      float combined = Perimeter(Union(node.box, box));
+      float cost = 2 * combined;
+      float inheritance = 2 * (combined - area);
+      auto descend = [&](int child) {
+        const Node& c = m_nodes[child];
+        float enlarged = Perimeter(Union(box, c.box));
+        if (!c.IsLeaf()) enlarged -= Perimeter(c.box);
+        return enlarged + inheritance;
+      };
+      float cost1 = descend(node.child1);
+      float cost2 = descend(node.child2);
+      if (cost < cost1 && cost < cost2) break;
+      index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    int sibling = index;
+    int oldParent = m_nodes[sibling].parent;
+    int newParent = Allocate();
+    Node& parent = m_nodes[newParent];
+    parent.parent = oldParent;
+    parent.box = Union(box, m_nodes[sibling].box);
+    parent.height = m_nodes[sibling].height + 1;
+    parent.child1 = sibling;
+    parent.child2 = leaf;
+    m_nodes[sibling].parent = newParent;
+    m_nodes[leaf].parent = newParent;
+    if (oldParent == NONE) {
+      m_root = newParent;
+    } else {
+      Node& old = m_nodes[oldParent];
+      (old.child1 == sibling ? old.child1 : old.child2) = newParent;
+    }
+    Refit(newParent);
+  }
+
+  void RemoveLeaf(int leaf)
+  {
+    if (leaf == m_root) {
+      m_root = NONE;
+      return;
+    }
+    int parent = m_nodes[leaf].parent;
+    int grandParent = m_nodes[parent].parent;
+    int sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2
+                                                 : m_nodes[parent].child1;
+    m_nodes[sibling].parent = grandParent;
+    Free(parent);
+    if (grandParent == NONE) {
+      m_root = sibling;
+      return;
+    }
+    Node& grand = m_nodes[grandParent];
+    (grand.child1 == parent ? grand.child1 : grand.child2) = sibling;
+    Refit(grandParent);
+  }
+
+  /// Rotates the taller grandchild up if children heights differ by over 1
+  int Balance(int iA)
+  {
+    Node& A = m_nodes[iA];
+    if (A.IsLeaf() || A.height < 2) return iA;
+    int iB = A.child1;
+    int iC = A.child2;
+    Node& B = m_nodes[iB];
+    Node& C = m_nodes[iC];
+    int balance = C.height - B.height;
+    if (balance > 1) return Rotate(iA, iC, false);
+    if (balance < -1) return Rotate(iA, iB, true);
+    return iA;
+  }
+
+  /// Puts child iUp in place of iA, making iA its child
+  int Rotate(int iA, int iUp, bool upIsFirst)
+  {
+    Node& A = m_nodes[iA];
+    Node& up = m_nodes[iUp];
+    int iOther = upIsFirst ? A.child2 : A.child1;
+    int iF = up.child1;
+    int iG = up.child2;
+    Node& F = m_nodes[iF];
+    Node& G = m_nodes[iG];
+
+    up.child1 = iA;
+    up.parent = A.parent;
+    A.parent = iUp;
+    if (up.parent == NONE) {
+      m_root = iUp;
+    } else {
+      Node& parent = m_nodes[up.parent];
+      (parent.child1 == iA ? parent.child1 : parent.child2) = iUp;
+    }
+
+    // The taller grandchild stays with up, the other goes to A
+    int iKeep = F.height > G.height ? iF : iG;
+    int iGive = F.height > G.height ? iG : iF;
+    up.child2 = iKeep;
+    (upIsFirst ? A.child1 : A.child2) = iGive;
+    m_nodes[iGive].parent = iA;
+
+    const Node& other = m_nodes[iOther];
+    const Node& give = m_nodes[iGive];
+    const Node& keep = m_nodes[iKeep];
+    A.box = Union(other.box, give.box);
+    A.height = 1 + std::max(other.height, give.height);
+    up.box = Union(A.box, keep.box);
+    up.height = 1 + std::max(A.height, keep.height);
+    return iUp;
+  }
+};
+
+/// @}
+
+} // namespace SDL
+
+#endif /* SDL3PP_SPATIAL_INDEX_H_ */
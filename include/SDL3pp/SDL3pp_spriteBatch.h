@@ -0,0 +1,363 @@
+#ifndef SDL3PP_SPRITE_BATCH_H_
+#define SDL3PP_SPRITE_BATCH_H_
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "SDL3pp_render.h"
+
+namespace SDL {
+
+/**
+ * @defgroup CategorySpriteBatch Sprite batching
+ *
+ * Draw many textured quads with few draw calls.
+ *
+ * Every Renderer.RenderTexture() call is a separate draw call. SpriteBatch
+ * accumulates the same quads as vertices instead and submits them with
+ * Renderer.RenderGeometry(), one call for each run of sprites sharing texture
+ * and blend mode:
+ *
+ * ```cpp
+ * SDL::SpriteBatch batch{renderer};
+ * for (auto& sprite : sprites) {
+ *   batch.DrawRotated(sprite.texture, sprite.src, sprite.dst, sprite.angle);
+ * }
+ * batch.Flush();
+ * renderer.Present();
+ * ```
+ *
+ * The vertex and index buffers are kept between flushes, so after the first
+ * frames batching does not allocate.
+ *
+ * @{
+ */
+
+/**
+ * Counters of a SpriteBatch.
+ *
+ * @sa SpriteBatch.GetStats
+ */
+struct SpriteBatchStats
+{
+  /// Sprites drawn
+  Uint64 sprites = 0;
+
+  /// Calls to Renderer.RenderGeometry()
+  Uint64 drawCalls = 0;
+
+  /// Calls to SpriteBatch.Flush() that had sprites to draw
+  Uint64 flushes = 0;
+};
+
+/**
+ * Accumulates textured quads and draws them with Renderer.RenderGeometry().
+ *
+ * Sprites are drawn in the order they were added, unless sorting by texture
+ * is enabled with SetSortByTexture(). Color and alpha modulation are done per
+ * vertex, so the color mod of textures is ignored, as with
+ * Renderer.RenderGeometry().
+ *
+ * Nothing is drawn until Flush() is called. Pending sprites are discarded when
+ * the batch is destroyed.
+ *
+ * @threadsafety This class should only be used on the main thread.
+ */
+class SpriteBatch
+{
+  struct Sprite
+  {
+    TextureRaw texture;
+    BlendMode blendMode;
+    int first;
+  };
+
+  RendererRef m_renderer;
+  std::vector<Vertex> m_vertices;
+  std::vector<Vertex> m_sortedVertices; ///< Scratch for sorting m_vertices
+  std::vector<int> m_indices;
+  std::vector<Sprite> m_sprites;
+  FColor m_color{1, 1, 1, 1};
+  BlendMode m_blendMode = BLENDMODE_INVALID;
+  bool m_sortByTexture = false;
+  SpriteBatchStats m_stats;
+
+public:
+  /**
+   * Create a batch.
+   *
+   * @param renderer the renderer to draw on. It must outlive the batch.
+   * @param capacity the number of sprites to reserve room for.
+   */
+  explicit SpriteBatch(RendererRef renderer, size_t capacity = 1024)
+    : m_renderer(renderer)
+  {
+    Reserve(capacity);
+  }
+
+  /**
+   * Reserve room for sprites.
+   *
+   * @param capacity the number of sprites.
+   */
+  void Reserve(size_t capacity)
+  {
+    m_vertices.reserve(capacity * 4);
+    m_indices.reserve(capacity * 6);
+    m_sprites.reserve(capacity);
+  }
+
+  /**
+   * Set the color modulation of the sprites added next.
+   *
+   * @param color the color, multiplied with the texture color. The default is
+   *              opaque white.
+   */
+  void SetColorMod(const FColorRaw& color) { m_color = color; }
+
+  /**
+   * Get the color modulation of the sprites added next.
+   *
+   * @returns the color.
+   */
+  FColor GetColorMod() const { return m_color; }
+
+  /**
+   * Set the blend mode of the sprites added next.
+   *
+   * The texture blend mode is changed only while its sprites are drawn and
+   * restored afterwards.
+   *
+   * @param blendMode the blend mode, or BLENDMODE_INVALID to use the one set on
+   *                  the texture, which is the default.
+   */
+  void SetBlendMode(BlendMode blendMode) { m_blendMode = blendMode; }
+
+  /**
+   * Get the blend mode of the sprites added next.
+   *
+   * @returns the blend mode, BLENDMODE_INVALID if the texture one is used.
+   */
+  BlendMode GetBlendMode() const { return m_blendMode; }
+
+  /**
+   * Enable or disable sorting by texture.
+   *
+   * When enabled, Flush() groups all sprites of the same texture and blend mode
+   * together, keeping their relative order, which reduces the draw calls to
+   * one per texture and blend mode. Sprites of different textures can then be
+   * drawn in a different order than added, so only enable it when they don't
+   * overlap or the order among them doesn't matter.
+   *
+   * @param enabled true to enable, it is disabled by default.
+   */
+  void SetSortByTexture(bool enabled) { m_sortByTexture = enabled; }
+
+  /**
+   * Add a sprite.
+   *
+   * This is the batched equivalent of Renderer.RenderTexture().
+   *
+   * @param texture the source texture, or nullptr for a solid quad.
+   * @param srcrect the source rectangle, or nullptr for the entire texture.
+   * @param dstrect the destination rectangle.
+   */
+  void Draw(TextureRef texture,
+            OptionalRef<const FRectRaw> srcrect,
+            const FRectRaw& dstrect)
+  {
+    Quad(texture, srcrect, dstrect, 0, {}, FLIP_NONE);
+  }
+
+  /**
+   * Add a sprite with rotation and flipping.
+   *
+   * This is the batched equivalent of Renderer.RenderTextureRotated().
+   *
+   * @param texture the source texture, or nullptr for a solid quad.
+   * @param srcrect the source rectangle, or nullptr for the entire texture.
+   * @param dstrect the destination rectangle.
+   * @param angle an angle in degrees to rotate dstrect, clockwise.
+   * @param center the point dstrect is rotated around, relative to its top
+   *               left corner, or nullptr for its center.
+   * @param flip the flipping actions to perform on the texture.
+   */
+  void DrawRotated(TextureRef texture,
+                   OptionalRef<const FRectRaw> srcrect,
+                   const FRectRaw& dstrect,
+                   double angle,
+                   OptionalRef<const FPointRaw> center = {},
+                   FlipMode flip = FLIP_NONE)
+  {
+    Quad(texture, srcrect, dstrect, angle, center, flip);
+  }
+
+  /**
+   * Get the number of sprites waiting for Flush().
+   *
+   * @returns the number of sprites.
+   */
+  size_t size() const { return m_sprites.size(); }
+
+  /**
+   * Check if there are no sprites waiting for Flush().
+   *
+   * @returns true if empty.
+   */
+  bool empty() const { return m_sprites.empty(); }
+
+  /// Discard all sprites waiting for Flush().
+  void clear()
+  {
+    m_vertices.clear();
+    m_sprites.clear();
+  }
+
+  /**
+   * Draw all pending sprites.
+   *
+   * @throws Error on failure. Pending sprites are discarded anyway.
+   *
+   * @threadsafety This function should only be called on the main thread.
+   */
+  void Flush()
+  {
+    if (m_sprites.empty()) return;
+    if (m_sortByTexture) {
+      std::stable_sort(
+        m_sprites.begin(), m_sprites.end(), [](auto& a, auto& b) {
+          if (a.texture != b.texture) return a.texture < b.texture;
+          return a.blendMode < b.blendMode;
+        });
+
+      // Keep each run on a contiguous range of vertices
+      m_sortedVertices.clear();
+      for (Sprite& sprite : m_sprites) {
+        auto first = m_vertices.begin() + sprite.first;
+        sprite.first = int(m_sortedVertices.size());
+        m_sortedVertices.insert(m_sortedVertices.end(), first, first + 4);
+      }
+      m_vertices.swap(m_sortedVertices);
+    }
+    m_stats.sprites += m_sprites.size();
+    m_stats.flushes++;
+
+    struct Cleanup
+    {
+      SpriteBatch* self;
+      ~Cleanup() { self->clear(); }
+    } cleanup{this};
+
+    m_indices.clear();
+    const Sprite* run = &m_sprites.front();
+    for (const Sprite& sprite : m_sprites) {
+      if (sprite.texture != run->texture ||
+          sprite.blendMode != run->blendMode) {
+        DrawRun(*run, sprite.first);
+        run = &sprite;
+      }
+      int i = sprite.first - run->first;
+      m_indices.insert(m_indices.end(), {i, i + 1, i + 2, i, i + 2, i + 3});
+    }
+    DrawRun(*run, int(m_vertices.size()));
+  }
+
+  /**
+   * Get the counters.
+   *
+   * @returns the counters since creation or the last ResetStats().
+   */
+  const SpriteBatchStats& GetStats() const { return m_stats; }
+
+  /// Reset the counters.
+  void ResetStats() { m_stats = {}; }
+
+private:
+  void Quad(TextureRef texture,
+            OptionalRef<const FRectRaw> srcrect,
+            const FRectRaw& dstrect,
+            double angle,
+            OptionalRef<const FPointRaw> center,
+            FlipMode flip)
+  {
+    float u0 = 0, v0 = 0, u1 = 1, v1 = 1;
+    if (texture && srcrect) {
+      float w = float(texture->w);
+      float h = float(texture->h);
+      u0 = srcrect->x / w;
+      v0 = srcrect->y / h;
+      u1 = (srcrect->x + srcrect->w) / w;
+      v1 = (srcrect->y + srcrect->h) / h;
+    }
+    if (flip & FLIP_HORIZONTAL) std::swap(u0, u1);
+    if (flip & FLIP_VERTICAL) std::swap(v0, v1);
+
+    float x0 = dstrect.x, y0 = dstrect.y;
+    float x1 = dstrect.x + dstrect.w, y1 = dstrect.y + dstrect.h;
+    int first = int(m_vertices.size());
+    m_vertices.push_back({{x0, y0}, m_color, {u0, v0}});
+    m_vertices.push_back({{x1, y0}, m_color, {u1, v0}});
+    m_vertices.push_back({{x1, y1}, m_color, {u1, v1}});
+    m_vertices.push_back({{x0, y1}, m_color, {u0, v1}});
+
+    if (angle != 0) {
+      float cx = x0 + (center ? center->x : dstrect.w / 2);
+      float cy = y0 + (center ? center->y : dstrect.h / 2);
+      double radians = angle * SDL_PI_D / 180;
+      float c = float(std::cos(radians));
+      float s = float(std::sin(radians));
+      for (Vertex* v = &m_vertices[first]; v != m_vertices.data() + first + 4;
+           v++) {
+        float dx = v->position.x - cx;
+        float dy = v->position.y - cy;
+        v->position.x = cx + dx * c - dy * s;
+        v->position.y = cy + dx * s + dy * c;
+      }
+    }
+    m_sprites.push_back({texture.get(), m_blendMode, first});
+  }
+
+  /// Draw the vertices from run.first to end, with the indices of the run
+  void DrawRun(const Sprite& run, int end)
+  {
+    m_stats.drawCalls++;
+    BlendMode previous = BLENDMODE_INVALID;
+    if (run.blendMode != BLENDMODE_INVALID) {
+      previous = run.texture ? GetTextureBlendMode(run.texture)
+                             : GetRenderDrawBlendMode(m_renderer);
+      if (previous == run.blendMode) {
+        previous = BLENDMODE_INVALID;
+      } else if (run.texture) {
+        SetTextureBlendMode(run.texture, run.blendMode);
+      } else {
+        SetRenderDrawBlendMode(m_renderer, run.blendMode);
+      }
+    }
+    bool ok;
+    {
+      SDL3PP_RENDER_STATS_SCOPE(
+        m_renderer, RENDER_STATS_DRAW, m_indices.size(), run.texture);
+      ok = SDL_RenderGeometry(m_renderer,
+                              run.texture,
+                              m_vertices.data() + run.first,
+                              end - run.first,
+                              m_indices.data(),
+                              narrowS32(m_indices.size()));
+    }
+    if (previous != BLENDMODE_INVALID) {
+      if (run.texture) {
+        SDL_SetTextureBlendMode(run.texture, previous);
+      } else {
+        SDL_SetRenderDrawBlendMode(m_renderer, previous);
+      }
+    }
+    m_indices.clear();
+    CheckError(ok);
+  }
+};
+
+/// @}
+
+} // namespace SDL
+
+#endif /* SDL3PP_SPRITE_BATCH_H_ */
@@ -0,0 +1,306 @@
+#ifndef SDL3PP_STREAMING_TEXTURE_RING_H_
+#define SDL3PP_STREAMING_TEXTURE_RING_H_
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "SDL3pp_render.h"
+#include "SDL3pp_timer.h"
+
+namespace SDL {
+
+/**
+ * @defgroup CategoryStreamingTextureRing Streaming texture ring
+ *
+ * Stream CPU generated frames to textures without stalls.
+ *
+ * Updating a single streaming texture every frame waits for the GPU to be done
+ * with its previous contents, and generating the next frame can't start until
+ * the upload ends. StreamingTextureRing decouples both: a producer, usually a
+ * worker thread, fills CPU side surfaces, while the main thread uploads the
+ * latest complete one to the next texture of a ring:
+ *
+ * ```cpp
+ * SDL::StreamingTextureRing ring{renderer, SDL::PIXELFORMAT_IYUV, {640, 480}};
+ *
+ * // producer thread
+ * while (running) {
+ *   if (SDL::SurfaceRef frame = ring.AcquireFrame()) {
+ *     Decode(frame);
+ *     ring.SubmitFrame();
+ *   }
+ * }
+ *
+ * // main thread, each frame
+ * renderer.RenderTexture(ring.Update(), {}, {});
+ * ```
+ *
+ * When the producer is faster than the main thread, older complete frames are
+ * dropped in favor of newer ones and counted on the statistics.
+ *
+ * @{
+ */
+
+/**
+ * Counters of a StreamingTextureRing.
+ *
+ * @sa StreamingTextureRing.GetStats
+ */
+struct StreamingTextureStats
+{
+  /// Frames submitted by the producer
+  Uint64 submitted = 0;
+
+  /// Frames uploaded to a texture
+  Uint64 uploaded = 0;
+
+  /// Frames submitted that were replaced by newer ones before being uploaded
+  Uint64 dropped = 0;
+
+  /// Total time spent updating textures, in nanoseconds
+  Uint64 uploadNS = 0;
+
+  /// Longest single texture update, in nanoseconds
+  Uint64 maxUploadNS = 0;
+
+  /// Time from SubmitFrame() to the end of the upload of the last frame, in
+  /// nanoseconds
+  Uint64 lastLatencyNS = 0;
+
+  /// Longest time from SubmitFrame() to the end of its upload, in nanoseconds
+  Uint64 maxLatencyNS = 0;
+};
+
+/**
+ * Ring of streaming textures fed from CPU side surfaces.
+ *
+ * It has as many CPU side frames as textures. A frame is either free, being
+ * written by the producer, complete, or being uploaded.
+ *
+ * Planar YUV formats are uploaded with Texture.UpdateYUV() and
+ * Texture.UpdateNV(), other formats with Texture.Update().
+ *
+ * @threadsafety AcquireFrame() and SubmitFrame() can be called from one
+ *               producer thread at a time. All other functions should only be
+ *               called on the main thread.
+ */
+class StreamingTextureRing
+{
+  enum State
+  {
+    FREE,
+    WRITING,
+    READY,
+    UPLOADING,
+  };
+
+  struct Frame
+  {
+    Surface surface;
+    State state = FREE;
+    Uint64 sequence = 0;
+    Uint64 submitNS = 0;
+  };
+
+  std::vector<Texture> m_textures;
+  std::vector<Frame> m_frames;
+  size_t m_current = 0;
+  bool m_hasCurrent = false;
+  size_t m_writing = 0;
+  Uint64 m_sequence = 0;
+  std::mutex m_mutex;
+  StreamingTextureStats m_stats;
+
+public:
+  /**
+   * Create the textures and CPU side frames.
+   *
+   * @param renderer the renderer to create the textures on.
+   * @param format the pixel format of textures and frames.
+   * @param size the size of textures and frames, in pixels.
+   * @param count the number of textures and frames, at least 2.
+   * @throws Error on failure.
+   */
+  StreamingTextureRing(RendererRef renderer,
+                       PixelFormat format,
+                       const PointRaw& size,
+                       size_t count = 3)
+  {
+    if (count < 2) count = 2;
+    m_textures.reserve(count);
+    m_frames.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+      m_textures.emplace_back(renderer, format, TEXTUREACCESS_STREAMING, size);
+      m_frames.push_back({Surface(size, format)});
+    }
+  }
+
+  StreamingTextureRing(const StreamingTextureRing&) = delete;
+  StreamingTextureRing& operator=(const StreamingTextureRing&) = delete;
+
+  /**
+   * Get a frame to write to.
+   *
+   * If there is no free frame, the oldest complete frame not yet uploaded is
+   * dropped and reused.
+   *
+   * @returns the frame surface, or nullptr if the previous one was not
+   *          submitted yet or all others are being uploaded.
+   *
+   * @threadsafety It is safe to call this from the producer thread.
+   */
+  SurfaceRef AcquireFrame()
+  {
+    std::lock_guard lock{m_mutex};
+    if (m_frames[m_writing].state == WRITING) return nullptr;
+    Frame* oldest = nullptr;
+    for (size_t i = 0; i < m_frames.size(); i++) {
+      Frame& frame = m_frames[i];
+      if (frame.state == FREE) {
+        frame.state = WRITING;
+        m_writing = i;
+        return frame.surface.get();
+      }
+      if (frame.state == READY &&
+          (!oldest || frame.sequence < oldest->sequence)) {
+        oldest = &frame;
+      }
+    }
+    if (!oldest) return nullptr;
+    m_stats.dropped++;
+    oldest->state = WRITING;
+    m_writing = size_t(oldest - m_frames.data());
+    return oldest->surface.get();
+  }
+
+  /**
+   * Mark the frame returned by AcquireFrame() as complete.
+   *
+   * @threadsafety It is safe to call this from the producer thread.
+   */
+  void SubmitFrame()
+  {
+    std::lock_guard lock{m_mutex};
+    Frame& frame = m_frames[m_writing];
+    if (frame.state != WRITING) return;
+    frame.state = READY;
+    frame.sequence = ++m_sequence;
+    frame.submitNS = GetTicksNS();
+    m_stats.submitted++;
+  }
+
+  /**
+   * Upload the newest complete frame, if any, to the next texture.
+   *
+   * Complete frames older than it are dropped.
+   *
+   * @returns the texture with the newest uploaded frame, or nullptr if no frame
+   *          was uploaded yet.
+   * @throws Error on failure.
+   *
+   * @threadsafety This function should only be called on the main thread.
+   */
+  TextureRef Update()
+  {
+    Frame* newest = nullptr;
+    {
+      std::lock_guard lock{m_mutex};
+      for (Frame& frame : m_frames) {
+        if (frame.state == READY &&
+            (!newest || frame.sequence > newest->sequence)) {
+          newest = &frame;
+        }
+      }
+      if (!newest) return GetTexture();
+      for (Frame& frame : m_frames) {
+        if (frame.state == READY && &frame != newest) {
+          frame.state = FREE;
+          m_stats.dropped++;
+        }
+      }
+      newest->state = UPLOADING;
+    }
+
+    size_t next = m_hasCurrent ? (m_current + 1) % m_textures.size() : 0;
+    Uint64 start = GetTicksNS();
+    try {
+      Upload(m_textures[next], newest->surface);
+    } catch (...) {
+      std::lock_guard lock{m_mutex};
+      newest->state = FREE;
+      throw;
+    }
+    Uint64 end = GetTicksNS();
+
+    std::lock_guard lock{m_mutex};
+    newest->state = FREE;
+    m_current = next;
+    m_hasCurrent = true;
+    m_stats.uploaded++;
+    m_stats.uploadNS += end - start;
+    m_stats.maxUploadNS = std::max(m_stats.maxUploadNS, end - start);
+    m_stats.lastLatencyNS = end - newest->submitNS;
+    m_stats.maxLatencyNS =
+      std::max(m_stats.maxLatencyNS, m_stats.lastLatencyNS);
+    return GetTexture();
+  }
+
+  /**
+   * Get the texture with the newest uploaded frame.
+   *
+   * @returns the texture, or nullptr if no frame was uploaded yet.
+   */
+  TextureRef GetTexture() const
+  {
+    return m_hasCurrent ? m_textures[m_current].get() : nullptr;
+  }
+
+  /**
+   * Get the counters.
+   *
+   * @returns a snapshot of the counters.
+   */
+  StreamingTextureStats GetStats()
+  {
+    std::lock_guard lock{m_mutex};
+    return m_stats;
+  }
+
+  /// Reset the counters.
+  void ResetStats()
+  {
+    std::lock_guard lock{m_mutex};
+    m_stats = {};
+  }
+
+private:
+  static void Upload(Texture& texture, Surface& surface)
+  {
+    auto pixels = static_cast<const Uint8*>(surface->pixels);
+    int pitch = surface->pitch;
+    int h = surface->h;
+    int uvPitch = (pitch + 1) / 2;
+    const Uint8* second = pixels + pitch * h;
+    switch (surface->format) {
+    case SDL_PIXELFORMAT_IYUV:
+    case SDL_PIXELFORMAT_YV12: {
+      const Uint8* third = second + uvPitch * ((h + 1) / 2);
+      if (surface->format == SDL_PIXELFORMAT_YV12) std::swap(second, third);
+      texture.UpdateYUV({}, pixels, pitch, second, uvPitch, third, uvPitch);
+      break;
+    }
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+      texture.UpdateNV({}, pixels, pitch, second, uvPitch * 2);
+      break;
+    default: texture.Update({}, pixels, pitch);
+    }
+  }
+};
+
+/// @}
+
+} // namespace SDL
+
+#endif /* SDL3PP_STREAMING_TEXTURE_RING_H_ */
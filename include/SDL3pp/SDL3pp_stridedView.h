@@ -0,0 +1,308 @@
+#ifndef SDL3PP_STRIDED_VIEW_H_
+#define SDL3PP_STRIDED_VIEW_H_
+
+#include <climits>
+#include <concepts>
+#include <ranges>
+#include "SDL3pp_render.h"
+
+namespace SDL {
+
+/**
+ * @defgroup CategoryStridedView Strided vertex views
+ *
+ * Submit vertices straight from your own layout.
+ *
+ * Renderer.RenderGeometry() takes an array of Vertex, so data kept as a
+ * structure of arrays, or in structs of its own, must be copied first.
+ * Renderer.RenderGeometryRaw() avoids the copy, at the cost of computing
+ * pointers and strides by hand. StridedView does that for you: it is made from
+ * a span of points or colors, or from a member of the elements of a span, with
+ * the stride taken from the element type at compile time:
+ *
+ * ```cpp
+ * struct Particle
+ * {
+ *   SDL::FPoint pos;
+ *   SDL::FPoint vel;
+ *   SDL::FColor color;
+ * };
+ * std::vector<Particle> particles;
+ * std::vector<int> indices;
+ *
+ * SDL::RenderGeometryStrided(renderer,
+ *                            nullptr,
+ *                            {particles, &Particle::pos},
+ *                            {particles, &Particle::color},
+ *                            {},
+ *                            indices);
+ * ```
+ *
+ * @{
+ */
+
+/**
+ * Types a StridedView can refer to.
+ *
+ * Those are the types SDL_RenderGeometryRaw() reads: FPointRaw for positions
+ * and texture coordinates, and FColorRaw for colors.
+ */
+template<class T>
+concept StridedVertexAttribute =
+  std::same_as<T, FPointRaw> || std::same_as<T, FColorRaw>;
+
+/**
+ * Types an IndexView can refer to.
+ */
+template<class T>
+concept VertexIndex =
+  std::same_as<T, Uint8> || std::same_as<T, Uint16> ||
+  std::same_as<T, Uint32> || std::same_as<T, Sint32>;
+
+/**
+ * Read only view of equally spaced values, not necessarily contiguous.
+ *
+ * @tparam T FPointRaw or FColorRaw.
+ */
+template<StridedVertexAttribute T>
+class StridedView
+{
+  const T* m_data = nullptr;
+  size_t m_size = 0;
+  int m_stride = 0;
+
+  template<class S>
+  static consteval int StrideOf()
+  {
+    static_assert(sizeof(S) <= INT_MAX, "Element too large for a stride");
+    static_assert(sizeof(S) % alignof(float) == 0,
+                  "Stride must keep floats aligned");
+    return int(sizeof(S));
+  }
+
+  constexpr StridedView(const T* data, size_t size, int stride)
+    : m_data(data)
+    , m_size(size)
+    , m_stride(stride)
+  {
+  }
+
+public:
+  /// Default ctor, an empty view
+  constexpr StridedView() = default;
+
+  /**
+   * View a contiguous range of T, or of wrappers derived from it.
+   *
+   * @param range the range, for example a std::span<FPoint>.
+   */
+  template<std::ranges::contiguous_range R>
+    requires DerivedWrapper<
+      std::remove_cv_t<std::ranges::range_value_t<R>>,
+      T>
+  constexpr StridedView(R&& range)
+    : m_data(std::ranges::data(range))
+    , m_size(std::ranges::size(range))
+    , m_stride(StrideOf<std::ranges::range_value_t<R>>())
+  {
+  }
+
+  /**
+   * View a member of each element of a contiguous range.
+   *
+   * @param range the range.
+   * @param member pointer to the member, which must be T or a wrapper derived
+   *               from it.
+   */
+  template<std::ranges::contiguous_range R, class S, class M>
+    requires std::derived_from<
+               std::remove_cv_t<std::ranges::range_value_t<R>>,
+               S> &&
+             DerivedWrapper<M, T>
+  constexpr StridedView(R&& range, M S::* member)
+    : m_data(std::ranges::empty(range)
+               ? nullptr
+               : &(std::ranges::data(range)->*member))
+    , m_size(std::ranges::size(range))
+    , m_stride(StrideOf<std::ranges::range_value_t<R>>())
+  {
+  }
+
+  /**
+   * View a single value repeated for all vertices.
+   *
+   * The view has a stride of 0 and matches any number of vertices.
+   *
+   * @param value the value, it must outlive the view.
+   * @returns the view.
+   */
+  static constexpr StridedView Repeat(const T& value)
+  {
+    return StridedView(&value, 1, 0);
+  }
+
+  /**
+   * Get the first value.
+   *
+   * @returns a pointer to the first value, or nullptr if the view is empty.
+   */
+  constexpr const T* data() const { return m_data; }
+
+  /**
+   * Get the number of values.
+   *
+   * @returns the number of values, 1 for repeated views.
+   */
+  constexpr size_t size() const { return m_size; }
+
+  /**
+   * Check if the view is empty.
+   *
+   * @returns true if empty.
+   */
+  constexpr bool empty() const { return m_size == 0; }
+
+  /**
+   * Get the distance between consecutive values.
+   *
+   * @returns the distance in bytes, 0 for repeated views.
+   */
+  constexpr int stride() const { return m_stride; }
+
+  /**
+   * Check if the view matches a number of vertices.
+   *
+   * @param count the number of vertices.
+   * @returns true if it has count values, or is repeated.
+   */
+  constexpr bool Matches(size_t count) const
+  {
+    return m_size == count || (m_stride == 0 && m_size == 1);
+  }
+
+  /**
+   * Get a value.
+   *
+   * @param i the index, less than size() or anything for repeated views.
+   * @returns the value.
+   */
+  constexpr const T& operator[](size_t i) const
+  {
+    return *reinterpret_cast<const T*>(
+      reinterpret_cast<const char*>(m_data) + i * size_t(m_stride));
+  }
+};
+
+/**
+ * Read only view of vertex indices of 1, 2 or 4 bytes.
+ */
+class IndexView
+{
+  const void* m_data = nullptr;
+  size_t m_size = 0;
+  int m_indexSize = 0;
+
+public:
+  /// Default ctor, an empty view, meaning indices are not used.
+  constexpr IndexView() = default;
+
+  /**
+   * View a contiguous range of indices.
+   *
+   * @param range the range of Uint8, Uint16, Uint32 or Sint32.
+   */
+  template<std::ranges::contiguous_range R>
+    requires VertexIndex<std::remove_cv_t<std::ranges::range_value_t<R>>>
+  constexpr IndexView(R&& range)
+    : m_data(std::ranges::data(range))
+    , m_size(std::ranges::size(range))
+    , m_indexSize(int(sizeof(std::ranges::range_value_t<R>)))
+  {
+  }
+
+  /**
+   * Get the first index.
+   *
+   * @returns a pointer to the first index, or nullptr if the view is empty.
+   */
+  constexpr const void* data() const { return m_data; }
+
+  /**
+   * Get the number of indices.
+   *
+   * @returns the number of indices.
+   */
+  constexpr size_t size() const { return m_size; }
+
+  /**
+   * Check if the view is empty.
+   *
+   * @returns true if empty.
+   */
+  constexpr bool empty() const { return m_size == 0; }
+
+  /**
+   * Get the size of each index.
+   *
+   * @returns 1, 2 or 4, or 0 if empty.
+   */
+  constexpr int indexSize() const { return m_indexSize; }
+};
+
+/**
+ * Render a list of triangles from strided views, without copying them.
+ *
+ * This is Renderer.RenderGeometryRaw(), with pointers and strides taken from
+ * the views.
+ *
+ * @param renderer the rendering context.
+ * @param texture (optional) The SDL texture to use.
+ * @param xy the vertex positions.
+ * @param color the vertex colors, as many as positions or a single repeated
+ *              one.
+ * @param uv the vertex normalized texture coordinates, as many as positions,
+ *           or empty if there is no texture.
+ * @param indices (optional) the indices into the vertex arrays. If empty, the
+ *                vertices are rendered in sequential order.
+ * @throws Error if the views don't match the number of positions, or on
+ *         failure.
+ *
+ * @threadsafety This function should only be called on the main thread.
+ *
+ * @sa Renderer.RenderGeometryRaw
+ */
+inline void RenderGeometryStrided(RendererRef renderer,
+                                  TextureRef texture,
+                                  StridedView<FPointRaw> xy,
+                                  StridedView<FColorRaw> color,
+                                  StridedView<FPointRaw> uv = {},
+                                  IndexView indices = {})
+{
+  if (!color.Matches(xy.size()) || (!uv.empty() && !uv.Matches(xy.size()))) {
+    SetError("Vertex attributes count mismatch");
+    throw Error();
+  }
+  if (xy.empty()) return;
+  SDL3PP_RENDER_STATS_SCOPE(renderer,
+                            RENDER_STATS_DRAW,
+                            indices.empty() ? xy.size() : indices.size(),
+                            texture);
+  CheckError(SDL_RenderGeometryRaw(renderer,
+                                   texture,
+                                   &xy.data()->x,
+                                   xy.stride(),
+                                   color.data(),
+                                   color.stride(),
+                                   uv.empty() ? nullptr : &uv.data()->x,
+                                   uv.stride(),
+                                   narrowS32(xy.size()),
+                                   indices.data(),
+                                   narrowS32(indices.size()),
+                                   indices.indexSize()));
+}
+
+/// @}
+
+} // namespace SDL
+
+#endif /* SDL3PP_STRIDED_VIEW_H_ */
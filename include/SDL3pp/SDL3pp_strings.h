@@ -26,6 +26,23 @@ namespace SDL {
 
 #endif // SDL3PP_ENABLE_STRING_PARAM
 
+#ifndef SDL3PP_STRING_PARAM_BUFFER_SIZE
+
+/**
+ * Size in bytes of StringParam's inline buffer.
+ *
+ * std::string_view arguments shorter than this (null terminator included) are
+ * copied into StringParam itself, avoiding any heap allocation. Longer ones
+ * fall back to a std::string.
+ *
+ * Define it before including SDL3pp to change it.
+ *
+ * @ingroup CategoriesCppSupport
+ */
+#define SDL3PP_STRING_PARAM_BUFFER_SIZE 128
+
+#endif // SDL3PP_STRING_PARAM_BUFFER_SIZE
+
 #ifdef SDL3PP_ENABLE_STRING_PARAM
 
 /**
@@ -41,7 +58,24 @@ namespace SDL {
  */
 class StringParam
 {
-  std::variant<const char*, std::string> data;
+  /// Inline storage for short string views
+  struct InlineBuffer
+  {
+    /// The null terminated characters
+    char chars[SDL3PP_STRING_PARAM_BUFFER_SIZE];
+
+    /// Copy the view and add the null terminator
+    InlineBuffer(std::string_view str)
+    {
+      SDL_memcpy(chars, str.data(), str.size());
+      chars[str.size()] = 0;
+    }
+  };
+
+  static_assert(SDL3PP_STRING_PARAM_BUFFER_SIZE > 0,
+                "SDL3PP_STRING_PARAM_BUFFER_SIZE must be positive");
+
+  std::variant<const char*, std::string, InlineBuffer> data;
 
 public:
   /**
@@ -90,14 +124,19 @@ public:
    * Constructs from std::string_view object
    *
    * String view are very usefull on C++, but they don't have the null
-   * terminator expected by most string SDL APIs, so we always copy its content
-   * to a stored std::string.
+   * terminator expected by most string SDL APIs, so we always copy its
+   * content. If it fits SDL3PP_STRING_PARAM_BUFFER_SIZE it is copied into an
+   * inline buffer, otherwise it is stored into a std::string.
    *
    * @param str the string_view to store
    */
   StringParam(std::string_view str)
-    : StringParam(std::string{str})
   {
+    if (str.size() < sizeof(InlineBuffer::chars)) {
+      data.emplace<InlineBuffer>(str);
+    } else {
+      data.emplace<std::string>(str);
+    }
   }
 
   StringParam(const StringParam&) = delete;
@@ -121,6 +160,7 @@ public:
     {
       const char* operator()(const char* a) const { return a; }
       const char* operator()(const std::string& s) const { return s.c_str(); }
+      const char* operator()(const InlineBuffer& b) const { return b.chars; }
     };
     return std::visit(Visitor{}, data);
   }
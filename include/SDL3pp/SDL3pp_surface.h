@@ -6,6 +6,7 @@
 #include "SDL3pp_error.h"
 #include "SDL3pp_iostream.h"
 #include "SDL3pp_optionalRef.h"
+#include "SDL3pp_pixelConvert.h"
 #include "SDL3pp_pixels.h"
 #include "SDL3pp_properties.h"
 #include "SDL3pp_rect.h"
@@ -3481,6 +3482,74 @@ inline Surface Surface::Scale(const PointRaw& size, ScaleMode scaleMode) const
   return SDL::ScaleSurface(get(), size, scaleMode);
 }
 
+namespace detail {
+
+/**
+ * Carry over what SDL_ConvertSurface() keeps from the source surface: color
+ * and alpha mods, blend mode, clip rect and properties.
+ *
+ * As SDL does, blending is enabled when either format has alpha or there is an
+ * alpha mod. Color keys are not handled.
+ *
+ * @returns true on success, false on failure; call GetError() for more
+ *          information.
+ */
+inline bool CopyConvertSettings(SurfaceRaw src, SurfaceRaw dst)
+{
+  Uint8 r, g, b, a;
+  SDL_BlendMode blendMode;
+  SDL_Rect clip;
+  if (!SDL_GetSurfaceColorMod(src, &r, &g, &b) ||
+      !SDL_SetSurfaceColorMod(dst, r, g, b) ||
+      !SDL_GetSurfaceAlphaMod(src, &a) || !SDL_SetSurfaceAlphaMod(dst, a) ||
+      !SDL_GetSurfaceBlendMode(src, &blendMode)) {
+    return false;
+  }
+  if (SDL_ISPIXELFORMAT_ALPHA(dst->format) ||
+      SDL_ISPIXELFORMAT_ALPHA(src->format) || a != 0xFF) {
+    blendMode = SDL_BLENDMODE_BLEND;
+  }
+  if (blendMode != SDL_BLENDMODE_INVALID &&
+      !SDL_SetSurfaceBlendMode(dst, blendMode)) {
+    return false;
+  }
+
+  // The result only tells if the clip rect is empty
+  if (!SDL_GetSurfaceClipRect(src, &clip)) return false;
+  SDL_SetSurfaceClipRect(dst, &clip);
+
+  SDL_PropertiesID props = SDL_GetSurfaceProperties(src);
+  return props && SDL_CopyProperties(props, SDL_GetSurfaceProperties(dst));
+}
+
+/// Does what SDL_ConvertSurface() does, when it amounts to converting pixels
+inline SurfaceRaw ConvertSurfaceFast(SurfaceConstRef surface,
+                                     PixelFormat format)
+{
+  if (!surface || !CanConvertPixelsFast(surface->format, format) ||
+      SDL_SurfaceHasColorKey(surface) || SDL_SurfaceHasRLE(surface) ||
+      SDL_SurfaceHasAlternateImages(surface) ||
+      SDL_GetSurfaceColorspace(surface) != SDL_COLORSPACE_SRGB) {
+    return nullptr;
+  }
+  SurfaceRaw converted = SDL_CreateSurface(surface->w, surface->h, format);
+  if (!converted) return nullptr;
+  ConvertPixelsFast({surface->w, surface->h},
+                    surface->format,
+                    surface->pixels,
+                    surface->pitch,
+                    format,
+                    converted->pixels,
+                    converted->pitch);
+  if (!CopyConvertSettings(surface, converted)) {
+    SDL_DestroySurface(converted);
+    return nullptr;
+  }
+  return converted;
+}
+
+} // namespace detail
+
 /**
  * Copy an existing surface to a new surface of the specified format.
  *
@@ -3495,6 +3564,9 @@ inline Surface Surface::Scale(const PointRaw& size, ScaleMode scaleMode) const
  * If the original surface has alternate images, the new surface will have a
  * reference to them as well.
  *
+ * Plain sRGB surfaces, without color key or RLE, are converted with
+ * ConvertPixelsFast() when it supports both formats.
+ *
  * @param surface the existing Surface structure to convert.
  * @param format the new pixel format.
  * @returns the new Surface structure that is created or nullptr on failure;
@@ -3510,6 +3582,9 @@ inline Surface Surface::Scale(const PointRaw& size, ScaleMode scaleMode) const
  */
 inline Surface ConvertSurface(SurfaceConstRef surface, PixelFormat format)
 {
+  if (SurfaceRaw converted = detail::ConvertSurfaceFast(surface, format)) {
+    return Surface(converted);
+  }
   return Surface(SDL_ConvertSurface(surface, format));
 }
 
@@ -3568,6 +3643,9 @@ inline Surface Surface::Convert(PixelFormat format,
 /**
  * Copy a block of pixels of one format to another format.
  *
+ * Common 8 bits per channel conversions are done by ConvertPixelsFast(),
+ * others by SDL.
+ *
  * @param size the width and height of the surface.
  * @param src_format an PixelFormat value of the `src` pixels format.
  * @param src a pointer to the source pixels.
@@ -3593,6 +3671,10 @@ inline void ConvertPixels(const PointRaw& size,
                           void* dst,
                           int dst_pitch)
 {
+  if (ConvertPixelsFast(
+        size, src_format, src, src_pitch, dst_format, dst, dst_pitch)) {
+    return;
+  }
   CheckError(SDL_ConvertPixels(
     size.x, size.y, src_format, src, src_pitch, dst_format, dst, dst_pitch));
 }
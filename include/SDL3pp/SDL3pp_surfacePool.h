@@ -0,0 +1,332 @@
+#ifndef SDL3PP_SURFACE_POOL_H_
+#define SDL3PP_SURFACE_POOL_H_
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "SDL3pp_cpuinfo.h"
+#include "SDL3pp_properties.h"
+#include "SDL3pp_stdinc.h"
+#include "SDL3pp_surface.h"
+
+namespace SDL {
+
+/**
+ * @defgroup CategorySurfacePool Surface pool
+ *
+ * Recycle the pixel buffers of temporary surfaces.
+ *
+ * Pipelines that create and destroy surfaces of the same size every frame pay
+ * for allocating and freeing megabytes of pixels each time. SurfacePool hands
+ * out surfaces whose pixels come from a pool of buffers keyed by size, format
+ * and pitch. When a surface is destroyed, its buffer goes back to the pool for
+ * the next surface with the same key:
+ *
+ * ```cpp
+ * SDL::SurfacePool pool;
+ *
+ * // Each frame
+ * SDL::Surface thumb = pool.Acquire({320, 180}, SDL::PIXELFORMAT_RGBA32);
+ * thumb.BlitScaled(frame, nullptr, nullptr, SDL::SCALEMODE_LINEAR);
+ * // ...
+ * // thumb's buffer is reclaimed here
+ * ```
+ *
+ * Buffers and rows are aligned to GetSIMDAlignment(). Pooled surfaces are
+ * regular surfaces: they can be passed to SDL and outlive the pool, in which
+ * case their buffer is freed on destruction instead.
+ *
+ * @{
+ */
+
+/**
+ * Statistics of a SurfacePool.
+ *
+ * @sa SurfacePool.GetStats
+ */
+struct SurfacePoolStats
+{
+  /// Acquisitions served by an idle buffer
+  Uint64 hits = 0;
+
+  /// Acquisitions that allocated a new buffer
+  Uint64 misses = 0;
+
+  /// Buffers returned to the pool by destroyed surfaces
+  Uint64 reclaimed = 0;
+
+  /// Buffers freed instead of reclaimed, because the pool was full or gone
+  Uint64 discarded = 0;
+
+  /// Buffers currently used by surfaces
+  size_t activeBuffers = 0;
+
+  /// Buffers currently waiting for reuse
+  size_t idleBuffers = 0;
+
+  /// Bytes currently waiting for reuse
+  size_t idleBytes = 0;
+
+  /// Ratio of acquisitions served by an idle buffer, 0 if there was none.
+  double GetHitRate() const
+  {
+    Uint64 total = hits + misses;
+    return total ? double(hits) / double(total) : 0;
+  }
+};
+
+/**
+ * Hands out surfaces over pooled pixel buffers.
+ *
+ * The buffer of each surface is attached to its properties, and reclaimed
+ * when the surface is destroyed. Idle buffers are kept up to a byte budget,
+ * buffers returned beyond it are freed.
+ *
+ * Pixels of acquired surfaces are not cleared, they hold whatever the previous
+ * user left.
+ *
+ * @threadsafety It is safe to acquire and destroy surfaces from any thread.
+ */
+class SurfacePool
+{
+public:
+  /// Default budget for idle buffers, in bytes
+  static constexpr size_t DEFAULT_MAX_IDLE_BYTES = size_t(256) << 20;
+
+  /// Surface property holding the pooled buffer
+  static constexpr const char* PROP_BUFFER_POINTER =
+    "SDL3pp.SurfacePool.buffer";
+
+  /**
+   * Create an empty pool.
+   *
+   * @param maxIdleBytes the budget for idle buffers, in bytes.
+   */
+  SurfacePool(size_t maxIdleBytes = DEFAULT_MAX_IDLE_BYTES)
+    : m_state(std::make_shared<State>())
+  {
+    m_state->alignment = std::max(GetSIMDAlignment(), sizeof(void*));
+    m_state->maxIdleBytes = maxIdleBytes;
+  }
+
+  SurfacePool(const SurfacePool&) = delete;
+  SurfacePool& operator=(const SurfacePool&) = delete;
+
+  /// Free idle buffers. Buffers in use are freed with their surfaces.
+  ~SurfacePool()
+  {
+    std::lock_guard lock(m_state->mutex);
+    m_state->closed = true;
+    m_state->Trim(0);
+  }
+
+  /**
+   * Get a surface over a pooled buffer.
+   *
+   * @param size the width and height of the surface.
+   * @param format the pixel format, FourCC formats are not supported.
+   * @param pitch the length of a row in bytes, or 0 for the smallest one
+   *              aligned to GetSIMDAlignment().
+   * @returns a new surface, whose pixels are not cleared.
+   * @throws Error on failure.
+   */
+  Surface Acquire(const PointRaw& size, PixelFormat format, int pitch = 0)
+  {
+    if (size.x <= 0 || size.y <= 0 || format.IsFourCC()) {
+      SetError("Invalid surface size or format for SurfacePool");
+      throw Error();
+    }
+    int minPitch = GetMinimumPitch(size.x, format);
+    if (pitch == 0) {
+      size_t alignment = m_state->alignment;
+      pitch = int((size_t(minPitch) + alignment - 1) / alignment * alignment);
+    } else if (pitch < minPitch) {
+      SetError("Pitch too small for SurfacePool");
+      throw Error();
+    }
+
+    Key key{size.x, size.y, format, pitch};
+    void* buffer = m_state->Take(key);
+    Surface surface;
+    SDL_PropertiesID props = 0;
+    try {
+      surface = Surface(size, format, buffer, pitch);
+      props = surface.GetProperties();
+    } catch (...) {
+      m_state->Return(key, buffer);
+      throw;
+    }
+    // From here the cleanup owns the buffer, even if setting fails
+    SetPointerPropertyWithCleanup(
+      props, PROP_BUFFER_POINTER, buffer, &Reclaim, new Lease{m_state, key});
+    return surface;
+  }
+
+  /**
+   * Free idle buffers until they fit a budget.
+   *
+   * @param maxIdleBytes the number of idle bytes to keep at most.
+   */
+  void Trim(size_t maxIdleBytes = 0)
+  {
+    std::lock_guard lock(m_state->mutex);
+    m_state->Trim(maxIdleBytes);
+  }
+
+  /**
+   * Set the budget for idle buffers.
+   *
+   * Idle buffers beyond it are freed.
+   *
+   * @param maxIdleBytes the budget, in bytes.
+   */
+  void SetMaxIdleBytes(size_t maxIdleBytes)
+  {
+    std::lock_guard lock(m_state->mutex);
+    m_state->maxIdleBytes = maxIdleBytes;
+    m_state->Trim(maxIdleBytes);
+  }
+
+  /// Get the budget for idle buffers, in bytes.
+  size_t GetMaxIdleBytes() const
+  {
+    std::lock_guard lock(m_state->mutex);
+    return m_state->maxIdleBytes;
+  }
+
+  /**
+   * Get a snapshot of the pool statistics.
+   *
+   * @returns the statistics.
+   */
+  SurfacePoolStats GetStats() const
+  {
+    std::lock_guard lock(m_state->mutex);
+    return m_state->stats;
+  }
+
+  /// Reset the hit, miss, reclaimed and discarded counters.
+  void ResetStats()
+  {
+    std::lock_guard lock(m_state->mutex);
+    auto& stats = m_state->stats;
+    stats.hits = stats.misses = stats.reclaimed = stats.discarded = 0;
+  }
+
+  /**
+   * Get the smallest pitch for a row of pixels.
+   *
+   * @param width the row width in pixels.
+   * @param format the pixel format.
+   * @returns the pitch in bytes.
+   */
+  static int GetMinimumPitch(int width, PixelFormat format)
+  {
+    int bits = format.GetBitsPerPixel();
+    if (bits >= 8) return width * format.GetBytesPerPixel();
+    return (width * bits + 7) / 8;
+  }
+
+private:
+  struct Key
+  {
+    int w;
+    int h;
+    PixelFormatRaw format;
+    int pitch;
+
+    constexpr auto operator<=>(const Key&) const = default;
+
+    size_t GetBytes() const { return size_t(pitch) * size_t(h); }
+  };
+
+  struct State
+  {
+    mutable std::mutex mutex;
+    std::map<Key, std::vector<void*>> idle;
+    size_t alignment = 0;
+    size_t maxIdleBytes = 0;
+    bool closed = false;
+    SurfacePoolStats stats;
+
+    void* Take(const Key& key)
+    {
+      {
+        std::lock_guard lock(mutex);
+        stats.activeBuffers++;
+        auto it = idle.find(key);
+        if (it != idle.end() && !it->second.empty()) {
+          void* buffer = it->second.back();
+          it->second.pop_back();
+          stats.hits++;
+          stats.idleBuffers--;
+          stats.idleBytes -= key.GetBytes();
+          return buffer;
+        }
+        stats.misses++;
+      }
+      void* buffer = aligned_alloc(alignment, key.GetBytes());
+      if (!buffer) {
+        std::lock_guard lock(mutex);
+        stats.activeBuffers--;
+        throw Error();
+      }
+      return buffer;
+    }
+
+    void Return(const Key& key, void* buffer)
+    {
+      std::unique_lock lock(mutex);
+      stats.activeBuffers--;
+      if (closed || stats.idleBytes + key.GetBytes() > maxIdleBytes) {
+        stats.discarded++;
+        lock.unlock();
+        aligned_free(buffer);
+        return;
+      }
+      idle[key].push_back(buffer);
+      stats.reclaimed++;
+      stats.idleBuffers++;
+      stats.idleBytes += key.GetBytes();
+    }
+
+    /// Must be called with mutex held
+    void Trim(size_t maxBytes)
+    {
+      for (auto it = idle.begin();
+           it != idle.end() && stats.idleBytes > maxBytes;) {
+        auto& buffers = it->second;
+        while (!buffers.empty() && stats.idleBytes > maxBytes) {
+          aligned_free(buffers.back());
+          buffers.pop_back();
+          stats.idleBuffers--;
+          stats.idleBytes -= it->first.GetBytes();
+        }
+        it = buffers.empty() ? idle.erase(it) : std::next(it);
+      }
+    }
+  };
+
+  struct Lease
+  {
+    std::shared_ptr<State> state;
+    Key key;
+  };
+
+  static void SDLCALL Reclaim(void* userdata, void* value)
+  {
+    std::unique_ptr<Lease> lease{static_cast<Lease*>(userdata)};
+    lease->state->Return(lease->key, value);
+  }
+
+  std::shared_ptr<State> m_state;
+};
+
+/// @}
+
+} // namespace SDL
+
+#endif /* SDL3PP_SURFACE_POOL_H_ */
@@ -651,6 +651,43 @@ inline bool RequestAndroidPermission(StringParam permission,
   }
 }
 
+/**
+ * Request permissions at runtime, asynchronously.
+ *
+ * Same as RequestAndroidPermission(StringParam, RequestAndroidPermissionCB),
+ * but the callback is kept in a preallocated slot, so no heap allocation is
+ * done on our side to track it.
+ *
+ * @param permission the permission to request.
+ * @param cb the callback to trigger when the request has a response.
+ * @returns true if the request was submitted, false if there was an error
+ *          submitting. The result of the request is only ever reported through
+ *          the callback, not this return value.
+ *
+ * @threadsafety It is safe to call this function from any thread.
+ *
+ * @since This function is available since SDL 3.2.0.
+ *
+ * @sa result-callback
+ *
+ * @cat result-callback
+ */
+template<size_t SIZE>
+inline bool RequestAndroidPermission(
+  StringParam permission,
+  InplaceFunction<void(const char* permission, bool granted), SIZE> cb)
+{
+  using Wrapper = CallbackWrapper<
+    InplaceFunction<void(const char* permission, bool granted), SIZE>>;
+  auto callback = Wrapper::Wrap(std::move(cb));
+  if (RequestAndroidPermission(
+        std::move(permission), &Wrapper::CallOnce, callback)) {
+    return true;
+  }
+  Wrapper::release(callback);
+  return false;
+}
+
 /**
  * Shows an Android toast notification.
  *
@@ -0,0 +1,516 @@
+#ifndef SDL3PP_TEXTURE_ATLAS_H_
+#define SDL3PP_TEXTURE_ATLAS_H_
+
+#include <algorithm>
+#include <optional>
+#include <variant>
+#include <vector>
+#include "SDL3pp_render.h"
+
+namespace SDL {
+
+/**
+ * @defgroup CategoryTextureAtlas Texture atlas
+ *
+ * Pack many small images into few large textures.
+ *
+ * Sprites on separate textures can't be batched together. TextureAtlas copies
+ * surfaces, like the ones from LoadSurface() or Font.RenderGlyph_Blended(),
+ * into large page surfaces, and uploads each page as a single texture:
+ *
+ * ```cpp
+ * SDL::TextureAtlas atlas{renderer};
+ * std::vector<SDL::AtlasHandle> sprites;
+ * for (const char* path : paths) {
+ *   SDL::Surface surface = SDL::LoadSurface(path);
+ *   sprites.push_back(atlas.Add(surface));
+ * }
+ * atlas.Upload();
+ *
+ * auto& region = atlas.Get(sprites[0]);
+ * renderer.RenderTexture(atlas.GetTexture(region.page), region.rect, dst);
+ * ```
+ *
+ * Surfaces can be added at any time. Only the parts of the pages that changed
+ * are uploaded on the next Upload().
+ *
+ * @{
+ */
+
+/**
+ * Packs rectangles with the skyline bottom-left heuristic.
+ *
+ * It keeps only the top edge of the packed area, so inserting is fast, but
+ * space below that edge is lost. It works best with rectangles of similar
+ * heights, like glyphs.
+ *
+ * @sa MaxRectsPacker
+ */
+class SkylinePacker
+{
+  struct Node
+  {
+    int x;
+    int y;
+    int w;
+  };
+
+  Point m_size;
+  std::vector<Node> m_skyline;
+  Uint64 m_usedArea = 0;
+
+public:
+  /**
+   * Create a packer.
+   *
+   * @param size the area to pack into.
+   */
+  explicit SkylinePacker(const PointRaw& size)
+    : m_size(size)
+    , m_skyline{{0, 0, size.x}}
+  {
+  }
+
+  /**
+   * Find room for a rectangle.
+   *
+   * @param size the rectangle size.
+   * @returns the position of its top left corner, or std::nullopt if it does
+   *          not fit.
+   */
+  std::optional<Point> Insert(const PointRaw& size)
+  {
+    size_t best = m_skyline.size();
+    int bestY = 0, bestBottom = m_size.y + 1, bestWidth = 0;
+    for (size_t i = 0; i < m_skyline.size(); i++) {
+      int y = Fit(i, size);
+      if (y < 0) continue;
+      int bottom = y + size.y;
+      if (bottom < bestBottom ||
+          (bottom == bestBottom && m_skyline[i].w < bestWidth)) {
+        best = i;
+        bestY = y;
+        bestBottom = bottom;
+        bestWidth = m_skyline[i].w;
+      }
+    }
+    if (best == m_skyline.size()) return std::nullopt;
+
+    Point pos{m_skyline[best].x, bestY};
+    m_skyline.insert(m_skyline.begin() + best, {pos.x, bestBottom, size.x});
+    for (size_t i = best + 1; i < m_skyline.size();) {
+      Node& node = m_skyline[i];
+      int shrink = pos.x + size.x - node.x;
+      if (shrink <= 0) break;
+      node.x += shrink;
+      node.w -= shrink;
+      if (node.w > 0) break;
+      m_skyline.erase(m_skyline.begin() + i);
+    }
+    for (size_t i = 0; i + 1 < m_skyline.size();) {
+      if (m_skyline[i].y == m_skyline[i + 1].y) {
+        m_skyline[i].w += m_skyline[i + 1].w;
+        m_skyline.erase(m_skyline.begin() + i + 1);
+      } else {
+        i++;
+      }
+    }
+    m_usedArea += Uint64(size.x) * size.y;
+    return pos;
+  }
+
+  /**
+   * Get the area of all inserted rectangles.
+   *
+   * @returns the area in pixels.
+   */
+  Uint64 GetUsedArea() const { return m_usedArea; }
+
+private:
+  /// The y the rectangle would be placed at on node i, or -1
+  int Fit(size_t i, const PointRaw& size) const
+  {
+    int x = m_skyline[i].x;
+    if (x + size.x > m_size.x) return -1;
+    int y = 0;
+    for (int left = size.x; left > 0; i++) {
+      y = std::max(y, m_skyline[i].y);
+      if (y + size.y > m_size.y) return -1;
+      left -= m_skyline[i].w;
+    }
+    return y;
+  }
+};
+
+/**
+ * Packs rectangles with the maximal rectangles best short side fit heuristic.
+ *
+ * It tracks all free space, so it packs tighter than SkylinePacker, mostly
+ * with rectangles of mixed sizes, but inserting is slower.
+ *
+ * @sa SkylinePacker
+ */
+class MaxRectsPacker
+{
+  std::vector<Rect> m_free;
+  Uint64 m_usedArea = 0;
+
+public:
+  /**
+   * Create a packer.
+   *
+   * @param size the area to pack into.
+   */
+  explicit MaxRectsPacker(const PointRaw& size)
+    : m_free{Rect{0, 0, size.x, size.y}}
+  {
+  }
+
+  /**
+   * Find room for a rectangle.
+   *
+   * @param size the rectangle size.
+   * @returns the position of its top left corner, or std::nullopt if it does
+   *          not fit.
+   */
+  std::optional<Point> Insert(const PointRaw& size)
+  {
+    const Rect* best = nullptr;
+    int bestShort = 0, bestLong = 0;
+    for (const Rect& free : m_free) {
+      if (free.w < size.x || free.h < size.y) continue;
+      int dw = free.w - size.x;
+      int dh = free.h - size.y;
+      int shortSide = std::min(dw, dh);
+      int longSide = std::max(dw, dh);
+      if (!best || shortSide < bestShort ||
+          (shortSide == bestShort && longSide < bestLong)) {
+        best = &free;
+        bestShort = shortSide;
+        bestLong = longSide;
+      }
+    }
+    if (!best) return std::nullopt;
+
+    Rect used{best->x, best->y, size.x, size.y};
+    size_t count = m_free.size();
+    for (size_t i = 0; i < count;) {
+      if (Split(m_free[i], used)) {
+        m_free.erase(m_free.begin() + i);
+        count--;
+      } else {
+        i++;
+      }
+    }
+    Prune();
+    m_usedArea += Uint64(size.x) * size.y;
+    return Point{used.x, used.y};
+  }
+
+  /**
+   * Get the area of all inserted rectangles.
+   *
+   * @returns the area in pixels.
+   */
+  Uint64 GetUsedArea() const { return m_usedArea; }
+
+private:
+  /// Add the parts of free not covered by used, returns true if they overlap
+  bool Split(Rect free, const Rect& used)
+  {
+    if (used.x >= free.x + free.w || used.x + used.w <= free.x ||
+        used.y >= free.y + free.h || used.y + used.h <= free.y) {
+      return false;
+    }
+    if (used.x > free.x) {
+      m_free.push_back({free.x, free.y, used.x - free.x, free.h});
+    }
+    if (used.x + used.w < free.x + free.w) {
+      int x = used.x + used.w;
+      m_free.push_back({x, free.y, free.x + free.w - x, free.h});
+    }
+    if (used.y > free.y) {
+      m_free.push_back({free.x, free.y, free.w, used.y - free.y});
+    }
+    if (used.y + used.h < free.y + free.h) {
+      int y = used.y + used.h;
+      m_free.push_back({free.x, y, free.w, free.y + free.h - y});
+    }
+    return true;
+  }
+
+  /// Remove free rectangles contained in others
+  void Prune()
+  {
+    auto contains = [](const Rect& a, const Rect& b) {
+      return b.x >= a.x && b.y >= a.y && b.x + b.w <= a.x + a.w &&
+             b.y + b.h <= a.y + a.h;
+    };
+    for (size_t i = 0; i < m_free.size(); i++) {
+      for (size_t j = i + 1; j < m_free.size();) {
+        if (contains(m_free[i], m_free[j])) {
+          m_free.erase(m_free.begin() + j);
+        } else if (contains(m_free[j], m_free[i])) {
+          m_free.erase(m_free.begin() + i);
+          j = i + 1;
+        } else {
+          j++;
+        }
+      }
+    }
+  }
+};
+
+/**
+ * Packing heuristic used by TextureAtlas.
+ *
+ * @sa TextureAtlas
+ */
+enum AtlasPackMethod
+{
+  /// Use SkylinePacker, faster, best for images of similar heights.
+  ATLAS_PACK_SKYLINE,
+
+  /// Use MaxRectsPacker, tighter, best for images of mixed sizes.
+  ATLAS_PACK_MAXRECTS,
+};
+
+/// Identifies an image added to a TextureAtlas.
+using AtlasHandle = Uint32;
+
+/**
+ * Where an image is on a TextureAtlas.
+ *
+ * @sa TextureAtlas.Get
+ */
+struct AtlasRegion
+{
+  /// The page index, to pass to TextureAtlas.GetTexture()
+  Uint32 page;
+
+  /// The image rectangle on the page, in pixels
+  Rect rect;
+
+  /// The image rectangle on the page, in normalized texture coordinates
+  FRect uv;
+};
+
+/**
+ * Packs surfaces into pages and uploads them as textures.
+ *
+ * A new page is added when an image doesn't fit on the existing ones.
+ *
+ * @threadsafety This class should only be used on the main thread.
+ */
+class TextureAtlas
+{
+  struct Page
+  {
+    Surface surface;
+    Texture texture;
+    std::variant<SkylinePacker, MaxRectsPacker> packer;
+    Rect dirty;
+  };
+
+  RendererRef m_renderer;
+  Point m_pageSize;
+  PixelFormat m_format;
+  AtlasPackMethod m_method;
+  int m_padding;
+  std::vector<Page> m_pages;
+  std::vector<AtlasRegion> m_regions;
+  Uint64 m_usedArea = 0;
+
+public:
+  /**
+   * Create an atlas.
+   *
+   * @param renderer the renderer to create the textures on. It must outlive
+   *                 the atlas.
+   * @param pageSize the size of each page.
+   * @param method the packing heuristic.
+   * @param padding transparent pixels to leave between images, to avoid
+   *                bleeding with linear filtering.
+   * @param format the pixel format of the pages.
+   */
+  explicit TextureAtlas(RendererRef renderer,
+                        const PointRaw& pageSize = {1024, 1024},
+                        AtlasPackMethod method = ATLAS_PACK_SKYLINE,
+                        int padding = 1,
+                        PixelFormat format = PIXELFORMAT_RGBA32)
+    : m_renderer(renderer)
+    , m_pageSize(pageSize)
+    , m_format(format)
+    , m_method(method)
+    , m_padding(padding)
+  {
+  }
+
+  /**
+   * Add an image.
+   *
+   * The surface is copied, it can be destroyed after this returns. It is not
+   * visible on the page textures until the next Upload().
+   *
+   * @param surface the image.
+   * @returns the handle to find where it was placed with Get().
+   * @throws Error if the surface is larger than a page or on failure.
+   */
+  AtlasHandle Add(SurfaceRef surface)
+  {
+    Point size{surface->w, surface->h};
+    Point padded{size.x + m_padding, size.y + m_padding};
+    if (size.x > m_pageSize.x || size.y > m_pageSize.y) {
+      SetError("Surface is larger than the atlas page");
+      throw Error();
+    }
+    padded.x = std::min(padded.x, m_pageSize.x);
+    padded.y = std::min(padded.y, m_pageSize.y);
+
+    std::optional<Point> pos;
+    Uint32 index = 0;
+    for (; index < m_pages.size(); index++) {
+      pos = std::visit([&](auto& p) { return p.Insert(padded); },
+                       m_pages[index].packer);
+      if (pos) break;
+    }
+    if (!pos) {
+      AddPage();
+      pos = std::visit([&](auto& p) { return p.Insert(padded); },
+                       m_pages.back().packer);
+    }
+
+    Page& page = m_pages[index];
+    Rect rect{*pos, size};
+    BlendMode blendMode = surface.GetBlendMode();
+    surface.SetBlendMode(BLENDMODE_NONE);
+    try {
+      page.surface.Blit(surface, {}, rect);
+    } catch (...) {
+      surface.SetBlendMode(blendMode);
+      throw;
+    }
+    surface.SetBlendMode(blendMode);
+    page.dirty = page.dirty.Empty() ? rect : page.dirty.GetUnion(rect);
+
+    m_usedArea += Uint64(size.x) * size.y;
+    m_regions.push_back({index,
+                         rect,
+                         {float(rect.x) / m_pageSize.x,
+                          float(rect.y) / m_pageSize.y,
+                          float(rect.w) / m_pageSize.x,
+                          float(rect.h) / m_pageSize.y}});
+    return AtlasHandle(m_regions.size() - 1);
+  }
+
+  /**
+   * Get where an image was placed.
+   *
+   * @param handle the handle returned by Add().
+   * @returns the region.
+   */
+  const AtlasRegion& Get(AtlasHandle handle) const
+  {
+    return m_regions[handle];
+  }
+
+  /**
+   * Upload the changed parts of the pages to their textures.
+   *
+   * Textures are created here, for pages added since the last call.
+   *
+   * @throws Error on failure.
+   *
+   * @threadsafety This function should only be called on the main thread.
+   */
+  void Upload()
+  {
+    for (Page& page : m_pages) {
+      if (page.dirty.Empty()) continue;
+      if (!page.texture) {
+        page.texture = m_renderer.CreateTextureFromSurface(page.surface);
+        PixelFormat format = page.texture.GetFormat();
+        if (format != PixelFormat(page.surface->format)) {
+          // Keep the page in the texture format, so updates are plain copies
+          page.surface = page.surface.Convert(format);
+        }
+      } else {
+        auto& s = *page.surface.get();
+        int bpp = PixelFormat(s.format).GetBytesPerPixel();
+        auto pixels = static_cast<const Uint8*>(s.pixels) +
+                      page.dirty.y * s.pitch + page.dirty.x * bpp;
+        page.texture.Update(page.dirty, pixels, s.pitch);
+      }
+      page.dirty = {};
+    }
+  }
+
+  /**
+   * Get the texture of a page.
+   *
+   * @param page the page index.
+   * @returns the texture, or nullptr if it was not uploaded yet.
+   */
+  TextureRef GetTexture(Uint32 page) const
+  {
+    return m_pages[page].texture.get();
+  }
+
+  /**
+   * Get the surface of a page.
+   *
+   * @param page the page index.
+   * @returns the surface, it must not be modified.
+   */
+  SurfaceRef GetSurface(Uint32 page) const
+  {
+    return m_pages[page].surface.get();
+  }
+
+  /**
+   * Get the number of pages.
+   *
+   * @returns the number of pages.
+   */
+  Uint32 GetPageCount() const { return Uint32(m_pages.size()); }
+
+  /**
+   * Get the number of images added.
+   *
+   * @returns the number of images.
+   */
+  Uint32 GetCount() const { return Uint32(m_regions.size()); }
+
+  /**
+   * Get the packing efficiency.
+   *
+   * @returns the area covered by images divided by the area of all pages,
+   *          between 0 and 1, or 0 if there are no pages.
+   */
+  float GetEfficiency() const
+  {
+    if (m_pages.empty()) return 0;
+    double total = double(m_pageSize.x) * m_pageSize.y * m_pages.size();
+    return float(m_usedArea / total);
+  }
+
+private:
+  void AddPage()
+  {
+    Surface surface(m_pageSize, m_format);
+    surface.Clear(FColor{0, 0, 0, 0});
+    if (m_method == ATLAS_PACK_MAXRECTS) {
+      m_pages.push_back(
+        {std::move(surface), {}, MaxRectsPacker(m_pageSize), {}});
+    } else {
+      m_pages.push_back(
+        {std::move(surface), {}, SkylinePacker(m_pageSize), {}});
+    }
+  }
+};
+
+/// @}
+
+} // namespace SDL
+
+#endif /* SDL3PP_TEXTURE_ATLAS_H_ */
@@ -542,6 +542,40 @@ inline Thread CreateThread(ThreadCB fn, StringParam name)
   return Thread(std::move(fn), std::move(name));
 }
 
+/**
+ * Create a new thread with a default stack size.
+ *
+ * Same as CreateThread(ThreadCB, StringParam), but the function is kept in a
+ * preallocated slot until the thread starts, so no heap allocation is done on
+ * our side to track it.
+ *
+ * @param fn the function to call in the new thread.
+ * @param name the name of the thread.
+ * @returns an opaque pointer to the new thread object on success.
+ * @throws Error on failure.
+ *
+ * @threadsafety It is safe to call this function from any thread.
+ *
+ * @since This function is available since SDL 3.2.0.
+ *
+ * @sa Thread.Wait
+ * @sa result-callback
+ *
+ * @cat result-callback
+ */
+template<size_t SIZE>
+inline Thread CreateThread(InplaceFunction<int(), SIZE> fn, StringParam name)
+{
+  using Wrapper = CallbackWrapper<InplaceFunction<int(), SIZE>>;
+  void* userdata = Wrapper::Wrap(std::move(fn));
+  try {
+    return Thread(&Wrapper::CallOnce, std::move(name), userdata);
+  } catch (...) {
+    Wrapper::release(userdata);
+    throw;
+  }
+}
+
 inline Thread::Thread(ThreadFunction fn, StringParam name, void* data)
   : Thread(CheckError(SDL_CreateThread(fn, name, data)))
 {
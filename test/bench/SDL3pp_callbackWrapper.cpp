@@ -0,0 +1,33 @@
+#include "SDL3pp/SDL3pp_callbackWrapper.h"
+#include "doctest.h"
+#include <array>
+#include "bench.h"
+
+TEST_CASE("CallbackWrapper Wrap and CallOnce")
+{
+  constexpr int ITERATIONS = 1'000'000;
+  // A capture bigger than std::function small buffer, like a this pointer
+  // and a couple of values
+  std::array<void*, 3> capture{};
+  Uint64 total = 0;
+
+  using FunctionWrapper = SDL::CallbackWrapper<std::function<void(int)>>;
+  auto function = bench::Measure(ITERATIONS, [&](int i) {
+    void* handle = FunctionWrapper::Wrap([&total, capture](int v) {
+      total += v + (capture[0] != nullptr);
+    });
+    FunctionWrapper::CallOnce(handle, i);
+  });
+
+  using InplaceWrapper = SDL::CallbackWrapper<SDL::InplaceFunction<void(int)>>;
+  auto inplace = bench::Measure(ITERATIONS, [&](int i) {
+    void* handle = InplaceWrapper::Wrap([&total, capture](int v) {
+      total += v + (capture[0] != nullptr);
+    });
+    InplaceWrapper::CallOnce(handle, i);
+  });
+
+  MESSAGE("std::function " << function << ", InplaceFunction " << inplace
+                           << " (" << total << ")");
+  CHECK(inplace.allocations == 0);
+}
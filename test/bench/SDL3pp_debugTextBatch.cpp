@@ -0,0 +1,35 @@
+#include "SDL3pp/SDL3pp_debugTextBatch.h"
+#include "doctest.h"
+#include "bench.h"
+
+TEST_CASE("DebugTextBatch throughput")
+{
+  // Headless comparison against RenderDebugTextFormat(), one call per line
+  constexpr int LINES = 200;
+  constexpr int FRAMES = 20;
+  SDL::Surface target({128, 64}, SDL::PIXELFORMAT_RGBA32);
+  SDL::Renderer renderer(target);
+  SDL::DebugTextBatch batch(renderer);
+
+  bench::Cost direct = bench::Measure(FRAMES, [&](int) {
+    for (int i = 0; i < LINES; i++) {
+      renderer.RenderDebugTextFormat(
+        {0, float(i % 8 * 8)}, "line {:3} value {:8.3f}", i, i * 0.5);
+    }
+    renderer.Flush();
+  });
+  bench::Cost batched = bench::Measure(FRAMES, [&](int) {
+    for (int i = 0; i < LINES; i++) {
+      batch.DrawFormat(
+        {0, float(i % 8 * 8)}, "line {:3} value {:8.3f}", i, i * 0.5);
+    }
+    batch.Flush();
+    renderer.Flush();
+  });
+
+  // One more frame for the warm up
+  CHECK(batch.GetStats().drawCalls == FRAMES + 1);
+  CHECK(batch.GetStats().cacheMisses == LINES);
+  MESSAGE(LINES << " lines per frame: RenderDebugTextFormat " << direct
+                << ", DebugTextBatch " << batched);
+}
@@ -0,0 +1,59 @@
+#include "SDL3pp/SDL3pp_events.h"
+#include "doctest.h"
+#include "SDL3pp/SDL3pp_init.h"
+#include "bench.h"
+
+namespace {
+
+constexpr int QUEUED = 20'000;
+constexpr int REPEAT = 20;
+
+void PushMotion()
+{
+  SDL::FlushEvents(SDL::EVENT_FIRST, SDL::EVENT_LAST);
+  for (int i = 0; i < QUEUED; i++) {
+    SDL::Event event{.motion = {.type = SDL::EVENT_MOUSE_MOTION,
+                                .x = float(i),
+                                .y = float(i)}};
+    SDL::PushEvent(event);
+  }
+}
+
+/// Average nanoseconds to drain QUEUED events with drain()
+template<class F>
+double MeasureDrain(F drain)
+{
+  Uint64 total = 0;
+  for (int i = 0; i < REPEAT; i++) {
+    PushMotion();
+    Uint64 start = SDL::GetTicksNS();
+    int count = drain();
+    total += SDL::GetTicksNS() - start;
+    CHECK(count >= QUEUED);
+  }
+  return double(total) / REPEAT;
+}
+
+} // namespace
+
+TEST_CASE("Draining queued events")
+{
+  SDL::Init(SDL::INIT_EVENTS);
+
+  double single = MeasureDrain([] {
+    int count = 0;
+    while (auto event = SDL::PollEvent()) count++;
+    return count;
+  });
+  SDL::EventBatch batch{256};
+  double batched = MeasureDrain([&] {
+    int count = 0;
+    while (batch.Poll()) count += int(batch.size());
+    return count;
+  });
+
+  MESSAGE(QUEUED << " motion events: PollEvent " << single / QUEUED
+                 << "ns/event, EventBatch " << batched / QUEUED
+                 << "ns/event");
+  SDL::Quit();
+}
@@ -0,0 +1,41 @@
+#include "SDL3pp/SDL3pp_frameAllocator.h"
+#include "doctest.h"
+#include <array>
+#include "bench.h"
+
+namespace {
+
+constexpr int FRAMES = 10'000;
+constexpr int BLOCKS_PER_FRAME = 256;
+
+/// Allocate and free a frame worth of transient blocks of 16 to 1024 bytes
+void TransientFrame(int frame)
+{
+  std::array<void*, BLOCKS_PER_FRAME> blocks;
+  for (int i = 0; i < BLOCKS_PER_FRAME; i++) {
+    blocks[i] = SDL::malloc(size_t(16) << ((frame + i) % 7));
+    static_cast<char*>(blocks[i])[0] = char(i);
+  }
+  for (void* block : blocks) SDL::free(block);
+}
+
+} // namespace
+
+TEST_CASE("FrameAllocator per frame cost")
+{
+  auto previous = bench::Measure(FRAMES, TransientFrame);
+
+  SDL::FrameAllocator allocator;
+  auto pools = bench::Measure(FRAMES, TransientFrame);
+  auto arena = bench::Measure(FRAMES, [&](int frame) {
+    SDL::FrameScope scope{allocator};
+    TransientFrame(frame);
+  });
+
+  MESSAGE(BLOCKS_PER_FRAME << " blocks per frame: previous allocator "
+                           << previous.ns << "ns, pools " << pools.ns
+                           << "ns, arena " << arena.ns << "ns");
+  auto stats = allocator.GetStats();
+  CHECK(stats.retiredChunks == 0);
+  CHECK(stats.arenaOverflows == 0);
+}
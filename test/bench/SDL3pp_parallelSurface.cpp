@@ -0,0 +1,35 @@
+#include "SDL3pp/SDL3pp_parallelSurface.h"
+#include "doctest.h"
+#include <algorithm>
+#include <cstring>
+#include "bench.h"
+
+TEST_CASE("SurfaceThreadPool scaling")
+{
+  constexpr SDL::Point SIZE{3840, 2160};
+  constexpr int REPEAT = 4;
+
+  SDL::Surface layer(SIZE, SDL::PIXELFORMAT_RGBA32);
+  SDL::Surface canvas(SIZE, SDL::PIXELFORMAT_RGBA32);
+  std::memset(layer.GetPixels(), 0x80, size_t(layer.GetPitch()) * SIZE.y);
+  std::memset(canvas.GetPixels(), 0x40, size_t(canvas.GetPitch()) * SIZE.y);
+  SDL::Rect rect{0, 0, SIZE.x, SIZE.y};
+  Uint32 color = canvas.MapRGBA({10, 20, 30, 40});
+
+  int maxThreads = SDL::GetNumLogicalCPUCores();
+  for (int threads = 1;; threads = std::min(threads * 2, maxThreads)) {
+    SDL::SurfaceThreadPool pool(threads);
+    bench::Cost blit = bench::Measure(
+      REPEAT, [&](int) { pool.Blit(canvas, layer, nullptr, nullptr); });
+    bench::Cost fill = bench::Measure(REPEAT, [&](int) {
+      pool.FillRects(canvas, SDL::SpanRef<const SDL::RectRaw>(&rect, 1), color);
+    });
+    bench::Cost premultiply = bench::Measure(
+      REPEAT, [&](int) { pool.PremultiplyAlpha(canvas, false); });
+    MESSAGE(SIZE.x << "x" << SIZE.y << ", " << threads
+                   << " threads: blend blit " << blit.ns / 1000
+                   << "us, fill " << fill.ns / 1000 << "us, premultiply "
+                   << premultiply.ns / 1000 << "us");
+    if (threads == maxThreads) break;
+  }
+}
@@ -0,0 +1,100 @@
+#include "SDL3pp/SDL3pp_pixelConvert.h"
+#include "doctest.h"
+#include <algorithm>
+#include <string_view>
+#include <vector>
+#include "bench.h"
+
+namespace {
+
+const SDL::PixelConvertPath PATHS[] = {
+  SDL::PIXEL_CONVERT_SCALAR,
+  SDL::PIXEL_CONVERT_SSE2,
+  SDL::PIXEL_CONVERT_AVX2,
+  SDL::PIXEL_CONVERT_NEON,
+};
+
+const std::string_view PATH_NAMES[] = {"scalar", "SSE2", "AVX2", "NEON"};
+
+/// Millions of pixels converted per second
+double MPixelsPerSecond(const bench::Cost& cost, const SDL::Point& size)
+{
+  return double(size.x) * size.y * 1000 / cost.ns;
+}
+
+} // namespace
+
+TEST_CASE("Pixel conversion throughput")
+{
+  struct Case
+  {
+    SDL::PixelFormat src, dst;
+    std::string_view name;
+  };
+  const Case CASES[] = {
+    {SDL::PIXELFORMAT_RGBA8888, SDL::PIXELFORMAT_ARGB8888, "RGBA->ARGB"},
+    {SDL::PIXELFORMAT_ARGB8888, SDL::PIXELFORMAT_ABGR8888, "ARGB->ABGR"},
+    {SDL::PIXELFORMAT_XRGB8888, SDL::PIXELFORMAT_ARGB8888, "XRGB->ARGB"},
+    {SDL::PIXELFORMAT_RGB24, SDL::PIXELFORMAT_RGBA32, "RGB24->RGBA32"},
+  };
+  const SDL::Point SIZES[] = {{64, 64}, {512, 512}, {1920, 1080}};
+
+  for (auto& size : SIZES) {
+    std::vector<Uint8> src(size.x * size.y * 4, 0x5A);
+    std::vector<Uint8> dst(size.x * size.y * 4);
+    int repeat = std::max(1, 4000000 / (size.x * size.y));
+    for (auto& c : CASES) {
+      int src_pitch = size.x * c.src.GetBytesPerPixel();
+      bench::Cost sdl = bench::Measure(repeat, [&](int) {
+        SDL_ConvertPixels(size.x,
+                          size.y,
+                          c.src,
+                          src.data(),
+                          src_pitch,
+                          c.dst,
+                          dst.data(),
+                          size.x * 4);
+      });
+      MESSAGE(c.name << " " << size.x << "x" << size.y << " SDL: "
+                     << MPixelsPerSecond(sdl, size) << " Mpixels/s");
+      for (auto path : PATHS) {
+        if (!SDL::HasPixelConvertPath(path)) continue;
+        bench::Cost fast = bench::Measure(repeat, [&](int) {
+          SDL::ConvertPixelsFast(size,
+                                 c.src,
+                                 src.data(),
+                                 src_pitch,
+                                 c.dst,
+                                 dst.data(),
+                                 size.x * 4,
+                                 path);
+        });
+        MESSAGE(c.name << " " << size.x << "x" << size.y << " "
+                       << PATH_NAMES[path] << ": "
+                       << MPixelsPerSecond(fast, size) << " Mpixels/s");
+      }
+    }
+  }
+}
+
+TEST_CASE("Color mapping throughput")
+{
+  // Bulk color mapping against one call per color
+  constexpr int N = 1 << 20;
+  std::vector<SDL::Color> colors(N, SDL::Color(10, 20, 30, 40));
+  std::vector<Uint32> pixels(N);
+  const SDL::PixelFormatDetails& details =
+    SDL::PIXELFORMAT_ARGB8888.GetDetails();
+
+  bench::Cost single = bench::Measure(N, [&](int i) {
+    pixels[i] = SDL::MapColor(details, colors[i]);
+  });
+  MESSAGE("MapColor: " << 1000 / single.ns << " Mcolors/s");
+  for (auto path : PATHS) {
+    if (!SDL::HasPixelConvertPath(path)) continue;
+    bench::Cost bulk = bench::Measure(
+      1, [&](int) { SDL::MapColors(details, colors, pixels, {}, path); });
+    MESSAGE("MapColors " << PATH_NAMES[path] << ": " << N * 1000 / bulk.ns
+                         << " Mcolors/s");
+  }
+}
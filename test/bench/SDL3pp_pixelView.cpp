@@ -0,0 +1,37 @@
+#include "SDL3pp/SDL3pp_pixelView.h"
+#include "doctest.h"
+#include <cstring>
+#include "bench.h"
+
+TEST_CASE("PixelView throughput")
+{
+  constexpr SDL::Point SIZE{1920, 1080};
+  constexpr int REPEAT = 10;
+  SDL::Surface surface(SIZE, SDL::PIXELFORMAT_RGBA32);
+  std::memset(surface.GetPixels(), 0x5A, size_t(surface.GetPitch()) * SIZE.y);
+
+  bench::Cost direct = bench::Measure(REPEAT, [&](int) {
+    for (int y = 0; y < SIZE.y; y++) {
+      for (int x = 0; x < SIZE.x; x++) {
+        SDL::Color c = surface.ReadPixel({x, y});
+        surface.WritePixel({x, y}, SDL::Color(~c.r, ~c.g, ~c.b, c.a));
+      }
+    }
+  });
+
+  auto lock = surface.Lock();
+  SDL::PixelView<SDL::PIXELFORMAT_RGBA32> view(lock);
+  bench::Cost viewed = bench::Measure(REPEAT, [&](int) {
+    for (auto row : view) {
+      for (auto pixel : row) {
+        SDL::Color c = pixel;
+        pixel = SDL::Color(~c.r, ~c.g, ~c.b, c.a);
+      }
+    }
+  });
+
+  double pixels = double(SIZE.x) * SIZE.y;
+  MESSAGE("Invert " << SIZE.x << "x" << SIZE.y << ": Surface.ReadPixel "
+                    << pixels * 1000 / direct.ns << " Mpixels/s, PixelView "
+                    << pixels * 1000 / viewed.ns << " Mpixels/s");
+}
@@ -0,0 +1,60 @@
+#include "SDL3pp/SDL3pp_spatialIndex.h"
+#include "doctest.h"
+#include <vector>
+#include "bench.h"
+#include "testRandom.h"
+
+namespace {
+
+using test::Random;
+
+constexpr int OBJECTS = 20000;
+constexpr int QUERIES = 1000;
+
+/// Query every area, adding the number of results to found
+template<class INDEX>
+bench::Cost MeasureQueries(INDEX& index,
+                           const std::vector<SDL::FRect>& areas,
+                           size_t& found)
+{
+  std::vector<SDL::SpatialHandle> results;
+  return bench::Measure(QUERIES, [&](int i) {
+    results.clear();
+    index.Query(areas[i], results);
+    found += results.size();
+  });
+}
+
+} // namespace
+
+TEST_CASE("Spatial index queries")
+{
+  Random random;
+  std::vector<SDL::FRect> rects;
+  SDL::SpatialGrid grid(64);
+  SDL::AABBTree tree;
+  for (int i = 0; i < OBJECTS; i++) {
+    rects.push_back({random(8192), random(8192), random(48), random(48)});
+    grid.Insert(rects.back());
+    tree.Insert(rects.back());
+  }
+  std::vector<SDL::FRect> areas;
+  for (int i = 0; i < QUERIES; i++) {
+    areas.push_back({random(8192), random(8192), 640, 480});
+  }
+
+  size_t linearFound = 0;
+  bench::Cost linear = bench::Measure(QUERIES, [&](int i) {
+    for (auto& rect : rects) {
+      if (rect.HasIntersection(areas[i])) linearFound++;
+    }
+  });
+  size_t gridFound = 0, treeFound = 0;
+  bench::Cost gridCost = MeasureQueries(grid, areas, gridFound);
+  bench::Cost treeCost = MeasureQueries(tree, areas, treeFound);
+  CHECK(gridFound == linearFound);
+  CHECK(treeFound == linearFound);
+
+  MESSAGE(OBJECTS << " objects, per viewport query: linear " << linear
+                  << ", grid " << gridCost << ", tree " << treeCost);
+}
@@ -0,0 +1,41 @@
+#include "SDL3pp/SDL3pp_spriteBatch.h"
+#include "doctest.h"
+#include "bench.h"
+
+static SDL::Texture MakeTexture(SDL::RendererRef renderer, SDL::FColor color)
+{
+  SDL::Surface surface({8, 8}, SDL::PIXELFORMAT_RGBA32);
+  surface.Clear(color);
+  return SDL::Texture(renderer, surface);
+}
+
+TEST_CASE("SpriteBatch throughput")
+{
+  // Headless comparison against one RenderTexture() call per sprite
+  constexpr int COUNT = 10000;
+  SDL::Surface target({64, 64}, SDL::PIXELFORMAT_RGBA32);
+  SDL::Renderer renderer(target);
+  SDL::Texture red = MakeTexture(renderer, {1, 0, 0, 1});
+  SDL::Texture blue = MakeTexture(renderer, {0, 0, 1, 1});
+  SDL::SpriteBatch batch(renderer);
+  batch.SetSortByTexture(true);
+  auto place = [](int i) {
+    return SDL::FRect{float(i * 7 % 56), float(i * 13 % 56), 8, 8};
+  };
+
+  bench::Cost naive = bench::Measure(COUNT, [&](int i) {
+    renderer.RenderTexture(i % 2 ? red : blue, {}, place(i));
+    if (i == COUNT - 1) renderer.Flush();
+  });
+  bench::Cost batched = bench::Measure(COUNT, [&](int i) {
+    batch.Draw(i % 2 ? red : blue, {}, place(i));
+    if (i == COUNT - 1) {
+      batch.Flush();
+      renderer.Flush();
+    }
+  });
+
+  CHECK(batch.GetStats().drawCalls == 2);
+  MESSAGE("Per sprite: RenderTexture " << naive << ", SpriteBatch "
+                                       << batched);
+}
@@ -0,0 +1,37 @@
+#include "SDL3pp/SDL3pp_strings.h"
+#include "doctest.h"
+#include <string>
+#include <variant>
+#include "SDL3pp/SDL3pp_hints.h"
+#include "bench.h"
+
+TEST_CASE("StringParam from string_view")
+{
+  constexpr int ITERATIONS = 1'000'000;
+  const std::string name = "SDL_RENDER_VSYNC";
+  std::string_view key = name;
+
+  // What StringParam did before it had an inline buffer
+  auto copy = bench::Measure(ITERATIONS, [&](int) {
+    std::variant<const char*, std::string> data{std::string(key)};
+    SDL_assert_always(std::get<std::string>(data).size() == key.size());
+  });
+  auto inlined = bench::Measure(ITERATIONS, [&](int) {
+    SDL::StringParam param{key};
+    SDL_assert_always(static_cast<const char*>(param)[0] == 'S');
+  });
+  MESSAGE("16 chars view: std::string copy " << copy << ", StringParam "
+                                             << inlined);
+  CHECK(inlined.allocations == 0);
+}
+
+TEST_CASE("GetHint with string_view")
+{
+  constexpr int ITERATIONS = 100'000;
+  const std::string name = "SDL_RENDER_VSYNC";
+  auto cost = bench::Measure(ITERATIONS, [&](int) {
+    SDL::GetHint(std::string_view(name));
+  });
+  MESSAGE("GetHint(string_view): " << cost);
+  CHECK(cost.allocations == 0);
+}
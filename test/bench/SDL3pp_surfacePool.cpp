@@ -0,0 +1,25 @@
+#include "SDL3pp/SDL3pp_surfacePool.h"
+#include "doctest.h"
+#include "bench.h"
+
+TEST_CASE("SurfacePool throughput")
+{
+  constexpr SDL::Point SIZE{1920, 1080};
+  constexpr int REPEAT = 200;
+
+  bench::Cost create = bench::Measure(REPEAT, [&](int i) {
+    SDL::Surface surface(SIZE, SDL::PIXELFORMAT_RGBA32);
+    static_cast<Uint8*>(surface.GetPixels())[i] = Uint8(i);
+  });
+
+  SDL::SurfacePool pool;
+  bench::Cost acquire = bench::Measure(REPEAT, [&](int i) {
+    SDL::Surface surface = pool.Acquire(SIZE, SDL::PIXELFORMAT_RGBA32);
+    static_cast<Uint8*>(surface.GetPixels())[i] = Uint8(i);
+  });
+
+  CHECK(pool.GetStats().misses == 1);
+  MESSAGE(SIZE.x << "x" << SIZE.y << ": Surface " << create
+                 << ", SurfacePool.Acquire " << acquire << ", hit rate "
+                 << pool.GetStats().GetHitRate());
+}
@@ -0,0 +1,27 @@
+#include "bench.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<Uint64> allocationCount{0};
+
+} // namespace
+
+// The other non aligned forms of operator new and delete forward to these
+void* operator new(std::size_t size)
+{
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  if (void* mem = std::malloc(size ? size : 1)) return mem;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* mem) noexcept { std::free(mem); }
+
+void operator delete(void* mem, std::size_t) noexcept { std::free(mem); }
+
+Uint64 bench::GetAllocationCount()
+{
+  return allocationCount.load(std::memory_order_relaxed);
+}
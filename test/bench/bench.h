@@ -0,0 +1,50 @@
+#ifndef SDL3PP_BENCH_H_
+#define SDL3PP_BENCH_H_
+
+#include <ostream>
+#include <SDL3pp/SDL3pp_stdinc.h>
+#include <SDL3pp/SDL3pp_timer.h>
+
+namespace bench {
+
+/// Number of calls to operator new so far, on all threads
+Uint64 GetAllocationCount();
+
+/// Per iteration cost of a benchmarked function
+struct Cost
+{
+  /// Average duration, in nanoseconds
+  double ns;
+
+  /// Average number of operator new calls
+  double allocations;
+};
+
+/// Print as "<ns>ns, <allocations> allocs"
+inline std::ostream& operator<<(std::ostream& out, const Cost& cost)
+{
+  return out << cost.ns << "ns, " << cost.allocations << " allocs";
+}
+
+/**
+ * Run a function after a warm up call and measure its average cost.
+ *
+ * @param iterations the number of measured calls.
+ * @param f the function, called with the iteration index.
+ * @returns the average cost of a call.
+ */
+template<class F>
+Cost Measure(int iterations, F&& f)
+{
+  f(0);
+  Uint64 allocations = GetAllocationCount();
+  Uint64 start = SDL::GetTicksNS();
+  for (int i = 0; i < iterations; i++) f(i);
+  Uint64 elapsed = SDL::GetTicksNS() - start;
+  allocations = GetAllocationCount() - allocations;
+  return {double(elapsed) / iterations, double(allocations) / iterations};
+}
+
+} // namespace bench
+
+#endif /* SDL3PP_BENCH_H_ */
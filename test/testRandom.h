@@ -0,0 +1,58 @@
+#ifndef SDL3PP_TEST_RANDOM_H_
+#define SDL3PP_TEST_RANDOM_H_
+
+#include <vector>
+#include <SDL3pp/SDL3pp_stdinc.h>
+#include <SDL3pp/SDL3pp_surface.h>
+
+namespace test {
+
+/// Linear congruential generator, so tests and benchmarks are reproducible
+struct Random
+{
+  Uint32 state = 12345;
+
+  /// Next 32 bit value
+  Uint32 Next()
+  {
+    state = state * 1664525 + 1013904223;
+    return state;
+  }
+
+  /// Next byte, from the high bits which are the most random ones
+  Uint8 NextByte() { return Uint8(Next() >> 24); }
+
+  /// Next float in [0, max)
+  float operator()(float max)
+  {
+    return float(Next() >> 8) / float(1 << 24) * max;
+  }
+};
+
+/// Random bytes, the same ones for a given seed
+inline std::vector<Uint8> RandomBytes(size_t size, Uint32 seed = 12345)
+{
+  Random random{seed};
+  std::vector<Uint8> bytes(size);
+  for (auto& byte : bytes) byte = random.NextByte();
+  return bytes;
+}
+
+/// Surface filled with random bytes, padding included
+inline SDL::Surface RandomSurface(
+  const SDL::Point& size,
+  SDL::PixelFormat format = SDL::PIXELFORMAT_RGBA32,
+  Uint32 seed = 12345)
+{
+  SDL::Surface surface(size, format);
+  Random random{seed};
+  auto pixels = static_cast<Uint8*>(surface.GetPixels());
+  for (int i = 0; i < surface.GetPitch() * size.y; i++) {
+    pixels[i] = random.NextByte();
+  }
+  return surface;
+}
+
+} // namespace test
+
+#endif // SDL3PP_TEST_RANDOM_H_
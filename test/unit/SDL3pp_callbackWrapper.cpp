@@ -1,2 +1,106 @@
 #include "SDL3pp/SDL3pp_callbackWrapper.h"
 #include "doctest.h"
+#include <vector>
+
+namespace SDL {
+
+TEST_CASE("InplaceFunction")
+{
+  int calls = 0;
+  InplaceFunction<int(int)> f = [&calls](int v) {
+    calls++;
+    return v * 2;
+  };
+  REQUIRE(bool(f));
+  CHECK(f(21) == 42);
+  CHECK(calls == 1);
+
+  SUBCASE("move")
+  {
+    InplaceFunction<int(int)> g{std::move(f)};
+    CHECK_FALSE(f);
+    REQUIRE(bool(g));
+    CHECK(g(2) == 4);
+    CHECK(calls == 2);
+  }
+  SUBCASE("reset")
+  {
+    f.reset();
+    CHECK_FALSE(f);
+  }
+}
+
+TEST_CASE("InplaceFunction destroys its callable")
+{
+  auto counter = std::make_shared<int>(0);
+  {
+    InplaceFunction<void()> f = [counter] { ++*counter; };
+    CHECK(counter.use_count() == 2);
+    InplaceFunction<void()> g;
+    g = std::move(f);
+    CHECK(counter.use_count() == 2);
+    g();
+  }
+  CHECK(*counter == 1);
+  CHECK(counter.use_count() == 1);
+}
+
+TEST_CASE("Discarding the result")
+{
+  int calls = 0;
+  auto count = [&calls] { return ++calls; };
+  InplaceFunction<void()> f = count;
+  f();
+  FunctionRef<void()> ref = count;
+  ref();
+  CHECK(calls == 2);
+}
+
+TEST_CASE("FunctionRef")
+{
+  int total = 0;
+  auto add = [&total](int v) { total += v; };
+  FunctionRef<void(int)> ref = add;
+  ref(2);
+  ref(3);
+  CHECK(total == 5);
+
+  using Wrapper = CallbackWrapper<FunctionRef<void(int)>>;
+  void* handle = Wrapper::Wrap(ref);
+  Wrapper::Call(handle, 5);
+  CHECK(total == 10);
+}
+
+TEST_CASE("CallbackWrapper of InplaceFunction")
+{
+  using Function = InplaceFunction<int(int)>;
+  using Wrapper = CallbackWrapper<Function>;
+
+  SUBCASE("call once")
+  {
+    int base = 40;
+    void* handle = Wrapper::Wrap([base](int v) { return base + v; });
+    CHECK(Wrapper::Call(handle, 1) == 41);
+    CHECK(Wrapper::CallOnce(handle, 2) == 42);
+  }
+  SUBCASE("slots are reused")
+  {
+    void* first = Wrapper::Wrap([](int v) { return v; });
+    CHECK(Wrapper::CallOnce(first, 1) == 1);
+    void* second = Wrapper::Wrap([](int v) { return v; });
+    CHECK(second == first);
+    CHECK(Wrapper::CallOnce(second, 2) == 2);
+  }
+  SUBCASE("exhausted pool falls back to heap")
+  {
+    std::vector<void*> handles;
+    for (int i = 0; i <= int(Wrapper::POOL_SIZE); i++) {
+      handles.push_back(Wrapper::Wrap([i](int v) { return i + v; }));
+    }
+    for (int i = 0; i <= int(Wrapper::POOL_SIZE); i++) {
+      CHECK(Wrapper::CallOnce(handles[i], 1) == i + 1);
+    }
+  }
+}
+
+} // namespace SDL
@@ -0,0 +1,94 @@
+#include "SDL3pp/SDL3pp_capturePipeline.h"
+#include "doctest.h"
+#include <atomic>
+#include <set>
+#include <vector>
+
+TEST_CASE("CapturePipeline")
+{
+  SDL::Surface target({32, 24}, SDL::PIXELFORMAT_ARGB8888);
+  SDL::Renderer renderer(target);
+  renderer.SetDrawColor(SDL::Color{10, 20, 30, 255});
+  renderer.RenderClear();
+
+  SUBCASE("Block")
+  {
+    std::mutex mutex;
+    std::set<Uint64> indexes;
+    std::atomic<int> matching{0};
+    {
+      SDL::CapturePipeline capture(
+        [&](SDL::SurfaceRef frame, Uint64 index) {
+          if (frame->w == 32 && frame->h == 24 &&
+              frame->format == SDL_PIXELFORMAT_RGBA32 &&
+              frame.ReadPixel({5, 5}) == SDL::Color{10, 20, 30, 255}) {
+            matching++;
+          }
+          std::lock_guard lock{mutex};
+          indexes.insert(index);
+        },
+        SDL::PIXELFORMAT_RGBA32,
+        2,
+        2,
+        SDL::CAPTURE_BLOCK);
+      for (int i = 0; i < 10; i++) CHECK(capture.Capture(renderer));
+      capture.Flush();
+      auto stats = capture.GetStats();
+      CHECK(stats.captured == 10);
+      CHECK(stats.encoded == 10);
+      CHECK(stats.dropped == 0);
+      CHECK(stats.maxInFlight <= 2);
+    }
+    CHECK(matching == 10);
+    CHECK(indexes.size() == 10);
+    CHECK(*indexes.rbegin() == 9);
+  }
+
+  SUBCASE("Drop")
+  {
+    std::atomic<bool> release{false};
+    SDL::CapturePipeline capture(
+      [&](SDL::SurfaceRef, Uint64 index) {
+        while (!release) SDL::Delay(1);
+        if (index == 1) throw SDL::Error("encoding failed");
+      },
+      SDL::PIXELFORMAT_RGBA32,
+      2,
+      1);
+    CHECK(capture.Capture(renderer));
+    CHECK(capture.Capture(renderer));
+    CHECK_FALSE(capture.Capture(renderer));
+    CHECK_FALSE(capture.Capture(renderer));
+    release = true;
+    capture.Flush();
+    CHECK(capture.Capture(renderer));
+    capture.Flush();
+
+    auto stats = capture.GetStats();
+    CHECK(stats.captured == 3);
+    CHECK(stats.dropped == 2);
+    CHECK(stats.encoded == 2);
+    CHECK(stats.failed == 1);
+  }
+
+  SUBCASE("Reserve")
+  {
+    std::vector<SDL::Point> sizes;
+    SDL::CapturePipeline capture(
+      [&](SDL::SurfaceRef frame, Uint64) {
+        sizes.push_back({frame->w, frame->h});
+      },
+      SDL::PIXELFORMAT_RGBA32,
+      2,
+      1,
+      SDL::CAPTURE_BLOCK);
+    capture.Reserve({32, 24});
+    CHECK(capture.Capture(renderer));
+    capture.Flush();
+    CHECK(capture.Capture(renderer, SDL::Rect{0, 0, 8, 4}));
+    capture.Flush();
+    REQUIRE(sizes.size() == 2);
+    CHECK(sizes[0] == SDL::Point{32, 24});
+    CHECK(sizes[1] == SDL::Point{8, 4});
+  }
+}
@@ -0,0 +1,56 @@
+#include "SDL3pp/SDL3pp_debugTextBatch.h"
+#include "doctest.h"
+
+TEST_CASE("DebugTextBatch")
+{
+  SDL::Surface target({128, 64}, SDL::PIXELFORMAT_RGBA32);
+  SDL::Renderer renderer(target);
+  renderer.SetDrawColor(SDL::Color{0, 0, 0, 255});
+  SDL::DebugTextBatch batch(renderer);
+
+  SUBCASE("Matches RenderDebugText")
+  {
+    const char* text = "Hi! {x} \xC3\xA9\xE2\x82\xAC";
+    renderer.RenderClear();
+    renderer.SetDrawColor(SDL::Color{255, 255, 255, 255});
+    renderer.RenderDebugText({3, 5}, text);
+    SDL::Surface expected = renderer.ReadPixels();
+
+    renderer.SetDrawColor(SDL::Color{0, 0, 0, 255});
+    renderer.RenderClear();
+    batch.Draw({3, 5}, text);
+    batch.Flush();
+    SDL::Surface actual = renderer.ReadPixels();
+
+    int lit = 0, mismatches = 0;
+    for (int y = 0; y < 64; y++) {
+      for (int x = 0; x < 128; x++) {
+        SDL::Color color = expected.ReadPixel({x, y});
+        if (color.r) lit++;
+        if (color != actual.ReadPixel({x, y})) mismatches++;
+      }
+    }
+    CHECK(lit > 0);
+    CHECK(mismatches == 0);
+    CHECK(batch.GetStats().drawCalls == 1);
+  }
+
+  SUBCASE("Cache")
+  {
+    batch.SetCacheFrames(1);
+    for (int frame = 0; frame < 3; frame++) {
+      batch.Draw({0, 0}, "static");
+      batch.DrawFormat({0, 8}, "frame {}", frame);
+      batch.Flush();
+    }
+    auto stats = batch.GetStats();
+    CHECK(stats.strings == 6);
+    CHECK(stats.cacheHits == 2);
+    CHECK(stats.cacheMisses == 4);
+    CHECK(stats.glyphs == 3 * (6 + 6));
+    CHECK(stats.drawCalls == 3);
+    CHECK(stats.evicted == 1);
+    CHECK(batch.GetCacheSize() == 3);
+    CHECK(batch.empty());
+  }
+}
@@ -0,0 +1,74 @@
+#include "SDL3pp/SDL3pp_dirtyRegion.h"
+#include "SDL3pp/SDL3pp_hints.h"
+#include "SDL3pp/SDL3pp_init.h"
+#include "doctest.h"
+
+TEST_CASE("DirtyRegion")
+{
+  SDL::DirtyRegion dirty({640, 480});
+  REQUIRE(dirty.GetRects().size() == 1);
+  CHECK(dirty.GetRects()[0] == SDL::Rect{0, 0, 640, 480});
+  dirty.clear();
+  CHECK(dirty.empty());
+  dirty.SetMergeCost(0);
+
+  SUBCASE("Clipping")
+  {
+    dirty.Add(SDL::Rect{600, 460, 100, 100});
+    dirty.Add(SDL::Rect{-50, -50, 10, 10});
+    REQUIRE(dirty.GetRects().size() == 1);
+    CHECK(dirty.GetRects()[0] == SDL::Rect{600, 460, 40, 20});
+  }
+
+  SUBCASE("Merging")
+  {
+    dirty.Add(SDL::Rect{10, 10, 20, 20});
+    dirty.Add(SDL::Rect{15, 15, 10, 10}); // contained
+    CHECK(dirty.GetRects().size() == 1);
+    dirty.Add(SDL::Rect{30, 10, 20, 20}); // adjacent, no waste
+    REQUIRE(dirty.GetRects().size() == 1);
+    CHECK(dirty.GetRects()[0] == SDL::Rect{10, 10, 40, 20});
+    dirty.Add(SDL::Rect{300, 300, 10, 10}); // far away
+    CHECK(dirty.GetRects().size() == 2);
+
+    // Bridging two rectangles merges all three
+    dirty.SetMergeCost(100000);
+    dirty.Add(SDL::Rect{40, 20, 270, 290});
+    REQUIRE(dirty.GetRects().size() == 1);
+    CHECK(dirty.GetRects()[0] == SDL::Rect{10, 10, 300, 300});
+  }
+
+  SUBCASE("Limit")
+  {
+    SDL::DirtyRegion limited({640, 480}, 4);
+    limited.clear();
+    limited.SetMergeCost(0);
+    for (int i = 0; i < 10; i++) limited.Add(SDL::Rect{i * 60, 0, 10, 10});
+    CHECK(limited.GetRects().size() == 4);
+  }
+
+  SUBCASE("Present")
+  {
+    SDL::SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+    SDL::Init(SDL::INIT_VIDEO);
+    {
+      SDL::Window window("DirtyRegion", {64, 48});
+      SDL::Surface surface = window.GetSurface();
+      SDL::DirtyRegion region(window.GetSizeInPixels());
+      region.Present(window);
+      CHECK(region.GetStats().lastPixels == 64 * 48);
+
+      region.Present(window);
+      CHECK(region.GetStats().idleFrames == 1);
+      CHECK(region.GetStats().lastPixels == 0);
+
+      region.Add(SDL::Rect{4, 4, 8, 8});
+      region.Present(window);
+      CHECK(region.GetStats().lastRects == 1);
+      CHECK(region.GetStats().lastPixels == 64);
+      CHECK(region.GetStats().pixels == 64 * 48 + 64);
+      CHECK(region.GetStats().frames == 3);
+    }
+    SDL::Quit();
+  }
+}
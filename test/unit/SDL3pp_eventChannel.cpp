@@ -0,0 +1,70 @@
+#include "SDL3pp/SDL3pp_eventChannel.h"
+#include "SDL3pp/SDL3pp_init.h"
+#include "doctest.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("EventChannel")
+{
+  SDL::Init(SDL::INIT_EVENTS);
+  {
+    SDL::EventChannel<std::string> channel{8};
+
+    SUBCASE("single wake event")
+    {
+      CHECK(channel.Push("a"));
+      CHECK(channel.Push("b"));
+      SDL::Event event;
+      int wakes = 0;
+      while (SDL::PollEvent(&event)) wakes += channel.IsWakeEvent(event);
+      CHECK(wakes == 1);
+
+      std::vector<std::string> received;
+      CHECK(channel.Drain([&](std::string&& s) { received.push_back(s); }) ==
+            2);
+      CHECK(received == std::vector<std::string>{"a", "b"});
+
+      CHECK(channel.Push("c"));
+      CHECK(SDL::HasEvent(channel.GetEventType()));
+    }
+    SUBCASE("full")
+    {
+      for (int i = 0; i < 8; i++) CHECK(channel.Push(std::to_string(i)));
+      CHECK_FALSE(channel.Push("overflow"));
+      std::string message;
+      REQUIRE(channel.TryPop(message));
+      CHECK(message == "0");
+      CHECK(channel.Push("8"));
+    }
+    SUBCASE("multiple producers")
+    {
+      constexpr int PER_THREAD = 1000;
+      std::vector<std::thread> producers;
+      for (int t = 0; t < 4; t++) {
+        producers.emplace_back([&channel, t] {
+          for (int i = 0; i < PER_THREAD; i++) {
+            while (!channel.Push(std::to_string(t * PER_THREAD + i))) {
+              std::this_thread::yield();
+            }
+          }
+        });
+      }
+      int last[4] = {-1, -1, -1, -1};
+      size_t received = 0;
+      bool ordered = true;
+      while (received < 4 * PER_THREAD) {
+        received += channel.Drain([&](std::string&& s) {
+          int value = std::stoi(s);
+          int& prev = last[value / PER_THREAD];
+          ordered = ordered && value % PER_THREAD > prev;
+          prev = value % PER_THREAD;
+        });
+      }
+      for (auto& producer : producers) producer.join();
+      CHECK(ordered);
+      CHECK(received == 4 * PER_THREAD);
+    }
+  }
+  SDL::Quit();
+}
@@ -0,0 +1,73 @@
+#include "SDL3pp/SDL3pp_eventDispatcher.h"
+#include "SDL3pp/SDL3pp_init.h"
+#include "doctest.h"
+#include <vector>
+
+namespace SDL {
+
+static Event MakeEvent(Uint32 type)
+{
+  Event event{};
+  event.type = type;
+  return event;
+}
+
+TEST_CASE("EventDispatcher")
+{
+  int keys = 0, motions = 0, users = 0, others = 0;
+  EventDispatcher dispatch{
+    [&](const KeyboardEvent& key) { keys += key.type == EVENT_KEY_UP; },
+    [&](MouseMotionEvent motion) { motions += int(motion.x); },
+    [&](UserEvent& user) { users += user.code; },
+    [&](const Event&) { others++; },
+  };
+
+  Event motion = MakeEvent(EVENT_MOUSE_MOTION);
+  motion.motion.x = 5;
+  Event user = MakeEvent(EVENT_USER + 3);
+  user.user.code = 2;
+
+  dispatch(MakeEvent(EVENT_KEY_UP));
+  dispatch(motion);
+  dispatch(user);
+  dispatch(MakeEvent(EVENT_QUIT));
+  CHECK(keys == 1);
+  CHECK(motions == 5);
+  CHECK(users == 2);
+  CHECK(others == 1);
+}
+
+TEST_CASE("EventDispatcher const events")
+{
+  const KeyboardEvent* seen = nullptr;
+  EventDispatcher dispatch{
+    [&](const KeyboardEvent& key) { seen = &key; },
+    [&](UserEvent& user) { user.code = 7; },
+  };
+
+  // Only handlers taking a mutable reference get a copy
+  const Event key = MakeEvent(EVENT_KEY_DOWN);
+  dispatch(key);
+  CHECK(seen == &key.key);
+
+  const Event user = MakeEvent(EVENT_USER);
+  dispatch(user);
+  CHECK(user.user.code == 0);
+}
+
+TEST_CASE("EventDispatcher results")
+{
+  EventDispatcher dispatch{
+    [](const QuitEvent&) { return APP_SUCCESS; },
+    [](const WindowEvent&) { return APP_CONTINUE; },
+  };
+  CHECK(dispatch(MakeEvent(EVENT_WINDOW_RESIZED)) == APP_CONTINUE);
+  CHECK(dispatch(MakeEvent(EVENT_KEY_DOWN)) == APP_CONTINUE);
+
+  std::vector<Event> events{MakeEvent(EVENT_WINDOW_SHOWN),
+                            MakeEvent(EVENT_QUIT),
+                            MakeEvent(EVENT_KEY_DOWN)};
+  CHECK(dispatch(events) == APP_SUCCESS);
+}
+
+} // namespace SDL
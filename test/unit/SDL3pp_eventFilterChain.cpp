@@ -0,0 +1,117 @@
+#include "SDL3pp/SDL3pp_eventFilterChain.h"
+#include "SDL3pp/SDL3pp_init.h"
+#include "doctest.h"
+#include <atomic>
+#include <string>
+#include <thread>
+
+static void PushUser(Sint32 code)
+{
+  SDL::Event event{};
+  event.user.type = SDL::EVENT_USER;
+  event.user.code = code;
+  SDL::PushEvent(event);
+}
+
+TEST_CASE("EventFilterChain")
+{
+  SDL::Init(SDL::INIT_EVENTS);
+  SDL::FlushEvents();
+  {
+    SDL::EventFilterChain chain;
+    std::string order;
+    auto low = chain.Add(
+      [&](SDL::Event*) {
+        order += 'L';
+        return true;
+      },
+      -10,
+      "low");
+    chain.Add(
+      [&](SDL::Event* event) {
+        order += 'H';
+        return event->user.code != 0;
+      },
+      10,
+      "high");
+    chain.Add(
+      [&](SDL::Event*) {
+        order += 'M';
+        return true;
+      },
+      0,
+      "mid");
+
+    PushUser(1);
+    CHECK(order == "HML");
+    CHECK(SDL::HasEvent(SDL::EVENT_USER));
+    SDL::FlushEvents();
+
+    order.clear();
+    PushUser(0);
+    CHECK(order == "H");
+    CHECK_FALSE(SDL::HasEvent(SDL::EVENT_USER));
+
+    auto stats = chain.GetStats();
+    REQUIRE(stats.size() == 3);
+    CHECK(stats[0].name == "high");
+    CHECK(stats[0].calls == 2);
+    CHECK(stats[0].dropped == 1);
+    CHECK(stats[2].name == "low");
+    CHECK(stats[2].calls == 1);
+    CHECK(stats[0].maxNS <= stats[0].totalNS);
+
+    CHECK(chain.Remove(low));
+    CHECK_FALSE(chain.Remove(low));
+    order.clear();
+    PushUser(1);
+    CHECK(order == "HM");
+
+    chain.ResetStats();
+    CHECK(chain.GetStats()[0].calls == 0);
+  }
+  SDL::FlushEvents();
+  SDL::Quit();
+}
+
+TEST_CASE("EventFilterChain changed from a filter")
+{
+  SDL::Init(SDL::INIT_EVENTS);
+  {
+    SDL::EventFilterChain chain;
+    int added = 0;
+    SDL::EventFilterID self = 0;
+    self = chain.Add([&](SDL::Event*) {
+      chain.Remove(self);
+      chain.Add([&](SDL::Event*) {
+        added++;
+        return true;
+      });
+      return true;
+    });
+    PushUser(1);
+    PushUser(2);
+    CHECK(added == 1);
+    CHECK(chain.GetStats().size() == 1);
+  }
+  SDL::FlushEvents();
+  SDL::Quit();
+}
+
+TEST_CASE("EventFilterChain teardown while filtering")
+{
+  SDL::Init(SDL::INIT_EVENTS);
+  std::atomic<bool> done{false};
+  std::thread worker([&] {
+    while (!done) PushUser(0);
+  });
+  for (int i = 0; i < 100; i++) {
+    SDL::EventFilterChain chain;
+    chain.Add([](SDL::Event*) { return false; });
+    SDL::FlushEvents();
+  }
+  done = true;
+  worker.join();
+  SDL::FlushEvents();
+  SDL::Quit();
+}
@@ -0,0 +1,71 @@
+#include "SDL3pp/SDL3pp_eventRecorder.h"
+#include "SDL3pp/SDL3pp_init.h"
+#include "doctest.h"
+#include <string_view>
+
+static void PushUser(Sint32 code)
+{
+  SDL::Event event{};
+  event.user.type = SDL::EVENT_USER;
+  event.user.code = code;
+  SDL::PushEvent(event);
+}
+
+TEST_CASE("EventRecorder and EventPlayer")
+{
+  SDL::Init(SDL::INIT_EVENTS);
+  SDL::FlushEvents();
+  SDL::IOStream stream = SDL::IOStream::FromDynamicMem();
+  {
+    SDL::EventRecorder recorder{stream};
+    recorder.MarkFrame();
+    PushUser(1);
+    SDL::Event text{};
+    text.text.type = SDL::EVENT_TEXT_INPUT;
+    text.text.text = "recorded text";
+    SDL::PushEvent(text);
+    recorder.MarkFrame();
+    PushUser(2);
+    CHECK(recorder.GetEventCount() == 3);
+    CHECK(recorder.GetFrameCount() == 2);
+  }
+  SDL::FlushEvents();
+  stream.Seek(0, SDL::IO_SEEK_SET);
+
+  SUBCASE("frame step")
+  {
+    SDL::EventPlayer player{stream, SDL::PLAYBACK_FRAME_STEP};
+    CHECK(player.GetRecordCount() == 5);
+
+    CHECK(player.Update() == 2);
+    SDL::Event event;
+    REQUIRE(SDL::PollEvent(&event));
+    CHECK(event.type == SDL::EVENT_USER);
+    CHECK(event.user.code == 1);
+    REQUIRE(SDL::PollEvent(&event));
+    CHECK(event.type == SDL::EVENT_TEXT_INPUT);
+    CHECK(std::string_view(event.text.text) == "recorded text");
+    CHECK_FALSE(player.IsDone());
+
+    CHECK(player.Update() == 1);
+    REQUIRE(SDL::PollEvent(&event));
+    CHECK(event.user.code == 2);
+    CHECK(player.IsDone());
+  }
+  SUBCASE("realtime")
+  {
+    SDL::EventPlayer player{stream, SDL::PLAYBACK_REALTIME};
+    SDL::DelayNS(player.GetDuration() + 1);
+    CHECK(player.Update() == 3);
+    CHECK(player.IsDone());
+  }
+  SUBCASE("invalid")
+  {
+    SDL::IOStream garbage = SDL::IOStream::FromDynamicMem();
+    garbage.Write(std::string_view{"not a recording"});
+    garbage.Seek(0, SDL::IO_SEEK_SET);
+    CHECK_THROWS_AS(SDL::EventPlayer{garbage}, SDL::Error);
+  }
+  SDL::FlushEvents();
+  SDL::Quit();
+}
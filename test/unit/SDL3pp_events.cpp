@@ -1,2 +1,42 @@
 #include "SDL3pp/SDL3pp_events.h"
+#include "SDL3pp/SDL3pp_init.h"
 #include "doctest.h"
+
+TEST_CASE("Batched event polling")
+{
+  SDL::Init(SDL::INIT_EVENTS);
+  SDL::FlushEvents(SDL::EVENT_FIRST, SDL::EVENT_LAST);
+
+  constexpr int total = 10000;
+  for (int i = 0; i < total; i++) {
+    SDL::Event event{.user = {.type = SDL::EVENT_USER, .code = i}};
+    SDL::PushEvent(event);
+  }
+
+  SUBCASE("EventBatch")
+  {
+    SDL::EventBatch batch{256};
+    int count = 0;
+    while (batch.Poll(SDL::EVENT_USER, SDL::EVENT_USER)) {
+      CHECK(batch.size() <= batch.capacity());
+      for (auto& event : batch) {
+        if (event.user.code != count) FAIL("Out of order event");
+        count++;
+      }
+    }
+    CHECK(count == total);
+    CHECK(batch.empty());
+  }
+  SUBCASE("PollEvents")
+  {
+    SDL::Event buffer[64];
+    auto events = SDL::PollEvents(buffer, SDL::EVENT_USER, SDL::EVENT_USER);
+    CHECK(events.size() == 64);
+    CHECK(events.data() == buffer);
+    CHECK(events[63].user.code == 63);
+    SDL::FlushEvent(SDL::EVENT_USER);
+    CHECK(SDL::PollEvents(buffer, SDL::EVENT_USER, SDL::EVENT_USER).empty());
+  }
+
+  SDL::Quit();
+}
@@ -0,0 +1,102 @@
+#include "SDL3pp/SDL3pp_frameAllocator.h"
+#include "doctest.h"
+
+namespace SDL {
+
+TEST_CASE("FrameAllocator")
+{
+  FrameAllocator allocator{4096};
+  CHECK_THROWS_AS(FrameAllocator{}, Error);
+
+  SUBCASE("pools outside frames")
+  {
+    void* a = SDL::malloc(24);
+    SDL::free(a);
+    void* b = SDL::malloc(30);
+    CHECK(a == b);
+    SDL::free(b);
+    auto stats = allocator.GetStats();
+    CHECK(stats.poolAllocations == 2);
+    CHECK(stats.arenaAllocations == 0);
+  }
+
+  SUBCASE("large blocks use fallback")
+  {
+    void* a = SDL::calloc(1, FrameAllocator::MAX_POOLED_SIZE + 1);
+    REQUIRE(a != nullptr);
+    CHECK(static_cast<char*>(a)[FrameAllocator::MAX_POOLED_SIZE] == 0);
+    SDL::free(a);
+    CHECK(allocator.GetStats().fallbackAllocations == 1);
+  }
+
+  SUBCASE("arena is rewound on each frame")
+  {
+    void* first;
+    {
+      FrameScope frame{allocator};
+      first = SDL::malloc(100);
+      void* second = SDL::malloc(100);
+      CHECK(reinterpret_cast<uintptr_t>(first) % 16 == 0);
+      CHECK(static_cast<char*>(second) > static_cast<char*>(first));
+      SDL::free(first);
+      SDL::free(second);
+    }
+    {
+      FrameScope frame{allocator};
+      CHECK(allocator.GetStats().arenaUsed == 0);
+      void* again = SDL::malloc(100);
+      CHECK(again == first);
+      CHECK(allocator.GetStats().arenaUsed >= 100);
+      SDL::free(again);
+    }
+    auto stats = allocator.GetStats();
+    CHECK(stats.arenaAllocations == 3);
+    CHECK(stats.frames == 2);
+    CHECK(stats.retiredChunks == 0);
+  }
+
+  SUBCASE("live blocks retire the chunk")
+  {
+    char* kept;
+    {
+      FrameScope frame{allocator};
+      kept = static_cast<char*>(SDL::malloc(16));
+      SDL_memcpy(kept, "still alive", 12);
+    }
+    {
+      FrameScope frame{allocator};
+      void* other = SDL::malloc(16);
+      CHECK(other != kept);
+      SDL::free(other);
+    }
+    CHECK(std::string_view{kept} == "still alive");
+    CHECK(allocator.GetStats().retiredChunks == 1);
+    SDL::free(kept);
+  }
+
+  SUBCASE("arena overflow")
+  {
+    FrameScope frame{allocator};
+    void* a = SDL::malloc(4000);
+    void* b = SDL::malloc(4000);
+    auto stats = allocator.GetStats();
+    CHECK(stats.arenaAllocations == 1);
+    CHECK(stats.arenaOverflows == 1);
+    CHECK(stats.fallbackAllocations == 1);
+    SDL::free(a);
+    SDL::free(b);
+  }
+
+  SUBCASE("realloc keeps content")
+  {
+    auto a = static_cast<char*>(SDL::malloc(8));
+    SDL_memcpy(a, "abcdefg", 8);
+    auto b = static_cast<char*>(SDL::realloc(a, 16));
+    CHECK(a == b);
+    b = static_cast<char*>(SDL::realloc(b, 1000));
+    CHECK(std::string_view{b} == "abcdefg");
+    SDL::free(b);
+  }
+}
+
+} // namespace SDL
@@ -0,0 +1,70 @@
+#include "SDL3pp/SDL3pp_memoryTracker.h"
+#include "doctest.h"
+#include <atomic>
+#include <thread>
+
+namespace SDL {
+
+TEST_CASE("MemoryTracker")
+{
+  void* before = SDL::malloc(10);
+  {
+    MemoryTracker tracker{128};
+    REQUIRE(MemoryTracker::IsInstalled());
+    CHECK_THROWS_AS(MemoryTracker{}, Error);
+
+    MemoryProbe probe;
+    void* a = SDL::malloc(100);
+    void* b = SDL::calloc(4, 25);
+    a = SDL::realloc(a, 300);
+
+    auto stats = probe.GetStats();
+    CHECK(stats.allocations == 3);
+    CHECK(stats.deallocations == 1);
+    CHECK(stats.calls[MEMORY_CALL_MALLOC] == 1);
+    CHECK(stats.calls[MEMORY_CALL_CALLOC] == 1);
+    CHECK(stats.calls[MEMORY_CALL_REALLOC] == 1);
+    CHECK(stats.liveBytes == 400);
+    CHECK(stats.peakBytes == 400);
+    CHECK(stats.histogram[7] == 2);
+    CHECK(stats.histogram[9] == 1);
+
+    SDL::free(a);
+    SDL::free(b);
+    stats = probe.GetStats();
+    CHECK(stats.liveBytes == 0);
+    CHECK(stats.GetLiveAllocations() == 0);
+    CHECK(stats.untracked == 0);
+
+    SUBCASE("block from before install")
+    {
+      SDL::free(before);
+      before = nullptr;
+      CHECK(probe.GetStats().untracked == 1);
+    }
+    SUBCASE("probe reset")
+    {
+      probe.Reset();
+      CHECK(probe.GetAllocations() == 0);
+      OwnPtr<char> ptr{static_cast<char*>(SDL::malloc(16))};
+      CHECK(probe.GetAllocations() == 1);
+      CHECK(probe.GetLiveBytes() == 16);
+    }
+  }
+  CHECK_FALSE(MemoryTracker::IsInstalled());
+  SDL::free(before);
+}
+
+TEST_CASE("MemoryTracker teardown while allocating")
+{
+  std::atomic<bool> done{false};
+  std::thread worker([&] {
+    while (!done) SDL::free(SDL::realloc(SDL::malloc(32), 64));
+  });
+  for (int i = 0; i < 100; i++) MemoryTracker tracker{128};
+  done = true;
+  worker.join();
+  CHECK_FALSE(MemoryTracker::IsInstalled());
+}
+
+} // namespace SDL
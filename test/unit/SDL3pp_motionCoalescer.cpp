@@ -0,0 +1,63 @@
+#include "SDL3pp/SDL3pp_init.h"
+#include "SDL3pp/SDL3pp_motionCoalescer.h"
+#include "doctest.h"
+#include <vector>
+
+static void PushMotion(SDL::MouseID which, float x, float xrel)
+{
+  SDL::Event event{};
+  event.motion.type = SDL::EVENT_MOUSE_MOTION;
+  event.motion.which = which;
+  event.motion.x = x;
+  event.motion.xrel = xrel;
+  SDL::PushEvent(event);
+}
+
+static std::vector<SDL::Event> PollAll(SDL::MotionCoalescer& coalescer)
+{
+  std::vector<SDL::Event> events;
+  SDL::Event event;
+  while (SDL::PeepEvents(&event, 1, SDL::GETEVENT) == 1) {
+    coalescer.Resolve(event);
+    events.push_back(event);
+  }
+  return events;
+}
+
+TEST_CASE("MotionCoalescer")
+{
+  SDL::Init(SDL::INIT_EVENTS);
+  SDL::FlushEvents();
+  {
+    SDL::MotionCoalescer coalescer;
+
+    PushMotion(1, 10, 1);
+    PushMotion(1, 12, 2);
+    PushMotion(2, 50, 5);
+    PushMotion(1, 15, 3);
+
+    SDL::Event button{};
+    button.button.type = SDL::EVENT_MOUSE_BUTTON_DOWN;
+    button.button.which = 1;
+    SDL::PushEvent(button);
+
+    PushMotion(1, 20, 5);
+
+    auto events = PollAll(coalescer);
+    REQUIRE(events.size() == 4);
+    CHECK(events[0].motion.which == 1);
+    CHECK(events[0].motion.x == 15);
+    CHECK(events[0].motion.xrel == 6);
+    CHECK(events[1].motion.which == 2);
+    CHECK(events[1].motion.xrel == 5);
+    CHECK(events[2].type == SDL::EVENT_MOUSE_BUTTON_DOWN);
+    CHECK(events[3].motion.x == 20);
+    CHECK(events[3].motion.xrel == 5);
+    CHECK(events[3].common.reserved == 0);
+
+    auto stats = coalescer.GetStats();
+    CHECK(stats.mouseMotions == 3);
+    CHECK(stats.mouseFolded == 2);
+  }
+  SDL::Quit();
+}
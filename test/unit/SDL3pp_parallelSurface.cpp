@@ -0,0 +1,130 @@
+#include "SDL3pp/SDL3pp_parallelSurface.h"
+#include "doctest.h"
+#include <algorithm>
+#include <string_view>
+#include "testRandom.h"
+
+namespace {
+
+using test::RandomSurface;
+
+bool SamePixels(const SDL::Surface& a, const SDL::Surface& b)
+{
+  if (a.GetSize() != b.GetSize() || a.GetFormat() != b.GetFormat()) {
+    return false;
+  }
+  auto pa = static_cast<const Uint8*>(a.GetPixels());
+  auto pb = static_cast<const Uint8*>(b.GetPixels());
+  int rowBytes = a.GetWidth() * a.GetFormat().GetBytesPerPixel();
+  for (int y = 0; y < a.GetHeight(); y++) {
+    if (!std::equal(pa + y * a.GetPitch(),
+                    pa + y * a.GetPitch() + rowBytes,
+                    pb + y * b.GetPitch())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+TEST_CASE("SurfaceThreadPool")
+{
+  SDL::SurfaceThreadPool pool(4, 8);
+  CHECK(pool.GetThreadCount() == 4);
+
+  SDL::Surface src = RandomSurface({97, 83});
+  SDL::Surface serial = RandomSurface({160, 200});
+  SDL::Surface parallel = serial.Duplicate();
+  SDL::Rect clip{5, 7, 150, 180};
+  serial.SetClipRect(clip);
+  parallel.SetClipRect(clip);
+
+  SUBCASE("ForEachBand")
+  {
+    std::vector<std::atomic<int>> rows(100);
+    pool.ForEachBand(
+      10, 90, [&](int y0, int y1) {
+        CHECK((y0 - 10) % 3 == 0);
+        for (int y = y0; y < y1; y++) rows[y]++;
+      },
+      3);
+    for (int y = 0; y < 100; y++) CHECK(rows[y] == (y >= 10 && y < 90));
+
+    CHECK_THROWS_AS(pool.ForEachBand(0,
+                                     100,
+                                     [](int y0, int) {
+                                       if (y0 > 0) throw SDL::Error("band");
+                                     }),
+                    SDL::Error);
+  }
+
+  SUBCASE("Blit")
+  {
+    SDL::Rect srcrect{3, 4, 90, 75};
+    SDL::Rect dstrect{-6, 20, 0, 0};
+    serial.Blit(src, srcrect, dstrect);
+    pool.Blit(parallel, src, srcrect, dstrect);
+    CHECK(SamePixels(serial, parallel));
+
+    src.SetBlendMode(SDL::BLENDMODE_NONE);
+    serial.Blit(src, nullptr, SDL::Rect{40, 100, 0, 0});
+    pool.Blit(parallel, src, nullptr, SDL::Rect{40, 100, 0, 0});
+    CHECK(SamePixels(serial, parallel));
+  }
+
+  SUBCASE("BlitScaled")
+  {
+    SDL::Rect dstrect{3, 1, 194, 166};
+    serial.BlitScaled(src, nullptr, dstrect, SDL::SCALEMODE_NEAREST);
+    pool.BlitScaled(parallel, src, nullptr, dstrect, SDL::SCALEMODE_NEAREST);
+    CHECK(SamePixels(serial, parallel));
+
+    serial.BlitScaled(src, nullptr, nullptr, SDL::SCALEMODE_LINEAR);
+    pool.BlitScaled(parallel, src, nullptr, nullptr, SDL::SCALEMODE_LINEAR);
+    CHECK(SamePixels(serial, parallel));
+  }
+
+  SUBCASE("Scale")
+  {
+    src.SetAlphaMod(128);
+    SDL::Surface expected = src.Scale({194, 166}, SDL::SCALEMODE_NEAREST);
+    SDL::Surface actual = pool.Scale(src, {194, 166}, SDL::SCALEMODE_NEAREST);
+    CHECK(SamePixels(expected, actual));
+    CHECK(actual.GetAlphaMod() == 128);
+    CHECK(actual.GetBlendMode() == expected.GetBlendMode());
+  }
+
+  SUBCASE("Convert")
+  {
+    serial.SetBlendMode(SDL::BLENDMODE_ADD);
+    serial.GetProperties().SetNumberProperty("SDL3pp.test", 42);
+    for (auto format : {SDL::PIXELFORMAT_ARGB8888,
+                        SDL::PIXELFORMAT_XRGB8888,
+                        SDL::PIXELFORMAT_RGB565}) {
+      CAPTURE(std::string_view(format.GetName()));
+      SDL::Surface expected(SDL_ConvertSurface(serial.get(), format));
+      SDL::Surface actual = pool.Convert(serial, format);
+      CHECK(SamePixels(expected, actual));
+      CHECK(actual.GetBlendMode() == expected.GetBlendMode());
+      CHECK(actual.GetClipRect() == expected.GetClipRect());
+      CHECK(actual.GetProperties().GetNumberProperty("SDL3pp.test", 0) == 42);
+    }
+  }
+
+  SUBCASE("PremultiplyAlpha")
+  {
+    serial.PremultiplyAlpha(false);
+    pool.PremultiplyAlpha(parallel, false);
+    CHECK(SamePixels(serial, parallel));
+  }
+
+  SUBCASE("FillRects")
+  {
+    SDL::Rect rects[] = {{0, 0, 40, 190}, {50, 30, 100, 5}, {20, 150, 300, 90}};
+    Uint32 color = serial.MapRGBA({10, 20, 30, 40});
+    serial.FillRects(rects, color);
+    pool.FillRects(parallel, rects, color);
+    CHECK(SamePixels(serial, parallel));
+  }
+}
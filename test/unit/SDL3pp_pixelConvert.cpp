@@ -0,0 +1,174 @@
+#include "SDL3pp/SDL3pp_pixelConvert.h"
+#include "doctest.h"
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <vector>
+#include "SDL3pp/SDL3pp_surface.h"
+#include "testRandom.h"
+
+namespace {
+
+const SDL::PixelFormat FORMATS[] = {
+  SDL::PIXELFORMAT_RGBA8888,
+  SDL::PIXELFORMAT_ARGB8888,
+  SDL::PIXELFORMAT_ABGR8888,
+  SDL::PIXELFORMAT_BGRA8888,
+  SDL::PIXELFORMAT_RGBX8888,
+  SDL::PIXELFORMAT_XRGB8888,
+  SDL::PIXELFORMAT_XBGR8888,
+  SDL::PIXELFORMAT_BGRX8888,
+  SDL::PIXELFORMAT_RGB24,
+  SDL::PIXELFORMAT_BGR24,
+  SDL::PIXELFORMAT_RGB565,
+};
+
+const SDL::PixelConvertPath PATHS[] = {
+  SDL::PIXEL_CONVERT_SCALAR,
+  SDL::PIXEL_CONVERT_SSE2,
+  SDL::PIXEL_CONVERT_AVX2,
+  SDL::PIXEL_CONVERT_NEON,
+};
+
+const std::string_view PATH_NAMES[] = {"scalar", "SSE2", "AVX2", "NEON"};
+
+using test::RandomBytes;
+
+} // namespace
+
+TEST_CASE("ConvertPixelsFast")
+{
+  CHECK(SDL::HasPixelConvertPath(SDL::GetPixelConvertPath()));
+  CHECK(SDL::CanConvertPixelsFast(SDL::PIXELFORMAT_XRGB8888,
+                                  SDL::PIXELFORMAT_ARGB8888));
+  CHECK(SDL::CanConvertPixelsFast(SDL::PIXELFORMAT_RGB24,
+                                  SDL::PIXELFORMAT_RGBA32));
+  CHECK_FALSE(SDL::CanConvertPixelsFast(SDL::PIXELFORMAT_ARGB8888,
+                                        SDL::PIXELFORMAT_XRGB8888));
+  CHECK_FALSE(SDL::CanConvertPixelsFast(SDL::PIXELFORMAT_RGB565,
+                                        SDL::PIXELFORMAT_ARGB8888));
+
+  SUBCASE("Same as SDL")
+  {
+    // Odd widths and padded pitches exercise the scalar tails
+    constexpr int W = 37, H = 5;
+    std::vector<Uint8> src = RandomBytes(H * (W * 4 + 8));
+    for (auto src_format : FORMATS) {
+      int src_pitch = W * src_format.GetBytesPerPixel() + 8;
+      for (auto dst_format : FORMATS) {
+        int dst_pitch = W * 4 + 4;
+        if (!SDL::CanConvertPixelsFast(src_format, dst_format)) continue;
+        std::vector<Uint8> expected(H * dst_pitch);
+        CHECK(SDL_ConvertPixels(W,
+                                H,
+                                src_format,
+                                src.data(),
+                                src_pitch,
+                                dst_format,
+                                expected.data(),
+                                dst_pitch));
+        for (auto path : PATHS) {
+          if (!SDL::HasPixelConvertPath(path)) continue;
+          CAPTURE(std::string_view(src_format.GetName()));
+          CAPTURE(std::string_view(dst_format.GetName()));
+          CAPTURE(PATH_NAMES[path]);
+          std::vector<Uint8> actual(H * dst_pitch);
+          CHECK(SDL::ConvertPixelsFast({W, H},
+                                       src_format,
+                                       src.data(),
+                                       src_pitch,
+                                       dst_format,
+                                       actual.data(),
+                                       dst_pitch,
+                                       path));
+          for (int y = 0; y < H; y++) {
+            CHECK(std::equal(&actual[y * dst_pitch],
+                             &actual[y * dst_pitch + W * 4],
+                             &expected[y * dst_pitch]));
+          }
+        }
+      }
+    }
+  }
+
+  SUBCASE("Surface.Convert")
+  {
+    SDL::Surface surface({33, 9}, SDL::PIXELFORMAT_XRGB8888);
+    std::vector<Uint8> bytes = RandomBytes(surface.GetPitch() * 9);
+    std::copy(
+      bytes.begin(), bytes.end(), static_cast<Uint8*>(surface.GetPixels()));
+    surface.SetColorMod(10, 20, 30);
+    surface.SetClipRect(SDL::Rect{2, 3, 20, 4});
+    surface.GetProperties().SetNumberProperty("SDL3pp.test", 42);
+
+    // The alpha mod and an alpha channel both change the blend mode
+    for (Uint8 alpha : {Uint8(255), Uint8(40)}) {
+      for (auto blendMode : {SDL::BLENDMODE_NONE, SDL::BLENDMODE_ADD}) {
+        for (auto format :
+             {SDL::PIXELFORMAT_ABGR8888, SDL::PIXELFORMAT_XBGR8888}) {
+          CAPTURE(int(alpha));
+          CAPTURE(blendMode);
+          CAPTURE(std::string_view(format.GetName()));
+          surface.SetAlphaMod(alpha);
+          surface.SetBlendMode(blendMode);
+
+          SDL::Surface fast = surface.Convert(format);
+          SDL::Surface slow(SDL_ConvertSurface(surface.get(), format));
+          REQUIRE(fast.GetPitch() == slow.GetPitch());
+          auto fastPixels = static_cast<const Uint8*>(fast.GetPixels());
+          auto slowPixels = static_cast<const Uint8*>(slow.GetPixels());
+          CHECK(std::equal(
+            fastPixels, fastPixels + fast.GetPitch() * 9, slowPixels));
+          CHECK(fast.GetBlendMode() == slow.GetBlendMode());
+          CHECK(fast.GetMod() == slow.GetMod());
+          CHECK(fast.GetClipRect() == slow.GetClipRect());
+          CHECK(fast.GetProperties().GetNumberProperty("SDL3pp.test", 0) ==
+                slow.GetProperties().GetNumberProperty("SDL3pp.test", 0));
+          CHECK(fast.GetProperties().GetNumberProperty("SDL3pp.test", 0) ==
+                42);
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("MapColors and GetColors")
+{
+  // Odd count exercises the scalar tails
+  constexpr int N = 37;
+  std::vector<Uint8> bytes = RandomBytes(N * 4);
+  std::vector<SDL::Color> colors(N);
+  std::vector<Uint32> values(N);
+  std::memcpy(colors.data(), bytes.data(), N * 4);
+  std::memcpy(values.data(), bytes.data(), N * 4);
+
+  for (auto format : FORMATS) {
+    const SDL::PixelFormatDetails& details = format.GetDetails();
+    Uint32 mask = format.GetBytesPerPixel() == 4
+                    ? 0xFFFFFFFF
+                    : (1u << format.GetBitsPerPixel()) - 1;
+    for (auto path : PATHS) {
+      if (!SDL::HasPixelConvertPath(path)) continue;
+      CAPTURE(std::string_view(format.GetName()));
+      CAPTURE(PATH_NAMES[path]);
+
+      std::vector<Uint32> pixels(N + 1, 0xCDCDCDCD);
+      SDL::MapColors(
+        details, colors, std::span(pixels.data(), N), {}, path);
+      for (int i = 0; i < N; i++) {
+        CHECK(pixels[i] == SDL::MapColor(details, colors[i]));
+      }
+      CHECK(pixels[N] == 0xCDCDCDCD);
+
+      std::vector<SDL::Color> got(N + 1, SDL::Color(1, 2, 3, 4));
+      std::vector<Uint32> masked(N);
+      for (int i = 0; i < N; i++) masked[i] = values[i] & mask;
+      SDL::GetColors(
+        details, masked, SDL::SpanRef<SDL::ColorRaw>(got.begin(), N), {}, path);
+      for (int i = 0; i < N; i++) {
+        CHECK(got[i] == SDL::GetColor(masked[i], details));
+      }
+      CHECK(got[N] == SDL::Color(1, 2, 3, 4));
+    }
+  }
+}
@@ -0,0 +1,206 @@
+#include "SDL3pp/SDL3pp_pixelView.h"
+#include "doctest.h"
+#include <algorithm>
+#include <execution>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <string_view>
+#include <type_traits>
+#include "testRandom.h"
+
+namespace {
+
+using test::RandomSurface;
+
+template<PixelFormatRaw FORMAT>
+void CheckSameAsSurface()
+{
+  using View = SDL::PixelView<FORMAT>;
+  constexpr int BYTES = SDL::PixelTraits<FORMAT>::BYTES;
+  CAPTURE(std::string_view(SDL::PixelFormat(FORMAT).GetName()));
+  constexpr SDL::Point SIZE{13, 7};
+  SDL::Surface surface = RandomSurface(SIZE, FORMAT);
+  SDL::Surface expected = surface.Duplicate();
+  auto lock = surface.Lock();
+  View view(lock);
+  CHECK(view.GetSize() == SIZE);
+  CHECK(view.GetPitch() == surface.GetPitch());
+
+  // Reading
+  auto bytes = static_cast<const Uint8*>(surface.GetPixels());
+  for (int y = 0; y < SIZE.y; y++) {
+    for (int x = 0; x < SIZE.x; x++) {
+      CAPTURE(x);
+      CAPTURE(y);
+      Uint32 raw = 0;
+      for (int i = 0; i < BYTES; i++) {
+        raw |= Uint32(bytes[y * surface.GetPitch() + x * BYTES + i]) << (i * 8);
+      }
+      if (BYTES == 3 || SDL_BYTEORDER == SDL_LIL_ENDIAN) {
+        CHECK(view.ReadPixelRaw({x, y}) == raw);
+      }
+      CHECK(view.ReadPixel({x, y}) == expected.ReadPixel({x, y}));
+    }
+  }
+
+  // Writing
+  Uint8 v = 0;
+  for (auto row : view) {
+    for (auto pixel : row) {
+      SDL::Color c(v, Uint8(v * 3), Uint8(v * 7), Uint8(v * 11));
+      pixel = c;
+      v++;
+    }
+  }
+  v = 0;
+  for (int y = 0; y < SIZE.y; y++) {
+    for (int x = 0; x < SIZE.x; x++) {
+      SDL::Color c(v, Uint8(v * 3), Uint8(v * 7), Uint8(v * 11));
+      expected.WritePixel({x, y}, c);
+      CHECK(view.ReadPixelRaw({x, y}) == expected.MapRGBA(c));
+      CHECK(SDL::PixelTraits<FORMAT>::Pack(c) == expected.MapRGBA(c));
+      CHECK(view.ReadPixel({x, y}) == expected.ReadPixel({x, y}));
+      v++;
+    }
+  }
+}
+
+} // namespace
+
+TEST_CASE("PixelView")
+{
+  SUBCASE("Same as Surface")
+  {
+    CheckSameAsSurface<SDL_PIXELFORMAT_RGB332>();
+    CheckSameAsSurface<SDL_PIXELFORMAT_XRGB4444>();
+    CheckSameAsSurface<SDL_PIXELFORMAT_ARGB4444>();
+    CheckSameAsSurface<SDL_PIXELFORMAT_BGRA4444>();
+    CheckSameAsSurface<SDL_PIXELFORMAT_XRGB1555>();
+    CheckSameAsSurface<SDL_PIXELFORMAT_ARGB1555>();
+    CheckSameAsSurface<SDL_PIXELFORMAT_RGBA5551>();
+    CheckSameAsSurface<SDL_PIXELFORMAT_RGB565>();
+    CheckSameAsSurface<SDL_PIXELFORMAT_BGR565>();
+    CheckSameAsSurface<SDL_PIXELFORMAT_RGB24>();
+    CheckSameAsSurface<SDL_PIXELFORMAT_BGR24>();
+    CheckSameAsSurface<SDL_PIXELFORMAT_XRGB8888>();
+    CheckSameAsSurface<SDL_PIXELFORMAT_RGBX8888>();
+    CheckSameAsSurface<SDL_PIXELFORMAT_ARGB8888>();
+    CheckSameAsSurface<SDL_PIXELFORMAT_RGBA8888>();
+    CheckSameAsSurface<SDL_PIXELFORMAT_ABGR8888>();
+    CheckSameAsSurface<SDL_PIXELFORMAT_BGRA8888>();
+  }
+
+  SUBCASE("Ranges")
+  {
+    using View = SDL::PixelView<SDL::PIXELFORMAT_RGBA32>;
+    static_assert(std::random_access_iterator<View::Iterator>);
+    static_assert(std::random_access_iterator<View::Row::Iterator>);
+
+    // Parallel algorithms need the legacy category to split the range
+    static_assert(
+      std::is_same_v<std::iterator_traits<View::Iterator>::iterator_category,
+                     std::random_access_iterator_tag>);
+    static_assert(std::is_same_v<
+                  std::iterator_traits<View::Row::Iterator>::iterator_category,
+                  std::random_access_iterator_tag>);
+
+    SDL::Surface surface({10, 6}, SDL::PIXELFORMAT_RGBA32);
+    auto lock = surface.Lock();
+    View view(lock);
+    CHECK(view.end() - view.begin() == 6);
+    CHECK(view.begin()[2].data() == view.GetRow(2).data());
+    CHECK(view.GetRow(0).end() - view.GetRow(0).begin() == 10);
+
+    View sub = view.GetSubview({2, 1, 5, 3});
+    std::for_each(sub.begin(), sub.end(), [](View::Row row) {
+      std::fill(row.begin(), row.end(), SDL::Color(1, 2, 3, 4));
+    });
+    int count = 0;
+    SDL::ConstPixelView<SDL::PIXELFORMAT_RGBA32> cview = view;
+    for (auto row : cview) {
+      count += int(std::count_if(row.begin(), row.end(), [](SDL::Color c) {
+        return c == SDL::Color(1, 2, 3, 4);
+      }));
+    }
+    CHECK(count == 15);
+    CHECK(cview.ReadPixel({2, 1}) == SDL::Color(1, 2, 3, 4));
+    CHECK(cview.ReadPixel({1, 1}) == SDL::Color(0, 0, 0, 0));
+
+    // Copying between references copies the pixel
+    view[{0, 0}] = view[{2, 1}];
+    CHECK(cview.ReadPixel({0, 0}) == SDL::Color(1, 2, 3, 4));
+  }
+
+  SUBCASE("Parallel algorithms")
+  {
+    using View = SDL::PixelView<SDL::PIXELFORMAT_RGBA32>;
+    SDL::Surface surface({16, 64}, SDL::PIXELFORMAT_RGBA32);
+    auto lock = surface.Lock();
+    View view(lock);
+    std::for_each(std::execution::par, view.begin(), view.end(), [](auto row) {
+      for (auto pixel : row) {
+        SDL::Color c = pixel;
+        pixel = SDL::Color(255 - c.r, 255 - c.g, 255 - c.b, c.a);
+      }
+    });
+    auto inverted = std::transform_reduce(
+      std::execution::par,
+      view.begin(),
+      view.end(),
+      0,
+      std::plus<>{},
+      [](View::Row row) {
+        return int(std::count_if(row.begin(), row.end(), [](SDL::Color c) {
+          return c == SDL::Color(255, 255, 255, 0);
+        }));
+      });
+    CHECK(inverted == 16 * 64);
+  }
+
+  SUBCASE("TextureLock")
+  {
+    SDL::Surface target({8, 4}, SDL::PIXELFORMAT_RGBA32);
+    SDL::Renderer renderer(target);
+    SDL::Texture texture(
+      renderer, SDL::PIXELFORMAT_RGBA32, SDL::TEXTUREACCESS_STREAMING, {8, 4});
+    texture.SetBlendMode(SDL::BLENDMODE_NONE);
+    void* pixels;
+    int pitch;
+    {
+      auto lock = texture.Lock(SDL::Rect{2, 1, 5, 3}, &pixels, &pitch);
+      SDL::PixelView<SDL::PIXELFORMAT_RGBA32> view(lock);
+      CHECK(view.GetSize() == SDL::Point{5, 3});
+      CHECK(view.GetPixels() == pixels);
+      CHECK(view.GetPitch() == pitch);
+      CHECK_THROWS_AS(SDL::PixelView<SDL::PIXELFORMAT_ARGB8888>{lock},
+                      SDL::Error);
+
+      lock.reset();
+      CHECK_FALSE(lock);
+      CHECK(lock.GetPixels() == nullptr);
+      CHECK(lock.GetPitch() == 0);
+      CHECK(lock.GetSize() == SDL::Point{0, 0});
+    }
+
+    auto lock = texture.Lock({}, &pixels, &pitch);
+    SDL::PixelView<SDL::PIXELFORMAT_RGBA32> view(lock);
+    for (auto row : view) {
+      std::fill(row.begin(), row.end(), SDL::Color(10, 20, 30, 255));
+    }
+    view[{3, 2}] = SDL::Color(40, 50, 60, 255);
+    texture.Unlock(std::move(lock));
+    renderer.RenderTexture(texture, {}, {});
+    SDL::Surface result = renderer.ReadPixels();
+    CHECK(result.ReadPixel({0, 0}) == SDL::Color(10, 20, 30, 255));
+    CHECK(result.ReadPixel({3, 2}) == SDL::Color(40, 50, 60, 255));
+  }
+
+  SUBCASE("Format mismatch")
+  {
+    SDL::Surface surface({4, 4}, SDL::PIXELFORMAT_XRGB8888);
+    auto lock = surface.Lock();
+    CHECK_THROWS_AS(SDL::PixelView<SDL::PIXELFORMAT_ARGB8888>{lock},
+                    SDL::Error);
+  }
+}
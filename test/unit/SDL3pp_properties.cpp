@@ -19,3 +19,19 @@ TEST_CASE("Properties")
                            [&](auto, const char* key) { element = key; });
   CHECK(element == "potato");
 }
+
+TEST_CASE("SetPointerPropertyWithCleanup with InplaceFunction")
+{
+  SDL::Properties props = SDL::Properties::Create();
+  int value = 42;
+  void* cleaned = nullptr;
+  SDL::SetPointerPropertyWithCleanup(
+    props,
+    "potato",
+    &value,
+    SDL::InplaceFunction<void(void*)>{[&](void* v) { cleaned = v; }});
+  CHECK(SDL::GetPointerProperty(props, "potato", nullptr) == &value);
+  CHECK(cleaned == nullptr);
+  SDL::ClearProperty(props, "potato");
+  CHECK(cleaned == &value);
+}
@@ -0,0 +1,55 @@
+#include "SDL3pp/SDL3pp_render.h"
+#include "doctest.h"
+
+TEST_CASE("RenderStats")
+{
+  SDL::Surface target({16, 16}, SDL::PIXELFORMAT_RGBA32);
+  SDL::Renderer renderer(target);
+  SDL::Surface image({4, 4}, SDL::PIXELFORMAT_RGBA32);
+  SDL::Texture texture1(renderer, image);
+  SDL::Texture texture2(renderer, image);
+  auto& stats = SDL::GetRenderStats(renderer);
+  CHECK(stats.GetHistorySize() == 0);
+
+  renderer.SetDrawColor(SDL::Color{0, 0, 0, 255});
+  renderer.RenderClear();
+  renderer.SetDrawBlendMode(SDL::BLENDMODE_BLEND);
+  renderer.SetDrawColor(SDL::Color{255, 0, 0, 255});
+  renderer.RenderFillRect(SDL::FRect{0, 0, 4, 4});
+  SDL::FPoint points[] = {{1, 1}, {2, 2}, {3, 3}};
+  renderer.RenderPoints(points);
+  renderer.RenderTexture(texture1, {}, SDL::FRect{4, 4, 4, 4});
+  renderer.RenderTexture(texture1, {}, SDL::FRect{8, 8, 4, 4});
+  renderer.RenderTexture(texture2, {}, SDL::FRect{8, 8, 4, 4});
+  renderer.RenderDebugText({0, 0}, "ab");
+
+  const SDL::RenderFrameStats& current = stats.GetCurrent();
+  CHECK(current.frame == 0);
+  CHECK(current.drawCalls == 6);
+  CHECK(current.vertices == 4 + 3 + 4 * 3 + 4 * 2);
+  CHECK(current.textureBinds == 2);
+  CHECK(current.drawColorChanges == 2);
+  CHECK(current.blendModeChanges == 1);
+  CHECK(current.targetChanges == 0);
+  CHECK(current.clears == 1);
+
+  renderer.Present();
+  CHECK(stats.GetHistorySize() == 1);
+  CHECK(stats.GetHistory().drawCalls == 6);
+  CHECK(stats.GetCurrent().frame == 1);
+  CHECK(stats.GetCurrent().drawCalls == 0);
+
+  // The overlay is not counted
+  stats.RenderOverlay(renderer, 0, 0);
+  CHECK(stats.GetCurrent().drawCalls == 0);
+
+  for (size_t i = 0; i < SDL::RenderStats::HISTORY_SIZE + 10; i++) {
+    renderer.RenderPoint({0, 0});
+    renderer.Present();
+  }
+  CHECK(stats.GetHistorySize() == SDL::RenderStats::HISTORY_SIZE);
+  CHECK(stats.GetHistory().frame == SDL::RenderStats::HISTORY_SIZE + 10);
+  CHECK(stats.GetHistory().drawCalls == 1);
+  CHECK(stats.GetHistory().frameTicks > 0);
+  CHECK_FALSE(SDL::RenderStats::Format(stats.GetHistory()).empty());
+}
@@ -0,0 +1,146 @@
+#include "SDL3pp/SDL3pp_shapeBatch.h"
+#include "doctest.h"
+#include <cmath>
+
+namespace {
+
+double CoveredArea(const SDL::ShapeMesh& mesh)
+{
+  double area = 0;
+  for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+    auto& a = mesh.vertices[mesh.indices[i]];
+    auto& b = mesh.vertices[mesh.indices[i + 1]];
+    auto& c = mesh.vertices[mesh.indices[i + 2]];
+    double cross =
+      (b.position.x - a.position.x) * (c.position.y - a.position.y) -
+      (b.position.y - a.position.y) * (c.position.x - a.position.x);
+    area += std::abs(cross) / 2 * (a.color.a + b.color.a + c.color.a) / 3;
+  }
+  return area;
+}
+
+} // namespace
+
+TEST_CASE("ShapeTessellator")
+{
+  SDL::ShapeTessellator tessellator;
+  SDL::ShapeMesh mesh;
+  tessellator.SetAntiAlias(false);
+
+  SUBCASE("Circle")
+  {
+    tessellator.FillCircle(mesh, 10);
+    CHECK(CoveredArea(mesh) == doctest::Approx(SDL_PI_D * 100).epsilon(0.05));
+    for (int index : mesh.indices) {
+      CHECK(index < int(mesh.vertices.size()));
+    }
+  }
+
+  SUBCASE("Rounded rect")
+  {
+    tessellator.FillRoundedRect(mesh, {40, 20}, 0);
+    CHECK(CoveredArea(mesh) == doctest::Approx(800));
+    mesh.clear();
+    tessellator.FillRoundedRect(mesh, {40, 20}, 5);
+    CHECK(CoveredArea(mesh) ==
+          doctest::Approx(800 - (4 - SDL_PI_D) * 25).epsilon(0.01));
+  }
+
+  SUBCASE("Polyline joins")
+  {
+    SDL::FPoint points[] = {{0, 0}, {20, 0}, {20, 20}};
+    tessellator.SetLineJoin(SDL::LINE_JOIN_MITER);
+    tessellator.StrokePolyline(mesh, points, 4);
+    double miter = CoveredArea(mesh);
+    mesh.clear();
+    tessellator.SetLineJoin(SDL::LINE_JOIN_BEVEL);
+    tessellator.StrokePolyline(mesh, points, 4);
+    double bevel = CoveredArea(mesh);
+    mesh.clear();
+    tessellator.SetLineJoin(SDL::LINE_JOIN_ROUND);
+    tessellator.StrokePolyline(mesh, points, 4);
+    double round = CoveredArea(mesh);
+
+    // Both segments plus the outer corner piece, 2x2 for the miter
+    CHECK(miter == doctest::Approx(164));
+    CHECK(bevel == doctest::Approx(162));
+    CHECK(round > bevel);
+    CHECK(round < miter);
+  }
+
+  SUBCASE("Arc")
+  {
+    tessellator.StrokeArc(mesh, 10, 0, 180, 2);
+    CHECK(CoveredArea(mesh) ==
+          doctest::Approx(SDL_PI_D * (121 - 81) / 2).epsilon(0.05));
+  }
+
+  SUBCASE("Anti-aliasing")
+  {
+    SDL::FPoint points[] = {{0, 0}, {20, 0}};
+    tessellator.StrokePolyline(mesh, points, 4);
+    size_t plain = mesh.vertices.size();
+    mesh.clear();
+    tessellator.SetAntiAlias(true);
+    tessellator.StrokePolyline(mesh, points, 4);
+    CHECK(mesh.vertices.size() > plain);
+    bool fringe = false;
+    for (auto& vertex : mesh.vertices) fringe |= vertex.color.a == 0;
+    CHECK(fringe);
+  }
+}
+
+TEST_CASE("ShapeBatch")
+{
+  SDL::Surface target({64, 64}, SDL::PIXELFORMAT_RGBA32);
+  SDL::Renderer renderer(target);
+  renderer.SetDrawColor(SDL::Color{0, 0, 0, 255});
+  renderer.RenderClear();
+  SDL::ShapeBatch batch(renderer);
+
+  SUBCASE("Draw")
+  {
+    batch.SetColor({1, 0, 0, 1});
+    batch.FillCircle({16, 16}, 10);
+    batch.SetColor({0, 1, 0, 1});
+    batch.FillRoundedRect({36, 4, 24, 24}, 8);
+    batch.SetColor({0, 0, 1, 1});
+    SDL::FPoint points[] = {{4, 48}, {60, 48}};
+    batch.StrokePolyline(points, 6);
+    batch.Flush();
+    CHECK(batch.GetStats().drawCalls == 1);
+    CHECK(renderer.GetDrawBlendMode() == SDL::BLENDMODE_NONE);
+
+    SDL::Surface pixels = renderer.ReadPixels();
+    CHECK(pixels.ReadPixel({16, 16}) == SDL::Color{255, 0, 0, 255});
+    CHECK(pixels.ReadPixel({2, 2}) == SDL::Color{0, 0, 0, 255});
+    CHECK(pixels.ReadPixel({48, 16}) == SDL::Color{0, 255, 0, 255});
+    // Outside the rounded corner
+    CHECK(pixels.ReadPixel({36, 4}) == SDL::Color{0, 0, 0, 255});
+    CHECK(pixels.ReadPixel({32, 48}) == SDL::Color{0, 0, 255, 255});
+    CHECK(pixels.ReadPixel({32, 56}) == SDL::Color{0, 0, 0, 255});
+  }
+
+  SUBCASE("Cache")
+  {
+    batch.SetCacheFrames(0);
+    for (int frame = 0; frame < 3; frame++) {
+      for (int i = 0; i < 10; i++) batch.FillCircle({i * 6.f, 8}, 3);
+      batch.StrokeArc({32, 32}, 8 + frame, 0, 90, 2);
+      batch.Flush();
+    }
+    auto stats = batch.GetStats();
+    CHECK(stats.shapes == 33);
+    CHECK(stats.cacheMisses == 4);
+    CHECK(stats.cacheHits == 29);
+    CHECK(stats.drawCalls == 3);
+    CHECK(stats.evicted == 2);
+    CHECK(batch.GetCacheSize() == 2);
+
+    // Settings are part of the key
+    batch.GetTessellator().SetAntiAlias(false);
+    batch.FillCircle({8, 8}, 3);
+    CHECK(batch.GetStats().cacheMisses == 5);
+    batch.clear();
+  }
+}
@@ -0,0 +1,125 @@
+#include "SDL3pp/SDL3pp_spatialIndex.h"
+#include "doctest.h"
+#include <algorithm>
+#include <vector>
+#include "testRandom.h"
+
+namespace {
+
+using test::Random;
+
+SDL::FRect RandomRect(Random& random, float world, float size)
+{
+  return {random(world), random(world), random(size), random(size)};
+}
+
+struct Linear
+{
+  std::vector<SDL::FRect> rects;
+  std::vector<SDL::SpatialHandle> handles;
+  std::vector<bool> alive;
+
+  std::vector<SDL::SpatialHandle> Query(const SDL::FRect& area) const
+  {
+    std::vector<SDL::SpatialHandle> results;
+    for (size_t i = 0; i < rects.size(); i++) {
+      if (alive[i] && rects[i].HasIntersection(area)) {
+        results.push_back(handles[i]);
+      }
+    }
+    std::sort(results.begin(), results.end());
+    return results;
+  }
+
+  std::vector<SDL::SpatialHandle> QueryPoint(const SDL::FPoint& p) const
+  {
+    std::vector<SDL::SpatialHandle> results;
+    for (size_t i = 0; i < rects.size(); i++) {
+      if (alive[i] && p.InRect(rects[i])) results.push_back(handles[i]);
+    }
+    std::sort(results.begin(), results.end());
+    return results;
+  }
+};
+
+template<class INDEX>
+void CheckAgainstLinear(INDEX& index)
+{
+  Random random;
+  Linear linear;
+  for (int i = 0; i < 500; i++) {
+    linear.rects.push_back(RandomRect(random, 1000, 80));
+    linear.handles.push_back(index.Insert(linear.rects.back()));
+    linear.alive.push_back(true);
+  }
+  for (int i = 0; i < 500; i += 3) {
+    linear.rects[i] = RandomRect(random, 1000, 80);
+    index.Move(linear.handles[i], linear.rects[i]);
+  }
+  for (int i = 0; i < 500; i += 7) {
+    linear.rects[i].x += 2;
+    index.Move(linear.handles[i], linear.rects[i]);
+  }
+  for (int i = 0; i < 500; i += 5) {
+    linear.alive[i] = false;
+    index.Remove(linear.handles[i]);
+  }
+  CHECK(index.size() == 400);
+  CHECK(index.GetRect(linear.handles[1]) == linear.rects[1]);
+
+  std::vector<SDL::SpatialHandle> results;
+  for (int i = 0; i < 100; i++) {
+    SDL::FRect area = RandomRect(random, 1000, 300);
+    results.clear();
+    index.Query(area, results);
+    std::sort(results.begin(), results.end());
+    CHECK(results == linear.Query(area));
+
+    SDL::FPoint p{random(1000), random(1000)};
+    results.clear();
+    index.QueryPoint(p, results);
+    std::sort(results.begin(), results.end());
+    CHECK(results == linear.QueryPoint(p));
+  }
+
+  // Edges are inclusive, as on FRect.HasIntersection()
+  const SDL::FRect& rect = linear.rects[1];
+  results.clear();
+  index.Query(SDL::FRect{rect.x + rect.w, rect.y + rect.h, 0, 0}, results);
+  CHECK(std::find(results.begin(), results.end(), linear.handles[1]) !=
+        results.end());
+
+  // Integer rects are accepted
+  SDL::SpatialHandle handle = index.Insert(SDL::Rect{10, 10, 5, 5});
+  CHECK(index.GetRect(handle) == SDL::FRect{10, 10, 5, 5});
+  CHECK(index.size() == 401);
+
+  index.clear();
+  CHECK(index.size() == 0);
+  results.clear();
+  index.Query(SDL::FRect{0, 0, 1000, 1000}, results);
+  CHECK(results.empty());
+}
+
+} // namespace
+
+TEST_CASE("SpatialGrid")
+{
+  SDL::SpatialGrid grid(64);
+  CHECK(grid.GetCellSize() == 64);
+  CheckAgainstLinear(grid);
+}
+
+TEST_CASE("AABBTree")
+{
+  SDL::AABBTree tree;
+  CHECK(tree.GetHeight() == -1);
+  CheckAgainstLinear(tree);
+
+  SUBCASE("Balance")
+  {
+    // Sorted insertions would degenerate an unbalanced tree into a list
+    for (int i = 0; i < 1024; i++) tree.Insert(SDL::FRect{i * 10.f, 0, 8, 8});
+    CHECK(tree.GetHeight() < 24);
+  }
+}
@@ -0,0 +1,86 @@
+#include "SDL3pp/SDL3pp_spriteBatch.h"
+#include "doctest.h"
+
+static SDL::Texture MakeTexture(SDL::RendererRef renderer, SDL::FColor color)
+{
+  SDL::Surface surface({8, 8}, SDL::PIXELFORMAT_RGBA32);
+  surface.Clear(color);
+  return SDL::Texture(renderer, surface);
+}
+
+TEST_CASE("SpriteBatch")
+{
+  SDL::Surface target({64, 64}, SDL::PIXELFORMAT_RGBA32);
+  SDL::Renderer renderer(target);
+  renderer.SetDrawColor(SDL::Color{0, 0, 0, 255});
+  renderer.RenderClear();
+  SDL::Texture red = MakeTexture(renderer, {1, 0, 0, 1});
+  SDL::Texture blue = MakeTexture(renderer, {0, 0, 1, 1});
+  SDL::SpriteBatch batch(renderer);
+
+  SUBCASE("Draw")
+  {
+    batch.Draw(red, {}, SDL::FRect{8, 8, 16, 16});
+    batch.DrawRotated(
+      blue, {}, SDL::FRect{32, 32, 16, 16}, 90, {}, SDL::FLIP_HORIZONTAL);
+    batch.SetColorMod({0, 1, 0, 1});
+    batch.Draw(nullptr, {}, SDL::FRect{40, 4, 8, 8});
+    CHECK(batch.size() == 3);
+    batch.Flush();
+    CHECK(batch.empty());
+
+    SDL::Surface pixels = renderer.ReadPixels();
+    CHECK(pixels.ReadPixel({16, 16}) == SDL::Color{255, 0, 0, 255});
+    CHECK(pixels.ReadPixel({40, 40}) == SDL::Color{0, 0, 255, 255});
+    CHECK(pixels.ReadPixel({44, 8}) == SDL::Color{0, 255, 0, 255});
+    CHECK(pixels.ReadPixel({2, 2}) == SDL::Color{0, 0, 0, 255});
+  }
+
+  SUBCASE("Grouping")
+  {
+    for (int i = 0; i < 100; i++) {
+      batch.Draw(i % 2 ? red : blue, {}, SDL::FRect{float(i % 56), 0, 8, 8});
+    }
+    batch.Flush();
+    CHECK(batch.GetStats().sprites == 100);
+    CHECK(batch.GetStats().drawCalls == 100);
+
+    batch.ResetStats();
+    batch.SetSortByTexture(true);
+    for (int i = 0; i < 100; i++) {
+      batch.Draw(i % 2 ? red : blue, {}, SDL::FRect{float(i % 56), 0, 8, 8});
+    }
+    batch.Flush();
+    CHECK(batch.GetStats().drawCalls == 2);
+    CHECK(batch.GetStats().flushes == 1);
+  }
+
+  SUBCASE("Sorted runs")
+  {
+    batch.SetSortByTexture(true);
+    for (int i = 0; i < 4; i++) {
+      batch.Draw(i % 2 ? blue : red, {}, SDL::FRect{i * 16.f, 0, 16, 16});
+    }
+    batch.Flush();
+    CHECK(batch.GetStats().drawCalls == 2);
+
+    SDL::Surface pixels = renderer.ReadPixels();
+    for (int i = 0; i < 4; i++) {
+      CAPTURE(i);
+      CHECK(pixels.ReadPixel({i * 16 + 8, 8}) ==
+            (i % 2 ? SDL::Color{0, 0, 255, 255} : SDL::Color{255, 0, 0, 255}));
+    }
+  }
+
+  SUBCASE("BlendMode")
+  {
+    red.SetBlendMode(SDL::BLENDMODE_NONE);
+    batch.SetBlendMode(SDL::BLENDMODE_ADD);
+    batch.Draw(red, {}, SDL::FRect{0, 0, 8, 8});
+    batch.SetBlendMode(SDL::BLENDMODE_INVALID);
+    batch.Draw(red, {}, SDL::FRect{8, 0, 8, 8});
+    batch.Flush();
+    CHECK(batch.GetStats().drawCalls == 2);
+    CHECK(red.GetBlendMode() == SDL::BLENDMODE_NONE);
+  }
+}
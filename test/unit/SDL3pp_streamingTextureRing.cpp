@@ -0,0 +1,76 @@
+#include "SDL3pp/SDL3pp_streamingTextureRing.h"
+#include "doctest.h"
+#include <atomic>
+#include <thread>
+
+TEST_CASE("StreamingTextureRing")
+{
+  SDL::Surface target({16, 16}, SDL::PIXELFORMAT_RGBA32);
+  SDL::Renderer renderer(target);
+
+  SUBCASE("Dropping")
+  {
+    SDL::StreamingTextureRing ring(renderer, SDL::PIXELFORMAT_RGBA32, {16, 16});
+    CHECK_FALSE(ring.Update());
+
+    for (int i = 0; i < 5; i++) {
+      SDL::SurfaceRef frame = ring.AcquireFrame();
+      REQUIRE(frame);
+      CHECK_FALSE(ring.AcquireFrame());
+      frame.Clear({0, i / 4.f, 0, 1});
+      ring.SubmitFrame();
+    }
+    auto stats = ring.GetStats();
+    CHECK(stats.submitted == 5);
+    CHECK(stats.dropped == 2);
+
+    SDL::TextureRef texture = ring.Update();
+    REQUIRE(texture);
+    stats = ring.GetStats();
+    CHECK(stats.uploaded == 1);
+    CHECK(stats.dropped == 4);
+
+    renderer.RenderTexture(texture, {}, {});
+    SDL::Surface pixels = renderer.ReadPixels();
+    CHECK(pixels.ReadPixel({8, 8}) == SDL::Color{0, 255, 0, 255});
+
+    // Nothing new, the same texture is kept
+    CHECK(ring.Update() == texture);
+  }
+
+  SUBCASE("Producer thread")
+  {
+    SDL::StreamingTextureRing ring(renderer, SDL::PIXELFORMAT_RGBA32, {16, 16});
+    std::atomic<bool> done{false};
+    std::thread producer([&] {
+      for (int i = 0; i < 200;) {
+        if (SDL::SurfaceRef frame = ring.AcquireFrame()) {
+          frame.Clear({1, 0, 0, 1});
+          ring.SubmitFrame();
+          i++;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+      done = true;
+    });
+    while (!done) ring.Update();
+    producer.join();
+    ring.Update();
+
+    auto stats = ring.GetStats();
+    CHECK(stats.submitted == 200);
+    CHECK(stats.uploaded + stats.dropped == 200);
+    CHECK(stats.maxLatencyNS >= stats.lastLatencyNS);
+  }
+
+  SUBCASE("YUV")
+  {
+    SDL::StreamingTextureRing ring(renderer, SDL::PIXELFORMAT_IYUV, {16, 16});
+    SDL::SurfaceRef frame = ring.AcquireFrame();
+    REQUIRE(frame);
+    ring.SubmitFrame();
+    CHECK(ring.Update());
+    CHECK(ring.GetStats().uploaded == 1);
+  }
+}
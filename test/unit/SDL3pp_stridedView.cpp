@@ -0,0 +1,92 @@
+#include "SDL3pp/SDL3pp_stridedView.h"
+#include "doctest.h"
+#include <vector>
+
+namespace {
+
+struct Particle
+{
+  SDL::FPoint pos;
+  SDL::FPoint vel;
+  SDL::FColor color;
+  float life;
+};
+
+} // namespace
+
+TEST_CASE("StridedView")
+{
+  std::vector<Particle> particles{
+    {{0, 0}, {}, {1, 0, 0, 1}, 1},
+    {{16, 0}, {}, {1, 0, 0, 1}, 1},
+    {{16, 16}, {}, {1, 0, 0, 1}, 1},
+    {{0, 16}, {}, {1, 0, 0, 1}, 1},
+  };
+
+  SUBCASE("Views")
+  {
+    SDL::StridedView<SDL::FPointRaw> positions{particles, &Particle::pos};
+    CHECK(positions.size() == 4);
+    CHECK(positions.stride() == int(sizeof(Particle)));
+    CHECK(positions[2].x == 16);
+    CHECK(positions[3].y == 16);
+
+    std::vector<SDL::FPoint> points(3);
+    SDL::StridedView<SDL::FPointRaw> contiguous{points};
+    CHECK(contiguous.stride() == int(sizeof(SDL::FPoint)));
+    CHECK(contiguous.data() == &points[0]);
+
+    SDL::FColorRaw white{1, 1, 1, 1};
+    auto repeated = SDL::StridedView<SDL::FColorRaw>::Repeat(white);
+    CHECK(repeated.stride() == 0);
+    CHECK(repeated.Matches(1000));
+    CHECK_FALSE(contiguous.Matches(4));
+
+    std::vector<Uint16> indices{0, 1, 2};
+    SDL::IndexView indexView{indices};
+    CHECK(indexView.size() == 3);
+    CHECK(indexView.indexSize() == 2);
+
+    static_assert(!std::is_constructible_v<SDL::StridedView<SDL::FPointRaw>,
+                                           std::vector<SDL::FColor>&>);
+    static_assert(
+      !std::is_constructible_v<SDL::IndexView, std::vector<float>&>);
+  }
+
+  SUBCASE("Render")
+  {
+    SDL::Surface target({32, 32}, SDL::PIXELFORMAT_RGBA32);
+    SDL::Renderer renderer(target);
+    renderer.SetDrawColor(SDL::Color{0, 0, 0, 255});
+    renderer.RenderClear();
+
+    std::vector<int> indices{0, 1, 2, 2, 3, 0};
+    SDL::RenderGeometryStrided(renderer,
+                               nullptr,
+                               {particles, &Particle::pos},
+                               {particles, &Particle::color},
+                               {},
+                               indices);
+
+    SDL::FColorRaw green{0, 1, 0, 1};
+    for (auto& particle : particles) particle.pos.x += 16;
+    SDL::RenderGeometryStrided(renderer,
+                               nullptr,
+                               {particles, &Particle::pos},
+                               SDL::StridedView<SDL::FColorRaw>::Repeat(green),
+                               {},
+                               indices);
+
+    SDL::Surface pixels = renderer.ReadPixels();
+    CHECK(pixels.ReadPixel({8, 8}) == SDL::Color{255, 0, 0, 255});
+    CHECK(pixels.ReadPixel({24, 8}) == SDL::Color{0, 255, 0, 255});
+    CHECK(pixels.ReadPixel({8, 24}) == SDL::Color{0, 0, 0, 255});
+
+    std::vector<SDL::FColor> colors(3);
+    CHECK_THROWS_AS(SDL::RenderGeometryStrided(renderer,
+                                               nullptr,
+                                               {particles, &Particle::pos},
+                                               colors),
+                    SDL::Error);
+  }
+}
@@ -37,6 +37,37 @@ TEST_CASE("StringParam const string & optimization")
   REQUIRE(StringParam(std::string(test)) != test.c_str());
 }
 
+TEST_CASE("StringParam string_view inline buffer")
+{
+  auto isInline = [](const StringParam& str) {
+    auto ptr = static_cast<const char*>(str);
+    auto base = reinterpret_cast<const char*>(&str);
+    return ptr >= base && ptr < base + sizeof(str);
+  };
+
+  SUBCASE("short views are stored inline")
+  {
+    std::string_view key = "SDL.window.create.title.with.suffix";
+    StringParam str{key.substr(0, 23)};
+    CHECK(isInline(str));
+    CHECK(std::string_view(str) == "SDL.window.create.title");
+  }
+  SUBCASE("inline buffer survives move")
+  {
+    StringParam str{std::string_view("moved")};
+    StringParam other{std::move(str)};
+    CHECK(isInline(other));
+    CHECK(std::string_view(other) == "moved");
+  }
+  SUBCASE("long views fallback to heap")
+  {
+    std::string longStr(SDL3PP_STRING_PARAM_BUFFER_SIZE, 'x');
+    StringParam str{std::string_view(longStr)};
+    CHECK_FALSE(isInline(str));
+    CHECK(std::string_view(str) == longStr);
+  }
+}
+
 #endif // SDL3PP_ENABLE_STRING_PARAM
 
 TEST_CASE("SourceBytes")
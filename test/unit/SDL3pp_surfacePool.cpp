@@ -0,0 +1,107 @@
+#include "SDL3pp/SDL3pp_surfacePool.h"
+#include "doctest.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+
+TEST_CASE("SurfacePool")
+{
+  SDL::SurfacePool pool;
+
+  SUBCASE("Reuse")
+  {
+    void* pixels = nullptr;
+    {
+      SDL::Surface surface = pool.Acquire({64, 32}, SDL::PIXELFORMAT_RGBA32);
+      CHECK(surface.GetSize() == SDL::Point{64, 32});
+      CHECK(surface.GetFormat() == SDL::PIXELFORMAT_RGBA32);
+      pixels = surface.GetPixels();
+      std::memset(pixels, 0x5A, size_t(surface.GetPitch()) * 32);
+      CHECK(pool.GetStats().activeBuffers == 1);
+    }
+    CHECK(pool.GetStats().idleBuffers == 1);
+
+    SDL::Surface surface = pool.Acquire({64, 32}, SDL::PIXELFORMAT_RGBA32);
+    CHECK(surface.GetPixels() == pixels);
+    CHECK(surface.ReadPixel({3, 4}) == SDL::Color(0x5A, 0x5A, 0x5A, 0x5A));
+
+    SDL::SurfacePoolStats stats = pool.GetStats();
+    CHECK(stats.hits == 1);
+    CHECK(stats.misses == 1);
+    CHECK(stats.reclaimed == 1);
+    CHECK(stats.idleBuffers == 0);
+    CHECK(stats.GetHitRate() == 0.5);
+  }
+
+  SUBCASE("Keys")
+  {
+    std::optional<SDL::Surface> surface =
+      pool.Acquire({64, 32}, SDL::PIXELFORMAT_RGBA32);
+    surface.reset();
+    SDL::Surface other = pool.Acquire({32, 64}, SDL::PIXELFORMAT_RGBA32);
+    SDL::Surface format = pool.Acquire({64, 32}, SDL::PIXELFORMAT_RGB565);
+    SDL::Surface pitch = pool.Acquire({64, 32}, SDL::PIXELFORMAT_RGBA32, 512);
+    CHECK(pitch.GetPitch() == 512);
+    CHECK(pool.GetStats().hits == 0);
+    CHECK(pool.GetStats().misses == 4);
+    CHECK(pool.GetStats().idleBuffers == 1);
+  }
+
+  SUBCASE("Alignment")
+  {
+    size_t alignment = std::max(SDL::GetSIMDAlignment(), sizeof(void*));
+    for (auto format : {SDL::PIXELFORMAT_RGBA32,
+                        SDL::PIXELFORMAT_RGB24,
+                        SDL::PIXELFORMAT_RGB565,
+                        SDL::PIXELFORMAT_INDEX8}) {
+      CAPTURE(std::string_view(format.GetName()));
+      SDL::Surface surface = pool.Acquire({37, 5}, format);
+      CHECK(uintptr_t(surface.GetPixels()) % alignment == 0);
+      CHECK(size_t(surface.GetPitch()) % alignment == 0);
+      CHECK(surface.GetPitch() >= 37 * format.GetBytesPerPixel());
+    }
+    CHECK(SDL::SurfacePool::GetMinimumPitch(37, SDL::PIXELFORMAT_INDEX1LSB) ==
+          5);
+  }
+
+  SUBCASE("Invalid")
+  {
+    CHECK_THROWS_AS(pool.Acquire({0, 10}, SDL::PIXELFORMAT_RGBA32), SDL::Error);
+    CHECK_THROWS_AS(pool.Acquire({10, 10}, SDL::PIXELFORMAT_NV12), SDL::Error);
+    CHECK_THROWS_AS(pool.Acquire({10, 10}, SDL::PIXELFORMAT_RGBA32, 8),
+                    SDL::Error);
+    CHECK(pool.GetStats().activeBuffers == 0);
+  }
+
+  SUBCASE("Budget")
+  {
+    pool.SetMaxIdleBytes(64 * 64 * 4);
+    {
+      SDL::Surface a = pool.Acquire({64, 64}, SDL::PIXELFORMAT_RGBA32);
+      SDL::Surface b = pool.Acquire({64, 64}, SDL::PIXELFORMAT_RGBA32);
+    }
+    SDL::SurfacePoolStats stats = pool.GetStats();
+    CHECK(stats.reclaimed == 1);
+    CHECK(stats.discarded == 1);
+    CHECK(stats.idleBytes == 64 * 64 * 4);
+
+    pool.Trim();
+    CHECK(pool.GetStats().idleBuffers == 0);
+    CHECK(pool.GetStats().idleBytes == 0);
+
+    pool.ResetStats();
+    CHECK(pool.GetStats().misses == 0);
+  }
+}
+
+TEST_CASE("SurfacePool outlived")
+{
+  std::optional<SDL::SurfacePool> pool{std::in_place};
+  SDL::Surface surface = pool->Acquire({16, 16}, SDL::PIXELFORMAT_RGBA32);
+  SDL::Surface copy = surface;
+  pool.reset();
+  surface.FillRect(nullptr, surface.MapRGBA({1, 2, 3, 4}));
+  CHECK(copy.ReadPixel({15, 15}) == SDL::Color(1, 2, 3, 4));
+}
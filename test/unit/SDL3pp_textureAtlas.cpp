@@ -0,0 +1,88 @@
+#include "SDL3pp/SDL3pp_textureAtlas.h"
+#include "doctest.h"
+
+static SDL::Surface MakeSurface(int w, int h, SDL::FColor color)
+{
+  SDL::Surface surface({w, h}, SDL::PIXELFORMAT_RGBA32);
+  surface.Clear(color);
+  return surface;
+}
+
+static bool Overlap(const SDL::Rect& a, const SDL::Rect& b)
+{
+  return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h &&
+         b.y < a.y + a.h;
+}
+
+TEST_CASE("SkylinePacker")
+{
+  SDL::SkylinePacker packer({64, 64});
+  CHECK(packer.Insert({32, 16}) == SDL::Point{0, 0});
+  CHECK(packer.Insert({32, 8}) == SDL::Point{32, 0});
+  CHECK(packer.Insert({32, 8}) == SDL::Point{32, 8});
+  CHECK(packer.Insert({64, 48}) == SDL::Point{0, 16});
+  CHECK_FALSE(packer.Insert({1, 1}));
+  CHECK(packer.GetUsedArea() == 64 * 64);
+}
+
+TEST_CASE("MaxRectsPacker")
+{
+  SDL::MaxRectsPacker packer({64, 64});
+  CHECK(packer.Insert({48, 48}) == SDL::Point{0, 0});
+  CHECK(packer.Insert({16, 64}) == SDL::Point{48, 0});
+  CHECK(packer.Insert({48, 16}) == SDL::Point{0, 48});
+  CHECK_FALSE(packer.Insert({1, 1}));
+}
+
+TEST_CASE("TextureAtlas")
+{
+  SDL::Surface target({128, 128}, SDL::PIXELFORMAT_RGBA32);
+  SDL::Renderer renderer(target);
+
+  for (auto method : {SDL::ATLAS_PACK_SKYLINE, SDL::ATLAS_PACK_MAXRECTS}) {
+    CAPTURE(method);
+    SDL::TextureAtlas atlas(renderer, {128, 128}, method);
+    std::vector<SDL::AtlasHandle> handles;
+    for (int i = 0; i < 40; i++) {
+      float shade = (i + 1) / 40.f;
+      auto surface =
+        MakeSurface(8 + i % 5 * 4, 8 + i % 3 * 6, {shade, 0, 0, 1});
+      handles.push_back(atlas.Add(surface));
+    }
+    CHECK(atlas.GetCount() == 40);
+    CHECK(atlas.GetPageCount() >= 1);
+    CHECK(atlas.GetEfficiency() > 0);
+    CHECK(atlas.GetEfficiency() <= 1);
+
+    for (size_t i = 0; i < handles.size(); i++) {
+      auto& a = atlas.Get(handles[i]);
+      CHECK(a.uv.x == doctest::Approx(a.rect.x / 128.f));
+      CHECK(a.uv.w == doctest::Approx(a.rect.w / 128.f));
+      for (size_t j = i + 1; j < handles.size(); j++) {
+        auto& b = atlas.Get(handles[j]);
+        if (a.page == b.page) CHECK_FALSE(Overlap(a.rect, b.rect));
+      }
+    }
+
+    CHECK_FALSE(atlas.GetTexture(0));
+    atlas.Upload();
+    CHECK(atlas.GetTexture(0));
+
+    // Incremental insertion after the first upload
+    auto surface = MakeSurface(4, 4, {0, 1, 0, 1});
+    auto green = atlas.Add(surface);
+    atlas.Upload();
+    auto& region = atlas.Get(green);
+    renderer.SetDrawColor(SDL::Color{0, 0, 0, 255});
+    renderer.RenderClear();
+    renderer.RenderTexture(atlas.GetTexture(region.page),
+                           SDL::FRect(region.rect),
+                           SDL::FRect{0, 0, 4, 4});
+    SDL::Surface pixels = renderer.ReadPixels();
+    CHECK(pixels.ReadPixel({2, 2}) == SDL::Color{0, 255, 0, 255});
+  }
+
+  SDL::TextureAtlas small(renderer, {16, 16});
+  auto large = MakeSurface(32, 4, {});
+  CHECK_THROWS_AS(small.Add(large), SDL::Error);
+}